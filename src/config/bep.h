@@ -1,9 +1,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
 #include <cstdint>
+#include <string>
 
 namespace syncspirit::config {
 
@@ -16,6 +17,7 @@ struct bep_config_t {
     std::uint32_t blocks_simultaneous_write;
     std::uint32_t advances_per_iteration;
     std::int32_t stats_interval;
+    std::string trace_file; // per-block pull lifecycle trace (chrome/perfetto json), empty to disable
 };
 
 } // namespace syncspirit::config
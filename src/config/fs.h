@@ -10,6 +10,14 @@ struct fs_config_t {
     std::uint32_t temporally_timeout;
     std::uint32_t poll_timeout;
     std::uint32_t retension_timeout;
+    std::uint32_t io_threads;
+    std::uint32_t scan_threads;
+    bool prune_dirs;
+    bool strict_pruning;
+    std::uint32_t ro_cache_size;
+    std::uint32_t write_buffer;
+    bool durable;
+    std::int32_t stats_interval;
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
     std::uint32_t win32_watcher_buff = 1024 * 1024;
 #endif
@@ -187,6 +187,7 @@ static main_t make_default_config(const bfs::path &config_path, const bfs::path
         64,                 /* blocks_simultaneous_write */
         20,                 /* advances_per_iteration */
         500,                /* stats_interval */
+        "",                 /* trace_file */
     };
     cfg.dialer_config = dialer_config_t {
         true,       /* enabled */
@@ -194,11 +195,19 @@ static main_t make_default_config(const bfs::path &config_path, const bfs::path
         10          /* skip_discovers */
     };
     cfg.fs_config = fs_config_t {
-        86400000,    /* temporally_timeout, 24h default */
-        1000,        /* poll_timeout, 1s by default */
-        10'000,      /* retension_timeout, 10s by default */
+        86400000,         /* temporally_timeout, 24h default */
+        1000,             /* poll_timeout, 1s by default */
+        10'000,           /* retension_timeout, 10s by default */
+        1,                /* io_threads, block I/O in fs thread */
+        1,                /* scan_threads, directories are scanned in fs thread */
+        true,             /* prune_dirs, do not list unchanged directories */
+        false,            /* strict_pruning, stat files within unchanged directories */
+        64,               /* ro_cache_size, opened for reading files */
+        16 * 1024 * 1024, /* write_buffer, 16MB by default */
+        false,            /* durable, do not sync finished files */
+        10'000,           /* stats_interval, report per-folder I/O stats every 10s */
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
-        1024 * 1024, /* win32 watcher buffer size */
+        1024 * 1024,      /* win32 watcher buffer size */
 #endif
     };
     cfg.db_config = db_config_t {
@@ -329,6 +338,7 @@ config_result_t get_config(std::istream &config, const bfs::path &config_path) {
         SAFE_GET_VALUE(blocks_simultaneous_write, std::uint32_t, "bep");
         SAFE_GET_VALUE(advances_per_iteration, std::uint32_t, "bep");
         SAFE_GET_VALUE(stats_interval, std::int32_t, "bep");
+        SAFE_GET_VALUE_OPTIONAL(trace_file, std::string, "bep");
     }
 
     // dialer
@@ -351,6 +361,14 @@ config_result_t get_config(std::istream &config, const bfs::path &config_path) {
         SAFE_GET_VALUE(temporally_timeout, std::uint32_t, "fs");
         SAFE_GET_VALUE(poll_timeout, std::uint32_t, "fs");
         SAFE_GET_VALUE(retension_timeout, std::uint32_t, "fs");
+        SAFE_GET_VALUE(io_threads, std::uint32_t, "fs");
+        SAFE_GET_VALUE(scan_threads, std::uint32_t, "fs");
+        SAFE_GET_VALUE(prune_dirs, bool, "fs");
+        SAFE_GET_VALUE(strict_pruning, bool, "fs");
+        SAFE_GET_VALUE(ro_cache_size, std::uint32_t, "fs");
+        SAFE_GET_VALUE(write_buffer, std::uint32_t, "fs");
+        SAFE_GET_VALUE(durable, bool, "fs");
+        SAFE_GET_VALUE(stats_interval, std::int32_t, "fs");
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
         SAFE_GET_VALUE(win32_watcher_buff, std::uint32_t, "fs");
 #endif
@@ -473,6 +491,7 @@ outcome::result<void> serialize(const main_t cfg, std::ostream &out) noexcept {
                     {"ping_timeout", cfg.bep_config.ping_timeout},
                     {"rx_buff_size", cfg.bep_config.rx_buff_size},
                     {"stats_interval", cfg.bep_config.stats_interval},
+                    {"trace_file", cfg.bep_config.trace_file},
                     {"tx_buff_limit", cfg.bep_config.tx_buff_limit},
                 }}},
         {"dialer", toml::table{{
@@ -484,6 +503,14 @@ outcome::result<void> serialize(const main_t cfg, std::ostream &out) noexcept {
                    {"temporally_timeout", cfg.fs_config.temporally_timeout},
                    {"poll_timeout", cfg.fs_config.poll_timeout},
                    {"retension_timeout", cfg.fs_config.retension_timeout},
+                   {"io_threads", cfg.fs_config.io_threads},
+                   {"scan_threads", cfg.fs_config.scan_threads},
+                   {"prune_dirs", cfg.fs_config.prune_dirs},
+                   {"strict_pruning", cfg.fs_config.strict_pruning},
+                   {"ro_cache_size", cfg.fs_config.ro_cache_size},
+                   {"write_buffer", cfg.fs_config.write_buffer},
+                   {"durable", cfg.fs_config.durable},
+                   {"stats_interval", cfg.fs_config.stats_interval},
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
                    {"win32_watcher_buff", cfg.fs_config.win32_watcher_buff},
 #endif
@@ -13,6 +13,8 @@ static const constexpr std::uint32_t rescan_interval = 3600;
 static const constexpr std::uint32_t diffs_batch = 256;
 static const constexpr std::int_fast32_t tx_blocks_max_factor = 3;
 static const constexpr std::int64_t tmp_min_age = 10; // 10s
+static const constexpr std::uint32_t max_scanned_ahead = 1024; // directories per folder scan
+static const constexpr std::int64_t racy_ctime_window = 2;      // 2s, recent dir ctimes might miss the changes
 
 SYNCSPIRIT_API extern const char *client_name;
 SYNCSPIRIT_API extern const char *client_version;
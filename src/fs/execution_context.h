@@ -24,6 +24,8 @@ namespace pt = boost::posix_time;
 
 struct fs_slave_t;
 struct fs_proxy_t;
+struct io_stats_t;
+struct scan_pool_t;
 
 struct execution_context_t {
     using clock_t = boost::posix_time::microsec_clock;
@@ -35,6 +37,8 @@ struct execution_context_t {
 
     fs_proxy_t *fs_proxy{};
     hasher::hasher_plugin_t *plugin{};
+    io_stats_t *io_stats{};   // of the slave folder, might be null
+    scan_pool_t *scan_pool{}; // to scan ahead subdirectories, might be null
     scan_dir_callback_t scan_dir_callback;
 };
 } // namespace fs
@@ -1,24 +1,31 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
+#include "syncspirit-config.h"
 #include "file.h"
 #include "utils.h"
 #include "utils/log.h"
 #include "fs_proxy.h"
 #include <errno.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <boost/nowide/convert.hpp>
 
+#if defined(SYNCSPIRIT_FADVISE) || defined(SYNCSPIRIT_SYNC_FILE_RANGE)
+#include <fcntl.h>
+#endif
+
 using namespace syncspirit::fs;
 
 using boost::nowide::narrow;
 
-auto file_t::open_write(fs_proxy_t &fs_proxy, const bfs::path &model_path, std::uint64_t file_size) noexcept
-    -> outcome::result<file_t> {
+auto file_t::open_write(fs_proxy_t &fs_proxy, const bfs::path &model_path, std::uint64_t file_size,
+                        bool preallocate) noexcept -> outcome::result<file_t> {
     auto path = file_size > 0 ? make_temporal(std::move(model_path)) : std::move(model_path);
-    auto result = fs_proxy.open_write(path, file_size);
+    auto result = fs_proxy.open_write(path, file_size, preallocate);
     if (result.has_error()) {
         return result.assume_error();
     }
@@ -28,36 +35,38 @@ auto file_t::open_write(fs_proxy_t &fs_proxy, const bfs::path &model_path, std::
 }
 
 auto file_t::open_read(const bfs::path &path) noexcept -> outcome::result<file_t> {
-    auto file = utils::fstream_t(path, utils::fstream_t::binary | utils::fstream_t::in);
+    auto file = file_handle_t::open(path, file_handle_t::mode_t::read);
     if (!file) {
-        return sys::error_code{errno, sys::system_category()};
+        return file.assume_error();
     }
-    return file_t(std::move(file), path);
+    return file_t(std::move(file.assume_value()), path);
 }
 
 file_t::file_t() noexcept {};
 
-file_t::file_t(utils::fstream_t backend_, bfs::path path_, bfs::path model_path_, std::uint64_t file_size_) noexcept
-    : backend{new utils::fstream_t(std::move(backend_))}, path{std::move(path_)}, file_size{file_size_} {
+file_t::file_t(file_handle_t backend_, bfs::path path_, bfs::path model_path_, std::uint64_t file_size_) noexcept
+    : backend{std::move(backend_)}, path{std::move(path_)}, file_size{file_size_} {
     model_path = std::move(model_path_);
     model_path.make_preferred();
     path.make_preferred();
     path_str = narrow(model_path.generic_wstring());
 }
 
-file_t::file_t(utils::fstream_t backend_, bfs::path path_) noexcept
-    : backend{new utils::fstream_t(std::move(backend_))}, path{std::move(path_)}, file_size{0} {
+file_t::file_t(file_handle_t backend_, bfs::path path_) noexcept
+    : backend{std::move(backend_)}, path{std::move(path_)}, file_size{0} {
     path.make_preferred();
     path_str = boost::nowide::narrow(path.generic_wstring());
 }
 
-file_t::file_t(file_t &&other) noexcept : backend{nullptr} { *this = std::move(other); }
+file_t::file_t(file_t &&other) noexcept { *this = std::move(other); }
 
 file_t &file_t::operator=(file_t &&other) noexcept {
     std::swap(backend, other.backend);
     std::swap(path, other.path);
     std::swap(path_str, other.path_str);
     std::swap(file_size, other.file_size);
+    std::swap(read_ahead, other.read_ahead);
+    std::swap(uncached, other.uncached);
     return *this;
 }
 
@@ -80,7 +89,13 @@ const bfs::path &file_t::get_path() const noexcept { return path; }
 auto file_t::close(fs_proxy_t *fs_proxy, int64_t modification_s, const bfs::path &local_name) noexcept
     -> outcome::result<void> {
     assert(backend && file_size && "close has sense for r/w mode");
-    backend.reset();
+    if (uncached) {
+        write_back(0, 0, true);
+        drop_cache(0, 0);
+    }
+    if (auto ec = backend.close(); ec) {
+        return ec;
+    }
 
     auto rename = !local_name.empty();
     sys::error_code ec;
@@ -113,56 +128,156 @@ auto file_t::close(fs_proxy_t *fs_proxy, int64_t modification_s, const bfs::path
     return outcome::success();
 }
 
-bool file_t::has_backend() const noexcept { return backend.get(); }
+bool file_t::has_backend() const noexcept { return static_cast<bool>(backend); }
+
+native_handle_t file_t::get_native_handle() const noexcept { return backend.native(); }
+
+auto file_t::sync() noexcept -> outcome::result<void> {
+    if (auto ec = backend.sync(); ec) {
+        return ec;
+    }
+    return outcome::success();
+}
+
+void file_t::advise_read(const void *reader, std::uint64_t offset, std::uint32_t size) noexcept {
+    auto range = read_ahead.read(reader, offset, size);
+#ifdef SYNCSPIRIT_FADVISE
+    if (range.size) {
+        ::posix_fadvise(backend.native(), static_cast<off_t>(range.offset), static_cast<off_t>(range.size),
+                        POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)range;
+#endif
+}
+
+void file_t::drop_cache(std::uint64_t offset, std::uint64_t size) noexcept {
+#ifdef SYNCSPIRIT_FADVISE
+    ::posix_fadvise(backend.native(), static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_DONTNEED);
+#else
+    (void)offset;
+    (void)size;
+#endif
+}
+
+void file_t::set_uncached(bool value) noexcept { uncached = value; }
+
+void file_t::on_written(std::uint64_t offset, std::uint64_t size) noexcept {
+    if (uncached) {
+        write_back(offset, size, false);
+    }
+}
+
+void file_t::write_back(std::uint64_t offset, std::uint64_t size, bool wait) noexcept {
+    // dirty pages cannot be evicted, so they are written out without waiting for the kernel
+#ifdef SYNCSPIRIT_SYNC_FILE_RANGE
+    auto flags = static_cast<unsigned int>(SYNC_FILE_RANGE_WRITE);
+    if (wait) {
+        flags |= SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WAIT_AFTER;
+    }
+    ::sync_file_range(backend.native(), static_cast<off_t>(offset), static_cast<off_t>(size), flags);
+#else
+    (void)offset;
+    (void)size;
+    (void)wait;
+#endif
+}
 
 auto file_t::remove(fs_proxy_t &fs_proxy) noexcept -> outcome::result<void> {
-    backend.reset();
+    backend.close();
 
     return fs_proxy.remove(path);
 }
 
 auto file_t::read(std::uint64_t offset, std::uint64_t size) const noexcept -> outcome::result<utils::bytes_t> {
-    if (backend->tellg() != offset) {
-        if (!backend->seekp((long)offset, std::ios_base::beg)) {
-            return sys::errc::make_error_code(sys::errc::io_error);
-        }
-    }
-
     utils::bytes_t r;
     r.resize(size);
-    if (!backend->read(reinterpret_cast<char *>(r.data()), size)) {
-        return sys::errc::make_error_code(sys::errc::io_error);
-    }
-    if (backend->gcount() != size) {
-        return sys::errc::make_error_code(sys::errc::io_error);
+    if (auto ec = backend.read(offset, r); ec) {
+        return ec;
     }
-
     return r;
 }
 
 auto file_t::write(fs_proxy_t &fs_proxy, uint64_t offset, utils::bytes_view_t data) noexcept -> outcome::result<void> {
     assert(offset + data.size() <= file_size);
-    if (auto pos = backend->tellp(); pos != offset) {
-        if (pos == -1) {
-            return sys::errc::make_error_code(sys::errc::io_error);
-        } else if (!backend->seekp((long)offset, std::ios_base::beg)) {
-            return sys::errc::make_error_code(sys::errc::io_error);
-        }
+    if (auto ec = fs_proxy.write(path, backend, offset, data); ec) {
+        return ec;
+    }
+    if (uncached) {
+        write_back(offset, data.size(), false);
     }
+    return outcome::success();
+}
 
-    if (auto ec = fs_proxy.write(path, *backend, data); ec) {
+auto file_t::write(fs_proxy_t &fs_proxy, std::uint64_t offset, std::span<const utils::bytes_view_t> chunks) noexcept
+    -> outcome::result<void> {
+    if (auto ec = fs_proxy.write(path, backend, offset, chunks); ec) {
         return ec;
     }
+    if (uncached) {
+        auto size = std::uint64_t{0};
+        for (auto &chunk : chunks) {
+            size += chunk.size();
+        }
+        write_back(offset, size, false);
+    }
     return outcome::success();
 }
 
 auto file_t::copy(fs_proxy_t &fs_proxy, std::uint64_t my_offset, const file_t &from, std::uint64_t source_offset,
                   std::uint64_t size) noexcept -> outcome::result<void> {
-    auto in_opt = from.read(source_offset, size);
-    if (!in_opt) {
-        return in_opt.assume_error();
+    assert(my_offset + size <= file_size);
+    auto ec = fs_proxy.copy_range(path, my_offset, from.path, source_offset, size);
+    if (!ec) {
+        return outcome::success();
     }
 
-    auto &in = in_opt.assume_value();
-    return write(fs_proxy, my_offset, in);
+    // whole files might be cloned too, so don't read them into memory at once
+    static constexpr std::uint64_t max_chunk = 16 * 1024 * 1024;
+    while (size) {
+        auto chunk = std::min(size, max_chunk);
+        auto in_opt = from.read(source_offset, chunk);
+        if (!in_opt) {
+            return in_opt.assume_error();
+        }
+
+        auto &in = in_opt.assume_value();
+        if (auto r = write(fs_proxy, my_offset, in); !r) {
+            return r;
+        }
+        size -= chunk;
+        source_offset += chunk;
+        my_offset += chunk;
+    }
+    return outcome::success();
+}
+
+auto file_t::zero(fs_proxy_t &fs_proxy, std::uint64_t offset, std::uint64_t size) noexcept -> outcome::result<void> {
+    assert(offset + size <= file_size);
+    auto ec = fs_proxy.punch_hole(path, offset, size);
+    if (!ec) {
+        return outcome::success();
+    }
+
+    // the same zero chunk is gathered many times into a single write
+    static constexpr std::uint64_t max_chunk = 1024 * 1024;
+    static constexpr std::size_t max_chunks = 16;
+    auto zeroes = utils::bytes_t(std::min(size, max_chunk));
+    auto chunks = std::array<utils::bytes_view_t, max_chunks>();
+    while (size) {
+        auto count = std::size_t{0};
+        auto written = std::uint64_t{0};
+        while (count < max_chunks && written < size) {
+            auto chunk = std::min(size - written, max_chunk);
+            chunks[count++] = utils::bytes_view_t(zeroes.data(), chunk);
+            written += chunk;
+        }
+        auto view = std::span<const utils::bytes_view_t>(chunks.data(), count);
+        if (auto ec = fs_proxy.write(path, backend, offset, view); ec) {
+            return ec;
+        }
+        size -= written;
+        offset += written;
+    }
+    return outcome::success();
 }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -7,7 +7,8 @@
 #include <memory>
 #include <boost/outcome.hpp>
 #include "model/misc/arc.hpp"
-#include "utils/io.h"
+#include "file_handle.h"
+#include "read_ahead.h"
 #include "utils/bytes.h"
 #include "syncspirit-export.h"
 
@@ -42,24 +43,44 @@ struct SYNCSPIRIT_API file_t : model::arc_base_t<file_t> {
                                 const bfs::path &local_name = {}) noexcept;
     outcome::result<void> remove(fs_proxy_t &fs_proxy) noexcept;
     outcome::result<void> write(fs_proxy_t &fs_proxy, std::uint64_t offset, utils::bytes_view_t data) noexcept;
+    outcome::result<void> write(fs_proxy_t &fs_proxy, std::uint64_t offset,
+                                std::span<const utils::bytes_view_t> chunks) noexcept;
     outcome::result<void> copy(fs_proxy_t &fs_proxy, std::uint64_t my_offset, const file_t &from,
                                std::uint64_t source_offset, std::uint64_t size) noexcept;
+    outcome::result<void> zero(fs_proxy_t &fs_proxy, std::uint64_t offset, std::uint64_t size) noexcept;
     outcome::result<utils::bytes_t> read(std::uint64_t offset, std::uint64_t size) const noexcept;
+    outcome::result<void> sync() noexcept;
 
-    static outcome::result<file_t> open_write(fs_proxy_t &fs_proxy, const bfs::path &path,
-                                              std::uint64_t file_size) noexcept;
+    native_handle_t get_native_handle() const noexcept;
+
+    /* lets the OS read the following blocks in advance, when the reader goes sequentially */
+    void advise_read(const void *reader, std::uint64_t offset, std::uint32_t size) noexcept;
+
+    /* evicts the range from the OS page cache; size = 0 means up to the end of file */
+    void drop_cache(std::uint64_t offset, std::uint64_t size) noexcept;
+
+    /* written data is pushed to the disk early and evicted from the page cache on close */
+    void set_uncached(bool value) noexcept;
+
+    /* the range has been written by other means than write(), e.g. by the io_engine_t */
+    void on_written(std::uint64_t offset, std::uint64_t size) noexcept;
+
+    static outcome::result<file_t> open_write(fs_proxy_t &fs_proxy, const bfs::path &path, std::uint64_t file_size,
+                                              bool preallocate = false) noexcept;
     static outcome::result<file_t> open_read(const bfs::path &path) noexcept;
 
   private:
-    using backend_ptr_t = std::unique_ptr<utils::fstream_t>;
-    file_t(utils::fstream_t backend, bfs::path path, bfs::path model_path, std::uint64_t file_size) noexcept;
-    file_t(utils::fstream_t backend, bfs::path path) noexcept;
+    file_t(file_handle_t backend, bfs::path path, bfs::path model_path, std::uint64_t file_size) noexcept;
+    file_t(file_handle_t backend, bfs::path path) noexcept;
+    void write_back(std::uint64_t offset, std::uint64_t size, bool wait) noexcept;
 
-    backend_ptr_t backend;
+    file_handle_t backend;
     bfs::path path;
     bfs::path model_path;
     std::string path_str;
     std::uint64_t file_size;
+    read_ahead_t read_ahead;
+    bool uncached = false;
 };
 
 using file_ptr_t = model::intrusive_ptr_t<file_t>;
@@ -5,6 +5,7 @@
 #include "fs/platform/context_base.h"
 #include "fs_proxy.h"
 #include "fs_slave.h"
+#include "io_engine.h"
 #include "net/names.h"
 #include "utils.h"
 #include "utils/io.h"
@@ -13,8 +14,14 @@
 #include "utils/error_code.h"
 #include "proto/proto-helpers-bep.h"
 #include "model/messages.h"
+#include "model/diff/local/io_stats.h"
 #include <boost/nowide/convert.hpp>
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <memory_resource>
+#include <tuple>
+#include <type_traits>
 
 using namespace syncspirit::fs;
 using namespace syncspirit::proto;
@@ -27,20 +34,82 @@ r::plugin::resource_id_t service = 0;
 namespace to {
 struct context {};
 } // namespace to
+
+using op_t = io_stats_t::op_t;
+
+inline void record(io_stats_t *stats, op_t op, std::uint64_t bytes, io_stats_t::time_point_t started) noexcept {
+    if (stats) {
+        stats->record(op, bytes, started);
+    }
+}
 } // namespace
 
 template <> inline auto &rotor::supervisor_t::access<to::context>() noexcept { return context; }
 
 struct file_actor_t::process_context_t : fs_proxy_t {
-    process_context_t(const void *cache_key_, file_actor_t &actor)
-        : fs_proxy_t(*actor.updates_mediator, clock_t::local_time() + actor.retension), cache_key{cache_key_} {}
+    struct pending_io_t {
+        io_request_t request;
+        file_ptr_t file;
+        payload::block_request_t *read;
+        payload::append_block_t *write;
+        io_stats_t *stats;
+        io_stats_t::time_point_t started;
+    };
+    // requests addresses are handed to the engine, so they should not move
+    using pending_t = std::deque<pending_io_t>;
+    // the deferred I/O is performed with the settings of the folder of its command
+    struct buffered_write_t {
+        file_ptr_t file;
+        payload::append_block_t *cmd;
+        io_stats_t *stats;
+        bool watched;
+    };
+    using buffered_t = std::vector<buffered_write_t>;
+    struct finishing_file_t {
+        payload::finish_file_t *cmd;
+        io_stats_t *stats;
+        bool watched;
+    };
+    using finishing_t = std::vector<finishing_file_t>;
+
+    process_context_t(const void *cache_key_, file_actor_t &actor, io_engine_t *io_engine_, bool async_)
+        : fs_proxy_t(*actor.updates_mediator, clock_t::local_time() + actor.retension), cache_key{cache_key_},
+          io_engine{io_engine_}, async{async_} {
+        ro_cache = actor.ro_cache.get();
+    }
+
+    void select(bool watched_, io_stats_t *stats_) noexcept {
+        watched = watched_;
+        stats = stats_;
+        updates_mediator.enable(watched);
+    }
+
     const void *cache_key;
+    io_engine_t *io_engine;
+    bool async; // i.e. the engine notifies about finished requests, so there is no need to wait them
+    pending_t pending;
+    buffered_t buffered;
+    std::size_t buffered_bytes = 0;
+    finishing_t finishing;
+    io_stats_t *stats = nullptr; // of the current command folder
+    bool watched = false;        // ditto
+};
+
+struct file_actor_t::batch_t {
+    batch_t(message::io_commands_t &message_, file_actor_t &actor, io_engine_t *io_engine, bool async)
+        : message{&message_}, context(message_.payload.context, actor, io_engine, async) {}
+
+    r::intrusive_ptr_t<message::io_commands_t> message;
+    r::address_ptr_t reply_to; // of the suspended batch
+    process_context_t context;
+    std::size_t next = 0; // command index
 };
 
 file_actor_t::file_actor_t(config_t &cfg)
-    : r::actor_base_t{cfg}, concurrent_hashes{cfg.concurrent_hashes}, retension{cfg.change_retension},
+    : r::actor_base_t{cfg}, concurrent_hashes{cfg.concurrent_hashes}, write_buffer{cfg.write_buffer},
+      durable{cfg.durable}, retension{cfg.change_retension}, stats_interval{cfg.stats_interval},
       updates_mediator{cfg.updates_mediator}, scan_dir_callback(cfg.scan_dir_callback),
-      watched_folders(cfg.watched_folders) {
+      watched_folders(cfg.watched_folders), ro_cache{std::move(cfg.ro_cache)} {
     assert(updates_mediator);
     assert(watched_folders);
     if (!retension.is_positive()) {
@@ -49,6 +118,8 @@ file_actor_t::file_actor_t(config_t &cfg)
     }
 }
 
+file_actor_t::~file_actor_t() = default;
+
 void file_actor_t::configure(r::plugin::plugin_base_t &plugin) noexcept {
     r::actor_base_t::configure(plugin);
     plugin.with_casted<r::plugin::address_maker_plugin_t>([&](auto &p) {
@@ -74,13 +145,25 @@ void file_actor_t::configure(r::plugin::plugin_base_t &plugin) noexcept {
     plugin.with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
         p.subscribe_actor(&file_actor_t::on_exec);
         p.subscribe_actor(&file_actor_t::on_io_commands);
+        p.subscribe_actor(&file_actor_t::on_io_ready);
         p.subscribe_actor(&file_actor_t::on_create_dir);
     });
 }
 
 void file_actor_t::on_start() noexcept {
     LOG_TRACE(log, "on_start");
+    auto sup_ctx = static_cast<platform::context_base_t *>(supervisor->access<to::context>());
+    if (sup_ctx->io_engine && sup_ctx->io_events) {
+        // might be invoked from I/O threads
+        auto listener = [sup = supervisor, addr = address]() {
+            sup->enqueue(r::make_message<payload::io_ready_t>(addr));
+        };
+        sup_ctx->io_engine->set_listener(std::move(listener));
+    }
     send<model::payload::local_up_t>(coordinator);
+    if (stats_interval.is_positive()) {
+        stats_timer = start_timer(stats_interval, *this, &file_actor_t::on_stats_timeout);
+    }
     r::actor_base_t::on_start();
 }
 
@@ -89,29 +172,81 @@ void file_actor_t::shutdown_start() noexcept {
     if (coordinator) {
         send<net::payload::fs_predown_t>(coordinator);
     }
+    if (stats_timer) {
+        cancel_timer(*stats_timer);
+    }
+    // the suspended batches are finished synchronously, the next ones are not suspended at all
+    auto sup_ctx = static_cast<platform::context_base_t *>(supervisor->access<to::context>());
+    if (sup_ctx->io_engine && sup_ctx->io_events) {
+        sup_ctx->io_engine->set_listener({});
+    }
+    for (auto &batch : batches) {
+        batch->context.async = false;
+        resume(*batch);
+        reply(*batch);
+    }
+    batches.clear();
     r::actor_base_t::shutdown_start();
 }
 
 void file_actor_t::shutdown_finish() noexcept {
     LOG_TRACE(log, "shutdown_finish");
+    flush_journals(true);
+    journals.clear();
     context_cache.clear();
+    if (ro_cache) {
+        ro_cache->clear();
+    }
     r::actor_base_t::shutdown_finish();
 }
 
 void file_actor_t::on_io_commands(message::io_commands_t &message) noexcept {
-    auto &p = message.payload;
-    auto ctx = process_context_t(p.context, *this);
+    auto sup_ctx = static_cast<platform::context_base_t *>(supervisor->access<to::context>());
+    auto io_engine = sup_ctx->io_engine;
+    auto async = io_engine && sup_ctx->io_events && state == r::state_t::OPERATIONAL;
+    auto batch = std::make_unique<batch_t>(message, *this, io_engine, async);
+    if (batches.empty() && resume(*batch)) {
+        return;
+    }
+    // the batch waits for its block I/O (or for the previous batches), the reply is postponed
+    LOG_TRACE(log, "suspending I/O batch of {} commands, command #{}", message.payload.commands.size(), batch->next);
+    batch->reply_to = std::move(message.next_route);
+    batches.emplace_back(std::move(batch));
+}
 
-    for (auto &cmd : p.commands) {
+void file_actor_t::on_io_ready(message::io_ready_t &) noexcept {
+    auto sup_ctx = static_cast<platform::context_base_t *>(supervisor->access<to::context>());
+    if (sup_ctx->io_engine) {
+        // re-arms the notification, even if there are no batches
+        sup_ctx->io_engine->poll();
+    }
+    while (!batches.empty()) {
+        auto &batch = *batches.front();
+        if (!resume(batch)) {
+            break;
+        }
+        reply(batch);
+        batches.pop_front();
+    }
+}
+
+bool file_actor_t::resume(batch_t &batch) noexcept {
+    auto &ctx = batch.context;
+    auto &commands = batch.message->payload.commands;
+    ctx.deadline = clock_t::local_time() + retension;
+
+    while (batch.next < commands.size()) {
         static const size_t SS_PATH_MAX = 32 * 1024;
         auto buffer = std::array<char, SS_PATH_MAX>();
         auto pool = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
         auto allocator = std::pmr::polymorphic_allocator<std::string>(&pool);
         auto ptr = const_cast<char *>(buffer.data());
 
-        std::visit(
-            [&](auto &cmd) {
-                ctx.updates_mediator.enable(watched_folders->contains(cmd.folder_id));
+        auto processed = std::visit(
+            [&](auto &cmd) -> bool {
+                auto watched = watched_folders->contains(cmd.folder_id);
+                auto stats = get_stats(cmd.folder_id);
+                ctx.select(watched, stats);
                 auto path_wstr = cmd.path.generic_wstring();
                 auto path_wstr_ptr = path_wstr.data();
                 auto path_str = std::string();
@@ -122,16 +257,59 @@ void file_actor_t::on_io_commands(message::io_commands_t &message) noexcept {
                     path_str = narrow(path_wstr);
                     path_view = path_str;
                 }
+                using command_t = std::decay_t<decltype(cmd)>;
+                constexpr bool is_block_io = std::is_same_v<command_t, payload::block_request_t> ||
+                                             std::is_same_v<command_t, payload::append_block_t>;
+                if constexpr (is_block_io) {
+                    if (ctx.io_engine && submit(cmd, ctx)) {
+                        return true;
+                    }
+                }
+                if constexpr (std::is_same_v<command_t, payload::append_block_t>) {
+                    if (!ctx.io_engine && buffer_block(cmd, ctx)) {
+                        return true;
+                    }
+                }
+                // everything else might depend on the previous blocks I/O, i.e. it is a barrier
+                if (!ready(ctx)) {
+                    return false;
+                }
+                complete(ctx);
+                if constexpr (!std::is_same_v<command_t, payload::finish_file_t>) {
+                    // ... and on the finished files
+                    commit(ctx);
+                }
+                ctx.select(watched, stats);
                 process(cmd, path_view, ctx);
+                return true;
             },
-            cmd);
+            commands[batch.next]);
+        if (!processed) {
+            return false;
+        }
+        ++batch.next;
+    }
+    if (!ready(ctx)) {
+        return false;
     }
+    complete(ctx);
+    commit(ctx);
+    flush_journals(false);
 
     if (ctx.mediator_updates && !expiration_timer) {
         expiration_timer = start_timer(retension, *this, &file_actor_t::on_retension_finish);
     }
     auto sup_ctx = static_cast<platform::context_base_t *>(supervisor->access<to::context>());
     sup_ctx->poll_events();
+    return true;
+}
+
+void file_actor_t::reply(batch_t &batch) noexcept {
+    auto &message = batch.message;
+    if (batch.reply_to) {
+        message->address = std::move(batch.reply_to);
+        supervisor->put(std::move(message));
+    }
 }
 
 void file_actor_t::on_retension_finish(r::request_id_t, bool cancelled) noexcept {
@@ -145,12 +323,53 @@ void file_actor_t::on_retension_finish(r::request_id_t, bool cancelled) noexcept
     }
 }
 
+void file_actor_t::on_stats_timeout(r::request_id_t, bool cancelled) noexcept {
+    stats_timer.reset();
+    if (cancelled) {
+        return;
+    }
+    auto folders = model::diff::local::folders_io_t();
+    for (auto &[folder_id, stats] : io_stats) {
+        if (stats.empty()) {
+            continue;
+        }
+        auto &folder = folders.emplace_back(model::diff::local::folder_io_t{folder_id, {}});
+        for (std::size_t i = 0; i < io_stats_t::ops_count; ++i) {
+            auto op = static_cast<op_t>(i);
+            auto &c = stats.get(op);
+            if (c.count) {
+                auto name = io_stats_t::get_name(op);
+                auto p99 = c.percentile(0.99);
+                LOG_DEBUG(log, "folder '{}' {}: {} ops, {} bytes, avg: {}us, p50: {}us, p99: {}us, max: {}us",
+                          folder_id, name, c.count, c.bytes, c.total_us / c.count, c.percentile(0.5), p99, c.max_us);
+                auto counter = model::folder_t::io_counter_t{c.count, c.bytes, c.total_us, p99, c.max_us};
+                folder.counters.emplace(std::string(name), counter);
+            }
+        }
+    }
+    io_stats.clear();
+    if (!folders.empty() && coordinator) {
+        auto diff = model::diff::cluster_diff_ptr_t();
+        diff.reset(new model::diff::local::io_stats_t(std::move(folders)));
+        send<model::payload::model_update_t>(coordinator, std::move(diff));
+    }
+    stats_timer = start_timer(stats_interval, *this, &file_actor_t::on_stats_timeout);
+}
+
+auto file_actor_t::get_stats(const std::string &folder_id) noexcept -> io_stats_t * {
+    if (!stats_interval.is_positive()) {
+        return nullptr;
+    }
+    return &io_stats[folder_id];
+}
+
 void file_actor_t::on_exec(message::foreign_executor_t &request) noexcept {
     struct execution_ctx_impl_t final : execution_context_t {
         execution_ctx_impl_t(file_actor_t &actor_)
             : actor{&actor_}, fs_proxy_holder(*actor_.updates_mediator, clock_t::local_time() + actor_.retension) {
             plugin = actor->hasher;
             fs_proxy = &fs_proxy_holder;
+            fs_proxy_holder.ro_cache = actor->ro_cache.get();
             scan_dir_callback = actor->scan_dir_callback;
         }
 
@@ -162,6 +381,8 @@ void file_actor_t::on_exec(message::foreign_executor_t &request) noexcept {
     auto slave = static_cast<fs::fs_slave_t *>(request.payload.get());
     slave->ec = {};
     auto ctx = execution_ctx_impl_t(*this);
+    ctx.io_stats = get_stats(slave->folder_id);
+    ctx.scan_pool = static_cast<platform::context_base_t *>(supervisor->access<to::context>())->scan_pool;
     auto updated = slave->exec(ctx);
     if (updated && !expiration_timer) {
         expiration_timer = start_timer(retension, *this, &file_actor_t::on_retension_finish);
@@ -177,6 +398,9 @@ void file_actor_t::on_controller_predown(net::message::controller_predown_t &mes
     auto &p = message.payload;
     LOG_DEBUG(log, "on_controller_predown, {}, started: {}", (const void *)p.controller.get(), p.started);
     if (p.started) {
+        // the controller will not write anymore, remember what has been written
+        flush_journals(true);
+        journals.clear();
         auto cache_key = p.controller.get();
         if (auto it = context_cache.find(cache_key); it != context_cache.end()) {
             context_cache.erase(it);
@@ -203,7 +427,7 @@ void file_actor_t::process(payload::block_request_t &cmd, std::string_view path_
                            process_context_t &context) noexcept {
     LOG_TRACE(log, "processing block request");
     auto &path = cmd.path;
-    auto file_opt = open_file_ro(path, context.cache_key);
+    auto file_opt = open_file_ro(path, context.cache_key, context.stats);
     auto ec = sys::error_code{};
     auto data = utils::bytes_t{};
     if (!file_opt) {
@@ -213,7 +437,15 @@ void file_actor_t::process(payload::block_request_t &cmd, std::string_view path_
         return;
     } else {
         auto &file = file_opt.assume_value();
+        if (!cmd.uncached) {
+            file->advise_read(context.cache_key, cmd.offset, static_cast<std::uint32_t>(cmd.block_size));
+        }
+        auto started = io_stats_t::now();
         auto block_opt = file->read(cmd.offset, cmd.block_size);
+        record(context.stats, op_t::read, block_opt ? cmd.block_size : 0, started);
+        if (cmd.uncached) {
+            file->drop_cache(cmd.offset, cmd.block_size);
+        }
         if (!block_opt) {
             ec = block_opt.assume_error();
             LOG_WARN(log, "error requesting block; offset = {}, size = {} :: {} ", cmd.offset, cmd.block_size,
@@ -227,6 +459,351 @@ void file_actor_t::process(payload::block_request_t &cmd, std::string_view path_
     cmd.result = std::move(data);
 }
 
+bool file_actor_t::submit(payload::block_request_t &cmd, process_context_t &context) noexcept {
+    if (!cmd.block_size) {
+        return false;
+    }
+    auto file_opt = open_file_ro(cmd.path, context.cache_key, context.stats);
+    if (!file_opt) {
+        return false;
+    }
+    auto &file = file_opt.assume_value();
+    auto fd = file->get_native_handle();
+    if (!cmd.uncached) {
+        file->advise_read(context.cache_key, cmd.offset, static_cast<std::uint32_t>(cmd.block_size));
+    }
+
+    cmd.result = utils::bytes_t(cmd.block_size);
+    auto data = cmd.result.assume_value().data();
+    auto size = static_cast<std::uint32_t>(cmd.block_size);
+    for (int i = 0; i < 2; ++i) {
+        auto request = io_request_t{fd, false, cmd.offset, data, size};
+        auto io_ctx = process_context_t::pending_io_t{request, file, &cmd, nullptr, context.stats, io_stats_t::now()};
+        auto &io = context.pending.emplace_back(std::move(io_ctx));
+        if (context.io_engine->submit(io.request)) {
+            LOG_TRACE(log, "submitted block request; offset = {}, size = {}", cmd.offset, cmd.block_size);
+            return true;
+        }
+        context.pending.pop_back();
+        if (context.async) {
+            // no room, retried when the previous requests are finished
+            return false;
+        }
+        complete(context);
+    }
+    return false;
+}
+
+bool file_actor_t::submit(payload::append_block_t &cmd, process_context_t &context) noexcept {
+    if (cmd.zeroes || cmd.data.empty()) {
+        return false;
+    }
+    auto file_opt = open_file_rw(cmd.path, cmd.file_size, context, cmd.preallocate, cmd.uncached);
+    if (!file_opt) {
+        return false;
+    }
+    auto &file = file_opt.assume_value();
+    auto fd = file->get_native_handle();
+
+    auto size = static_cast<std::uint32_t>(cmd.data.size());
+    for (int i = 0; i < 2; ++i) {
+        auto request = io_request_t{fd, true, cmd.offset, cmd.data.data(), size};
+        auto io_ctx = process_context_t::pending_io_t{request, file, nullptr, &cmd, context.stats, io_stats_t::now()};
+        auto &io = context.pending.emplace_back(std::move(io_ctx));
+        if (context.io_engine->submit(io.request)) {
+            if (cmd.trace) {
+                cmd.trace->mark(utils::block_stage_t::write_started);
+            }
+            context.updates_mediator.mask(file->get_path(), {}, context.deadline);
+            return true;
+        }
+        context.pending.pop_back();
+        if (context.async) {
+            // no room, retried when the previous requests are finished
+            return false;
+        }
+        complete(context);
+    }
+    return false;
+}
+
+// the buffer does not outlive the batch of commands: each block reply carries the
+// actual result of its write, so the write cannot be postponed past the reply
+bool file_actor_t::buffer_block(payload::append_block_t &cmd, process_context_t &context) noexcept {
+    if (!write_buffer || cmd.zeroes || cmd.data.empty()) {
+        return false;
+    }
+    auto file_opt = open_file_rw(cmd.path, cmd.file_size, context, cmd.preallocate, cmd.uncached);
+    if (!file_opt) {
+        return false;
+    }
+    if (cmd.trace) {
+        cmd.trace->mark(utils::block_stage_t::write_started);
+    }
+    auto &file = file_opt.assume_value();
+    auto write = process_context_t::buffered_write_t{std::move(file), &cmd, context.stats, context.watched};
+    context.buffered.emplace_back(std::move(write));
+    context.buffered_bytes += cmd.data.size();
+    if (context.buffered_bytes >= write_buffer) {
+        flush(context);
+    }
+    return true;
+}
+
+void file_actor_t::flush(process_context_t &context) noexcept {
+    using buffered_write_t = process_context_t::buffered_write_t;
+    static constexpr std::size_t max_chunks = 64;
+
+    auto &buffered = context.buffered;
+    if (buffered.empty()) {
+        return;
+    }
+
+    // the order of overlapping writes should be kept, hence the stable sort
+    std::stable_sort(buffered.begin(), buffered.end(), [](const buffered_write_t &l, const buffered_write_t &r) {
+        return std::tie(l.file, l.cmd->offset) < std::tie(r.file, r.cmd->offset);
+    });
+
+    auto chunks = std::array<utils::bytes_view_t, max_chunks>();
+    auto writes = std::size_t{0};
+    auto it = buffered.begin();
+    while (it != buffered.end()) {
+        auto &file = it->file;
+        auto offset = it->cmd->offset;
+        auto next = offset;
+        auto count = std::size_t{0};
+        auto end = it;
+        while (end != buffered.end() && end->file == file && end->cmd->offset == next && count < max_chunks) {
+            chunks[count++] = end->cmd->data;
+            next += end->cmd->data.size();
+            ++end;
+        }
+
+        context.select(it->watched, it->stats);
+        auto started = io_stats_t::now();
+        auto result = file->write(context, offset, std::span(chunks.data(), count));
+        record(context.stats, op_t::write, result ? next - offset : 0, started);
+        if (!result) {
+            auto path_str = narrow(file->get_path().generic_wstring());
+            LOG_ERROR(log, "cannot write {} blocks to {}; offset = {} :: {}", count, path_str, offset,
+                      result.assume_error().message());
+        }
+        for (; it != end; ++it) {
+            auto &cmd = *it->cmd;
+            cmd.result = result;
+            if (result) {
+                journal_block(cmd.path, file, cmd.file_size, cmd.journal, cmd.data.size());
+            }
+            if (cmd.trace) {
+                cmd.trace->mark(utils::block_stage_t::written);
+            }
+        }
+        ++writes;
+    }
+    LOG_TRACE(log, "flushed {} blocks ({} bytes) in {} writes", buffered.size(), context.buffered_bytes, writes);
+    buffered.clear();
+    context.buffered_bytes = 0;
+}
+
+bool file_actor_t::ready(process_context_t &context) noexcept {
+    auto &pending = context.pending;
+    if (!context.async || pending.empty()) {
+        return true;
+    }
+    context.io_engine->poll();
+    auto finished = [](const process_context_t::pending_io_t &io) { return io.request.finished; };
+    return std::all_of(pending.begin(), pending.end(), finished);
+}
+
+void file_actor_t::complete(process_context_t &context) noexcept {
+    flush(context);
+
+    auto &pending = context.pending;
+    if (pending.empty()) {
+        return;
+    }
+
+    context.io_engine->complete();
+    LOG_TRACE(log, "{} block I/O requests are complete", pending.size());
+    for (auto &io : pending) {
+        auto &request = io.request;
+        auto ec = sys::error_code{};
+        if (request.error) {
+            ec = sys::error_code{request.error, sys::system_category()};
+        }
+        auto op = io.read ? op_t::read : op_t::write;
+        record(io.stats, op, ec ? 0 : request.size, io.started);
+        if (io.read) {
+            auto &cmd = *io.read;
+            if (cmd.uncached) {
+                io.file->drop_cache(cmd.offset, cmd.block_size);
+            }
+            if (ec) {
+                LOG_WARN(log, "error requesting block; offset = {}, size = {} :: {} ", cmd.offset, cmd.block_size,
+                         ec.message());
+                cmd.result = ec;
+            }
+        } else {
+            auto &cmd = *io.write;
+            if (ec) {
+                auto path_str = narrow(io.file->get_path().generic_wstring());
+                LOG_ERROR(log, "cannot write block to {}; offset = {} :: {}", path_str, cmd.offset, ec.message());
+                cmd.result = ec;
+            } else {
+                cmd.result = outcome::success();
+                io.file->on_written(cmd.offset, request.size);
+                journal_block(cmd.path, io.file, cmd.file_size, cmd.journal, request.size);
+            }
+            if (cmd.trace) {
+                cmd.trace->mark(utils::block_stage_t::written);
+            }
+        }
+    }
+    pending.clear();
+}
+
+void file_actor_t::commit(process_context_t &context) noexcept {
+    // with many files it is cheaper to sync the whole filesystem once, than each file
+    static constexpr std::size_t group_threshold = 4;
+
+    auto &finishing = context.finishing;
+    if (finishing.empty()) {
+        return;
+    }
+
+    auto &file_cache = context_cache[context.cache_key];
+    auto devices = std::vector<std::tuple<std::uint64_t, bfs::path, io_stats_t *>>();
+    auto sync_devices = [&]() -> sys::error_code {
+        for (auto &[device, dir, stats] : devices) {
+            auto started = io_stats_t::now();
+            auto ec = file_handle_t::sync_fs(dir);
+            record(stats, op_t::sync, 0, started);
+            if (ec) {
+                return ec;
+            }
+        }
+        return {};
+    };
+    if (finishing.size() >= group_threshold) {
+        for (auto &[cmd, stats, watched] : finishing) {
+            auto it = file_cache.find(cmd->path);
+            if (it == file_cache.end()) {
+                continue;
+            }
+            auto device = file_handle_t::device_of(it->second->get_native_handle());
+            auto predicate = [device](auto &it) { return std::get<0>(it) == device; };
+            if (std::find_if(devices.begin(), devices.end(), predicate) == devices.end()) {
+                devices.emplace_back(device, cmd->path.parent_path(), stats);
+            }
+        }
+    }
+
+    // the data should hit the disk before the files are renamed ...
+    auto grouped = false;
+    if (!devices.empty()) {
+        auto ec = sync_devices();
+        grouped = !ec;
+        if (ec && ec != sys::errc::operation_not_supported) {
+            LOG_WARN(log, "cannot sync filesystem, falling back to per-file sync: {}", ec.message());
+        }
+    }
+    auto dirs = std::vector<std::pair<bfs::path, io_stats_t *>>();
+    for (auto &[cmd, stats, watched] : finishing) {
+        auto path_str = narrow(cmd->path.generic_wstring());
+        context.select(watched, stats);
+        auto it = file_cache.find(cmd->path);
+        if (it == file_cache.end()) {
+            // the same file has already been finished in the group
+            LOG_WARN(log, "attempt to flush non-opened file {}", path_str);
+            cmd->result = utils::make_error_code(utils::error_code_t::flush_non_opened);
+            continue;
+        }
+        if (!grouped) {
+            auto started = io_stats_t::now();
+            auto r = it->second->sync();
+            record(stats, op_t::sync, 0, started);
+            if (!r) {
+                auto &ec = r.assume_error();
+                LOG_ERROR(log, "cannot sync {}: {}", path_str, ec.message());
+                cmd->result = ec;
+                continue;
+            }
+        }
+        finish(*cmd, path_str, context);
+        if (cmd->result) {
+            for (auto path : {&cmd->path, &cmd->conflict_path}) {
+                auto dir = path->parent_path();
+                auto predicate = [&dir](auto &it) { return it.first == dir; };
+                if (!path->empty() && std::find_if(dirs.begin(), dirs.end(), predicate) == dirs.end()) {
+                    dirs.emplace_back(std::move(dir), stats);
+                }
+            }
+        }
+    }
+
+    // ... and then the renames themselves
+    auto ec = sys::error_code();
+    if (grouped) {
+        ec = sync_devices();
+    } else {
+        for (auto &[dir, stats] : dirs) {
+            auto started = io_stats_t::now();
+            ec = file_handle_t::sync_dir(dir);
+            record(stats, op_t::sync, 0, started);
+            if (ec) {
+                break;
+            }
+        }
+    }
+    if (ec) {
+        LOG_ERROR(log, "cannot sync directories of finished files: {}", ec.message());
+        for (auto &f : finishing) {
+            auto cmd = f.cmd;
+            if (cmd->result) {
+                cmd->result = ec;
+            }
+        }
+    }
+    LOG_DEBUG(log, "{} finished file(s) are synced", finishing.size());
+    finishing.clear();
+}
+
+void file_actor_t::journal_block(const bfs::path &path, const file_ptr_t &file, std::uint64_t file_size,
+                                 const payload::journal_record_t &record, std::uint64_t bytes) noexcept {
+    if (record.block_index < 0) {
+        return;
+    }
+    auto it = journals.find(path);
+    auto replace = it == journals.end() || it->second.file != file ||
+                   !it->second.journal.matches(file_size, record.modification_s);
+    if (replace) {
+        auto journal = journal_t(path, file_size, record.modification_s);
+        it = journals.insert_or_assign(path, journaled_file_t{file, std::move(journal)}).first;
+    }
+    it->second.journal.add(static_cast<std::uint32_t>(record.block_index), record.hash, bytes);
+}
+
+void file_actor_t::flush_journals(bool force) noexcept {
+    // it is a trade-off between the fsync() calls and the amount of data
+    // to be downloaded again after a crash
+    static constexpr std::uint64_t journal_threshold = 16 * 1024 * 1024;
+
+    for (auto &[path, item] : journals) {
+        auto pending = item.journal.get_pending();
+        if (!pending || (!force && pending < journal_threshold)) {
+            continue;
+        }
+        // the records should never get ahead of the data
+        auto r = item.file->sync();
+        auto ec = r ? item.journal.flush() : r.assume_error();
+        if (ec) {
+            LOG_WARN(log, "cannot update journal of '{}': {}", narrow(path.generic_wstring()), ec.message());
+        } else {
+            LOG_TRACE(log, "journal of '{}' is updated ({} bytes)", narrow(path.generic_wstring()), pending);
+        }
+    }
+}
+
 void file_actor_t::process(payload::remote_copy_t &cmd, std::string_view path_str,
                            process_context_t &context) noexcept {
     auto &path = cmd.path;
@@ -235,7 +812,10 @@ void file_actor_t::process(payload::remote_copy_t &cmd, std::string_view path_st
     if (!cmd.conflict_path.empty()) {
         auto conflict_path_str = cmd.conflict_path.generic_string();
         LOG_DEBUG(log, "renaming {} -> {}", path_str, conflict_path_str);
-        if (auto ec = context.rename(cmd.path, cmd.conflict_path); ec) {
+        auto started = io_stats_t::now();
+        auto ec = context.rename(cmd.path, cmd.conflict_path);
+        record(context.stats, op_t::rename, 0, started);
+        if (ec) {
             LOG_ERROR(log, "cannot rename file: {}: {}", path_str, ec.message());
             cmd.result = ec;
             return;
@@ -347,12 +927,28 @@ void file_actor_t::process(payload::finish_file_t &cmd, std::string_view path_st
         it = file_cache.emplace(cmd.path, ptr).first;
     }
 
+    if (durable) {
+        // postponed until the whole group of files is synced, see commit()
+        context.finishing.emplace_back(process_context_t::finishing_file_t{&cmd, context.stats, context.watched});
+        return;
+    }
+    finish(cmd, path_str, context);
+}
+
+void file_actor_t::finish(payload::finish_file_t &cmd, std::string_view path_str,
+                          process_context_t &context) noexcept {
+    auto &file_cache = context_cache[context.cache_key];
+    auto it = file_cache.find(cmd.path);
+    assert(it != file_cache.end());
+
     auto backend = it->second;
     if (!cmd.conflict_path.empty()) {
         auto new_name = narrow(cmd.conflict_path.generic_wstring());
         LOG_DEBUG(log, "renaming {} -> {}", path_str, new_name);
-        auto ec = sys::error_code();
-        if (auto ec = context.rename(cmd.path, cmd.conflict_path); ec) {
+        auto started = io_stats_t::now();
+        auto ec = context.rename(cmd.path, cmd.conflict_path);
+        record(context.stats, op_t::rename, 0, started);
+        if (ec) {
             LOG_ERROR(log, "cannot rename file '{}': {}", path_str, ec.message());
             cmd.result = ec;
             return;
@@ -360,13 +956,24 @@ void file_actor_t::process(payload::finish_file_t &cmd, std::string_view path_st
     }
 
     file_cache.erase(it);
+    auto journaled = journals.erase(cmd.path);
+    // the temporal file is renamed to the final one on closing
+    auto started = io_stats_t::now();
     auto ok = backend->close(&context, cmd.modification_s, cmd.path);
+    record(context.stats, op_t::rename, 0, started);
     if (!ok) {
         auto &ec = ok.assume_error();
         LOG_ERROR(log, "cannot close file '{}': {}", path_str, ec.message());
         cmd.result = ec;
         return;
     }
+    if (journaled) {
+        // the file is complete, the journal is not needed anymore (the failure is
+        // not fatal: orphan journals are removed on scanning)
+        if (auto ec = journal_t::remove(cmd.path); ec) {
+            LOG_DEBUG(log, "cannot remove journal of '{}': {}", path_str, ec.message());
+        }
+    }
 
     if (!cmd.no_permissions) {
         if (auto ec = context.set_perms(cmd.path, cmd.permissions); ec) {
@@ -384,7 +991,7 @@ void file_actor_t::process(payload::finish_file_t &cmd, std::string_view path_st
 void file_actor_t::process(payload::append_block_t &cmd, std::string_view path_str,
                            process_context_t &context) noexcept {
     auto &path = cmd.path;
-    auto file_opt = open_file_rw(path, cmd.file_size, context);
+    auto file_opt = open_file_rw(path, cmd.file_size, context, cmd.preallocate, cmd.uncached);
     if (!file_opt) {
         auto &err = file_opt.assume_error();
         LOG_ERROR(log, "cannot open file: {}: {}", path_str, err.message());
@@ -392,13 +999,29 @@ void file_actor_t::process(payload::append_block_t &cmd, std::string_view path_s
         return;
     }
     auto &backend = file_opt.assume_value();
-    cmd.result = backend->write(context, cmd.offset, cmd.data);
+    if (cmd.trace) {
+        cmd.trace->mark(utils::block_stage_t::write_started);
+    }
+    auto started = io_stats_t::now();
+    if (cmd.zeroes) {
+        cmd.result = backend->zero(context, cmd.offset, cmd.zeroes);
+    } else {
+        cmd.result = backend->write(context, cmd.offset, cmd.data);
+    }
+    auto bytes = cmd.zeroes ? cmd.zeroes : cmd.data.size();
+    record(context.stats, op_t::write, cmd.result ? bytes : 0, started);
+    if (cmd.result) {
+        journal_block(cmd.path, backend, cmd.file_size, cmd.journal, bytes);
+    }
+    if (cmd.trace) {
+        cmd.trace->mark(utils::block_stage_t::written);
+    }
 }
 
 void file_actor_t::process(payload::clone_block_t &cmd, std::string_view path_str,
                            process_context_t &context) noexcept {
     auto &target_path = cmd.path;
-    auto target_opt = open_file_rw(target_path, cmd.target_size, context);
+    auto target_opt = open_file_rw(target_path, cmd.target_size, context, cmd.preallocate, cmd.uncached);
     if (!target_opt) {
         auto &err = target_opt.assume_error();
         LOG_ERROR(log, "cannot open file: {}: {}", path_str, err.message());
@@ -412,7 +1035,7 @@ void file_actor_t::process(payload::clone_block_t &cmd, std::string_view path_st
         if (it != file_cache.end()) {
             return it->second;
         } else {
-            return open_file_ro(cmd.source, {});
+            return open_file_ro(cmd.source, {}, context.stats);
         }
     }();
     if (!source_backend_opt) {
@@ -423,7 +1046,69 @@ void file_actor_t::process(payload::clone_block_t &cmd, std::string_view path_st
         return;
     }
     auto &source_backend = *source_backend_opt.assume_value();
+    auto started = io_stats_t::now();
     cmd.result = target_backend->copy(context, cmd.target_offset, source_backend, cmd.source_offset, cmd.block_size);
+    record(context.stats, op_t::write, cmd.result ? cmd.block_size : 0, started);
+    if (cmd.result) {
+        journal_block(cmd.path, target_backend, cmd.target_size, cmd.journal, cmd.block_size);
+    }
+}
+
+void file_actor_t::process(payload::clone_file_t &cmd, std::string_view path_str,
+                           process_context_t &context) noexcept {
+    auto source_str = narrow(cmd.source.generic_wstring());
+    LOG_DEBUG(log, "cloning whole file {} -> {}", source_str, path_str);
+    auto source_opt = open_file_ro(cmd.source, {}, context.stats);
+    if (!source_opt) {
+        auto &ec = source_opt.assume_error();
+        LOG_ERROR(log, "cannot open source file for cloning: {}: {}", source_str, ec.message());
+        cmd.result = ec;
+        return;
+    }
+    auto target_opt = open_file_rw(cmd.path, cmd.file_size, context);
+    if (!target_opt) {
+        auto &ec = target_opt.assume_error();
+        LOG_ERROR(log, "cannot open file: {}: {}", path_str, ec.message());
+        cmd.result = ec;
+        return;
+    }
+    auto &target = target_opt.assume_value();
+    auto &source = *source_opt.assume_value();
+    auto started = io_stats_t::now();
+    auto copied = target->copy(context, 0, source, 0, cmd.file_size);
+    record(context.stats, op_t::write, copied ? cmd.file_size : 0, started);
+    if (!copied) {
+        auto &ec = copied.assume_error();
+        LOG_ERROR(log, "cannot clone {} -> {}: {}", source_str, path_str, ec.message());
+        cmd.result = ec;
+        return;
+    }
+
+    if (durable) {
+        started = io_stats_t::now();
+        auto r = target->sync();
+        record(context.stats, op_t::sync, 0, started);
+        if (!r) {
+            auto &ec = r.assume_error();
+            LOG_ERROR(log, "cannot sync {}: {}", path_str, ec.message());
+            cmd.result = ec;
+            return;
+        }
+    }
+
+    auto finish = payload::finish_file_t({}, cmd.folder_id, cmd.path, cmd.conflict_path, cmd.file_size,
+                                         cmd.modification_s, cmd.permissions, cmd.no_permissions);
+    this->finish(finish, path_str, context);
+    if (durable && finish.result) {
+        started = io_stats_t::now();
+        auto ec = file_handle_t::sync_dir(cmd.path.parent_path());
+        record(context.stats, op_t::sync, 0, started);
+        if (ec) {
+            LOG_ERROR(log, "cannot sync directory of {}: {}", path_str, ec.message());
+            finish.result = ec;
+        }
+    }
+    cmd.result = std::move(finish.result);
 }
 
 void file_actor_t::process(payload::update_meta_t &cmd, std::string_view path_str,
@@ -446,7 +1131,8 @@ void file_actor_t::process(payload::update_meta_t &cmd, std::string_view path_st
 }
 
 auto file_actor_t::open_file_rw(const std::filesystem::path &path, std::uint64_t file_size,
-                                process_context_t &context) noexcept -> outcome::result<file_ptr_t> {
+                                process_context_t &context, bool preallocate, bool uncached) noexcept
+    -> outcome::result<file_ptr_t> {
     auto &file_cache = context_cache[context.cache_key];
     auto it = file_cache.find(path);
     if (it != file_cache.end()) {
@@ -464,17 +1150,21 @@ auto file_actor_t::open_file_rw(const std::filesystem::path &path, std::uint64_t
         }
     }
 
-    auto option = file_t::open_write(context, path, file_size);
+    auto started = io_stats_t::now();
+    auto option = file_t::open_write(context, path, file_size, preallocate);
+    record(context.stats, op_t::open, 0, started);
     if (!option) {
         return option.assume_error();
     }
     auto ptr = file_ptr_t(new file_t(std::move(option.assume_value())));
+    ptr->set_uncached(uncached);
     file_cache[path] = ptr;
     LOG_TRACE(log, "open_file (rw), path = {}, size = {}, cache sz: {}", path.string(), file_size, file_cache.size());
     return ptr;
 }
 
-auto file_actor_t::open_file_ro(const bfs::path &path, const void *context) noexcept -> outcome::result<file_ptr_t> {
+auto file_actor_t::open_file_ro(const bfs::path &path, const void *context, io_stats_t *stats) noexcept
+    -> outcome::result<file_ptr_t> {
     if (context) {
         auto &file_cache = context_cache[context];
         auto it = file_cache.find(path);
@@ -484,12 +1174,25 @@ auto file_actor_t::open_file_ro(const bfs::path &path, const void *context) noex
         }
     }
 
+    if (ro_cache) {
+        if (auto file = ro_cache->get(path); file) {
+            LOG_TRACE(log, "open_file (r/o, by path, ro cache hit), path = {}", path.string());
+            return file;
+        }
+    }
+
+    auto started = io_stats_t::now();
     auto opt = file_t::open_read(path);
+    record(stats, op_t::open, 0, started);
     if (!opt) {
         return opt.assume_error();
     }
     LOG_TRACE(log, "open_file (r/o, by path), path = {}", path.string());
-    return file_ptr_t(new file_t(std::move(opt.assume_value())));
+    auto file = file_ptr_t(new file_t(std::move(opt.assume_value())));
+    if (ro_cache) {
+        ro_cache->put(file);
+    }
+    return file;
 }
 
 void file_actor_t::on_create_dir(message::create_dir_t &message) noexcept {
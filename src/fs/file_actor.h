@@ -5,6 +5,9 @@
 
 #include "messages.h"
 #include "file.h"
+#include "file_cache.h"
+#include "io_stats.h"
+#include "journal.h"
 #include "updates_mediator.h"
 #include "watched_folders.h"
 #include "net/messages.h"
@@ -13,6 +16,8 @@
 #include "model/file_info.h"
 #include "model/messages.h"
 #include <rotor.hpp>
+#include <deque>
+#include <memory>
 #include <optional>
 
 // buggy mingw fix:
@@ -39,9 +44,13 @@ namespace outcome = boost::outcome_v2;
 struct SYNCSPIRIT_API file_actor_config_t : r::actor_config_t {
     using scan_dir_callback_t = execution_context_t::scan_dir_callback_t;
     uint32_t concurrent_hashes;
+    uint32_t write_buffer = 0;
+    bool durable = false;
     r::pt::time_duration change_retension;
+    r::pt::time_duration stats_interval;
     updates_mediator_ptr_t updates_mediator;
     watched_folders_ptr_t watched_folders;
+    file_cache_ptr_t ro_cache;
     scan_dir_callback_t scan_dir_callback;
 };
 
@@ -54,10 +63,22 @@ template <typename Actor> struct file_actor_config_builder_t : r::actor_config_b
         parent_t::config.concurrent_hashes = value;
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
     }
+    builder_t &&write_buffer(uint32_t value) && noexcept {
+        parent_t::config.write_buffer = value;
+        return std::move(*static_cast<typename parent_t::builder_t *>(this));
+    }
+    builder_t &&durable(bool value) && noexcept {
+        parent_t::config.durable = value;
+        return std::move(*static_cast<typename parent_t::builder_t *>(this));
+    }
     builder_t &&change_retension(const r::pt::time_duration &value) && noexcept {
         parent_t::config.change_retension = value;
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
     }
+    builder_t &&stats_interval(const r::pt::time_duration &value) && noexcept {
+        parent_t::config.stats_interval = value;
+        return std::move(*static_cast<typename parent_t::builder_t *>(this));
+    }
     builder_t &&updates_mediator(updates_mediator_ptr_t value) && noexcept {
         parent_t::config.updates_mediator = std::move(value);
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
@@ -66,6 +87,10 @@ template <typename Actor> struct file_actor_config_builder_t : r::actor_config_b
         parent_t::config.watched_folders = std::move(value);
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
     }
+    builder_t &&ro_cache(file_cache_ptr_t value) && noexcept {
+        parent_t::config.ro_cache = std::move(value);
+        return std::move(*static_cast<typename parent_t::builder_t *>(this));
+    }
     builder_t &&scan_dir_callback(execution_context_t::scan_dir_callback_t value) && noexcept {
         parent_t::config.scan_dir_callback = std::move(value);
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
@@ -80,8 +105,10 @@ struct SYNCSPIRIT_API file_actor_t : public r::actor_base_t {
                    r::plugin::link_server_plugin_t, r::plugin::link_client_plugin_t, hasher::hasher_plugin_t,
                    r::plugin::resources_plugin_t, r::plugin::starter_plugin_t>;
     struct process_context_t;
+    struct batch_t;
 
     explicit file_actor_t(config_t &cfg);
+    ~file_actor_t();
 
     void on_start() noexcept override;
     void shutdown_start() noexcept override;
@@ -92,19 +119,41 @@ struct SYNCSPIRIT_API file_actor_t : public r::actor_base_t {
   private:
     using clock_t = pt::microsec_clock;
     using file_cache_t = std::unordered_map<bfs::path, file_ptr_t>;
+    struct journaled_file_t {
+        file_ptr_t file;
+        journal_t journal;
+    };
+    using journals_t = std::unordered_map<bfs::path, journaled_file_t>;
     using context_cache_t = std::unordered_map<const void *, file_cache_t>;
     using timer_opt_t = std::optional<r::request_id_t>;
     using scan_dir_callback_t = execution_context_t::scan_dir_callback_t;
+    using batch_ptr_t = std::unique_ptr<batch_t>;
+    using batches_t = std::deque<batch_ptr_t>;
 
     void on_exec(message::foreign_executor_t &) noexcept;
     void on_io_commands(message::io_commands_t &) noexcept;
+    void on_io_ready(message::io_ready_t &) noexcept;
+    bool resume(batch_t &) noexcept;
+    void reply(batch_t &) noexcept;
     void on_create_dir(message::create_dir_t &) noexcept;
     void process(payload::block_request_t &, std::string_view, process_context_t &) noexcept;
     void process(payload::remote_copy_t &, std::string_view, process_context_t &) noexcept;
     void process(payload::append_block_t &, std::string_view, process_context_t &) noexcept;
     void process(payload::finish_file_t &, std::string_view, process_context_t &) noexcept;
     void process(payload::clone_block_t &, std::string_view, process_context_t &) noexcept;
+    void process(payload::clone_file_t &, std::string_view, process_context_t &) noexcept;
     void process(payload::update_meta_t &, std::string_view, process_context_t &) noexcept;
+    bool submit(payload::block_request_t &, process_context_t &) noexcept;
+    bool submit(payload::append_block_t &, process_context_t &) noexcept;
+    bool buffer_block(payload::append_block_t &, process_context_t &) noexcept;
+    void flush(process_context_t &) noexcept;
+    bool ready(process_context_t &) noexcept;
+    void complete(process_context_t &) noexcept;
+    void finish(payload::finish_file_t &, std::string_view, process_context_t &) noexcept;
+    void commit(process_context_t &) noexcept;
+    void journal_block(const bfs::path &path, const file_ptr_t &file, std::uint64_t file_size,
+                       const payload::journal_record_t &record, std::uint64_t bytes) noexcept;
+    void flush_journals(bool force) noexcept;
 
     void on_controller_up(net::message::controller_up_t &message) noexcept;
     void on_controller_predown(net::message::controller_predown_t &message) noexcept;
@@ -112,25 +161,36 @@ struct SYNCSPIRIT_API file_actor_t : public r::actor_base_t {
     void on_service_unlock(model::message::service_unlock_t &message) noexcept;
 
     void on_retension_finish(r::request_id_t, bool cancelled) noexcept;
+    void on_stats_timeout(r::request_id_t, bool cancelled) noexcept;
+    io_stats_t *get_stats(const std::string &folder_id) noexcept;
 
     outcome::result<file_ptr_t> get_source_for_cloning(model::file_info_ptr_t &source,
                                                        const model::folder_info_t &source_fi,
                                                        const file_ptr_t &target_backend) noexcept;
 
-    outcome::result<file_ptr_t> open_file_rw(const bfs::path &path, std::uint64_t file_size,
-                                             process_context_t &) noexcept;
-    outcome::result<file_ptr_t> open_file_ro(const bfs::path &path, const void *context = {}) noexcept;
+    outcome::result<file_ptr_t> open_file_rw(const bfs::path &path, std::uint64_t file_size, process_context_t &,
+                                             bool preallocate = false, bool uncached = false) noexcept;
+    outcome::result<file_ptr_t> open_file_ro(const bfs::path &path, const void *context = {},
+                                             io_stats_t *stats = nullptr) noexcept;
 
     utils::logger_t log;
     uint32_t concurrent_hashes;
+    uint32_t write_buffer;
+    bool durable;
     r::pt::time_duration retension;
+    r::pt::time_duration stats_interval;
     updates_mediator_ptr_t updates_mediator;
     watched_folders_ptr_t watched_folders;
     r::address_ptr_t coordinator;
     r::address_ptr_t db;
     context_cache_t context_cache;
+    journals_t journals;
+    batches_t batches; // suspended until their block I/O is finished, in the order of arrival
+    file_cache_ptr_t ro_cache;
     hasher::hasher_plugin_t *hasher = nullptr;
     timer_opt_t expiration_timer;
+    timer_opt_t stats_timer;
+    folder_io_stats_t io_stats;
     scan_dir_callback_t scan_dir_callback;
 };
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #include "file_cache.h"
 #include <cassert>
@@ -12,3 +12,22 @@ file_ptr_t file_cache_t::get(const bfs::path &path) noexcept {
     auto key = boost::nowide::narrow(path.generic_wstring());
     return parent_t::get(key);
 }
+
+void file_cache_t::remove(const bfs::path &path) noexcept {
+    auto key = boost::nowide::narrow(path.generic_wstring());
+    parent_t::remove_key(key);
+}
+
+void file_cache_t::remove_all(const bfs::path &path) noexcept {
+    auto key = boost::nowide::narrow(path.generic_wstring());
+    auto it = il.begin();
+    while (it != il.end()) {
+        auto item_key = (*it)->get_path_view();
+        auto beneath = item_key.size() > key.size() && item_key.starts_with(key) && item_key[key.size()] == '/';
+        if (beneath || item_key == key) {
+            it = il.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
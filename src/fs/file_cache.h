@@ -29,6 +29,10 @@ struct SYNCSPIRIT_API file_cache_t : model::arc_base_t<file_cache_t>, private mo
     using parent_t::remove;
 
     file_ptr_t get(const bfs::path &path) noexcept;
+    void remove(const bfs::path &path) noexcept;
+
+    /* removes the path itself and everything beneath it */
+    void remove_all(const bfs::path &path) noexcept;
 };
 
 using file_cache_ptr_t = model::intrusive_ptr_t<file_cache_t>;
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "syncspirit-config.h"
+#include "file_handle.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <utility>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+#include <windows.h>
+#define SS_WINDOWS_HANDLE 1
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+using namespace syncspirit::fs;
+
+#ifdef SS_WINDOWS_HANDLE
+static const native_handle_t invalid_handle = INVALID_HANDLE_VALUE;
+
+static sys::error_code last_error() noexcept {
+    return sys::error_code(static_cast<int>(::GetLastError()), sys::system_category());
+}
+
+static OVERLAPPED make_overlapped(std::uint64_t offset) noexcept {
+    auto overlapped = OVERLAPPED{};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    return overlapped;
+}
+
+// ReadFile/WriteFile are limited to DWORD
+static constexpr std::size_t max_io = 1 << 30;
+#else
+static constexpr native_handle_t invalid_handle = -1;
+
+static sys::error_code last_error() noexcept { return sys::error_code(errno, sys::system_category()); }
+#endif
+
+file_handle_t::file_handle_t() noexcept : handle{invalid_handle} {}
+
+file_handle_t::file_handle_t(file_handle_t &&other) noexcept : handle{invalid_handle} {
+    std::swap(handle, other.handle);
+}
+
+file_handle_t::~file_handle_t() { close(); }
+
+file_handle_t &file_handle_t::operator=(file_handle_t &&other) noexcept {
+    std::swap(handle, other.handle);
+    return *this;
+}
+
+file_handle_t::operator bool() const noexcept { return handle != invalid_handle; }
+
+native_handle_t file_handle_t::native() const noexcept { return handle; }
+
+auto file_handle_t::open(const bfs::path &path, mode_t mode) noexcept -> outcome::result<file_handle_t> {
+    auto file = file_handle_t();
+#ifdef SS_WINDOWS_HANDLE
+    auto access = DWORD{GENERIC_READ};
+    auto disposition = DWORD{OPEN_EXISTING};
+    if (mode == mode_t::read_write) {
+        access |= GENERIC_WRITE;
+        disposition = OPEN_ALWAYS;
+    }
+    auto share = DWORD{FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE};
+    file.handle = ::CreateFileW(path.c_str(), access, share, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+    auto flags = O_CLOEXEC | (mode == mode_t::read_write ? O_RDWR | O_CREAT : O_RDONLY);
+    do {
+        file.handle = ::open(path.c_str(), flags, 0666);
+    } while (file.handle == invalid_handle && errno == EINTR);
+#endif
+    if (!file) {
+        return last_error();
+    }
+    return std::move(file);
+}
+
+sys::error_code file_handle_t::close() noexcept {
+    if (handle == invalid_handle) {
+        return {};
+    }
+    auto h = std::exchange(handle, invalid_handle);
+#ifdef SS_WINDOWS_HANDLE
+    if (!::CloseHandle(h)) {
+        return last_error();
+    }
+#else
+    if (::close(h) == -1) {
+        return last_error();
+    }
+#endif
+    return {};
+}
+
+sys::error_code file_handle_t::read(std::uint64_t offset, std::span<unsigned char> buffer) const noexcept {
+    return read_at(handle, offset, buffer);
+}
+
+sys::error_code file_handle_t::write(std::uint64_t offset, utils::bytes_view_t data) noexcept {
+    return write_at(handle, offset, data);
+}
+
+sys::error_code file_handle_t::allocate(std::uint64_t size) noexcept {
+    if (!size) {
+        return {};
+    }
+#if defined(SS_WINDOWS_HANDLE)
+    auto info = FILE_ALLOCATION_INFO{};
+    info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+    if (!::SetFileInformationByHandle(handle, FileAllocationInfo, &info, sizeof(info))) {
+        return last_error();
+    }
+    return {};
+#elif defined(SYNCSPIRIT_FALLOCATE)
+    while (::fallocate(handle, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) == -1) {
+        if (errno != EINTR) {
+            if (errno == EOPNOTSUPP) {
+                return sys::errc::make_error_code(sys::errc::operation_not_supported);
+            }
+            return last_error();
+        }
+    }
+    return {};
+#elif defined(SYNCSPIRIT_F_PREALLOCATE)
+    auto store = fstore_t{F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0};
+    if (::fcntl(handle, F_PREALLOCATE, &store) == -1) {
+        // contiguous space is not available, try fragmented one
+        store.fst_flags = F_ALLOCATEALL;
+        if (::fcntl(handle, F_PREALLOCATE, &store) == -1) {
+            return last_error();
+        }
+    }
+    return {};
+#else
+    return sys::errc::make_error_code(sys::errc::operation_not_supported);
+#endif
+}
+
+sys::error_code file_handle_t::sync() noexcept {
+#ifdef SS_WINDOWS_HANDLE
+    if (!::FlushFileBuffers(handle)) {
+        return last_error();
+    }
+#else
+#ifdef SYNCSPIRIT_FDATASYNC
+    auto r = ::fdatasync(handle);
+#else
+    auto r = ::fsync(handle);
+#endif
+    if (r == -1) {
+        return last_error();
+    }
+#endif
+    return {};
+}
+
+sys::error_code file_handle_t::read_at(native_handle_t handle, std::uint64_t offset,
+                                       std::span<unsigned char> buffer) noexcept {
+    auto ptr = buffer.data();
+    auto left = buffer.size();
+    while (left) {
+#ifdef SS_WINDOWS_HANDLE
+        auto overlapped = make_overlapped(offset);
+        auto sz = static_cast<DWORD>(std::min(left, max_io));
+        auto r = DWORD{0};
+        if (!::ReadFile(handle, ptr, sz, &r, &overlapped)) {
+            if (::GetLastError() == ERROR_HANDLE_EOF) {
+                return sys::errc::make_error_code(sys::errc::io_error);
+            }
+            return last_error();
+        }
+#else
+        auto r = ::pread(handle, ptr, left, static_cast<off_t>(offset));
+        if (r == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return last_error();
+        }
+#endif
+        if (r == 0) {
+            // unexpected end of file
+            return sys::errc::make_error_code(sys::errc::io_error);
+        }
+        auto sz = static_cast<std::size_t>(r);
+        ptr += sz;
+        left -= sz;
+        offset += sz;
+    }
+    return {};
+}
+
+sys::error_code file_handle_t::write_at(native_handle_t handle, std::uint64_t offset,
+                                        utils::bytes_view_t data) noexcept {
+    auto ptr = data.data();
+    auto left = data.size();
+    while (left) {
+#ifdef SS_WINDOWS_HANDLE
+        auto overlapped = make_overlapped(offset);
+        auto sz = static_cast<DWORD>(std::min(left, max_io));
+        auto r = DWORD{0};
+        if (!::WriteFile(handle, ptr, sz, &r, &overlapped)) {
+            return last_error();
+        }
+#else
+        auto r = ::pwrite(handle, ptr, left, static_cast<off_t>(offset));
+        if (r == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return last_error();
+        }
+#endif
+        if (r == 0) {
+            return sys::errc::make_error_code(sys::errc::io_error);
+        }
+        auto sz = static_cast<std::size_t>(r);
+        ptr += sz;
+        left -= sz;
+        offset += sz;
+    }
+    return {};
+}
+
+sys::error_code file_handle_t::write(std::uint64_t offset, std::span<const utils::bytes_view_t> chunks) noexcept {
+#ifdef SYNCSPIRIT_PWRITEV
+    static constexpr std::size_t max_chunks = 64;
+    auto vectors = std::array<iovec, max_chunks>();
+    while (!chunks.empty()) {
+        auto count = std::min(chunks.size(), max_chunks);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto &chunk = chunks[i];
+            vectors[i] = iovec{const_cast<unsigned char *>(chunk.data()), chunk.size()};
+        }
+        auto it = vectors.data();
+        auto end = it + count;
+        while (it != end) {
+            auto r = ::pwritev(handle, it, static_cast<int>(end - it), static_cast<off_t>(offset));
+            if (r == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return last_error();
+            }
+            auto written = static_cast<std::size_t>(r);
+            offset += written;
+            while (it != end && written >= it->iov_len) {
+                written -= it->iov_len;
+                ++it;
+            }
+            if (it != end) {
+                if (!r) {
+                    return sys::errc::make_error_code(sys::errc::io_error);
+                }
+                it->iov_base = reinterpret_cast<unsigned char *>(it->iov_base) + written;
+                it->iov_len -= written;
+            }
+        }
+        chunks = chunks.subspan(count);
+    }
+#else
+    for (auto &chunk : chunks) {
+        if (auto ec = write(offset, chunk); ec) {
+            return ec;
+        }
+        offset += chunk.size();
+    }
+#endif
+    return {};
+}
+
+std::uint64_t file_handle_t::device_of(native_handle_t handle) noexcept {
+#ifdef SS_WINDOWS_HANDLE
+    auto info = BY_HANDLE_FILE_INFORMATION{};
+    if (::GetFileInformationByHandle(handle, &info)) {
+        return static_cast<std::uint64_t>(info.dwVolumeSerialNumber);
+    }
+#else
+    struct stat stat_info;
+    if (::fstat(handle, &stat_info) == 0) {
+        return static_cast<std::uint64_t>(stat_info.st_dev);
+    }
+#endif
+    return 0;
+}
+
+#ifndef SS_WINDOWS_HANDLE
+auto file_handle_t::open_dir(const bfs::path &path) noexcept -> outcome::result<file_handle_t> {
+    auto dir = file_handle_t();
+    do {
+        dir.handle = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    } while (dir.handle == invalid_handle && errno == EINTR);
+    if (!dir) {
+        return last_error();
+    }
+    return std::move(dir);
+}
+#endif
+
+sys::error_code file_handle_t::sync_fs(const bfs::path &dir) noexcept {
+#ifdef SYNCSPIRIT_SYNCFS
+    auto handle = open_dir(dir);
+    if (!handle) {
+        return handle.assume_error();
+    }
+    if (::syncfs(handle.assume_value().native()) == -1) {
+        return last_error();
+    }
+    return {};
+#else
+    (void)dir;
+    return sys::errc::make_error_code(sys::errc::operation_not_supported);
+#endif
+}
+
+sys::error_code file_handle_t::sync_dir(const bfs::path &path) noexcept {
+#ifdef SS_WINDOWS_HANDLE
+    // NTFS journals the directory entries itself, there is nothing to flush
+    (void)path;
+    return {};
+#else
+    auto handle = open_dir(path);
+    if (!handle) {
+        return handle.assume_error();
+    }
+    auto &dir = handle.assume_value();
+    if (::fsync(dir.native()) == -1) {
+        return last_error();
+    }
+    return dir.close();
+#endif
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "utils/bytes.h"
+#include "syncspirit-export.h"
+#include <boost/outcome.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace syncspirit::fs {
+
+namespace bfs = std::filesystem;
+namespace sys = boost::system;
+namespace outcome = boost::outcome_v2;
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+using native_handle_t = void *;
+#else
+using native_handle_t = int;
+#endif
+
+/* owning wrapper around the OS file descriptor (HANDLE on windows) with positional,
+   i.e. seek-less and unbuffered, I/O */
+struct SYNCSPIRIT_API file_handle_t {
+    enum class mode_t { read, read_write };
+
+    file_handle_t() noexcept;
+    file_handle_t(const file_handle_t &) = delete;
+    file_handle_t(file_handle_t &&) noexcept;
+    ~file_handle_t();
+
+    file_handle_t &operator=(file_handle_t &&) noexcept;
+    explicit operator bool() const noexcept;
+
+    /* read_write creates the file, if it does not exist */
+    static outcome::result<file_handle_t> open(const bfs::path &path, mode_t mode) noexcept;
+
+    native_handle_t native() const noexcept;
+    sys::error_code close() noexcept;
+
+    /* fills the whole buffer, it is an error to hit the end of file */
+    sys::error_code read(std::uint64_t offset, std::span<unsigned char> buffer) const noexcept;
+
+    /* chunks are written back to back (gathered into a single syscall, when possible) */
+    sys::error_code write(std::uint64_t offset, std::span<const utils::bytes_view_t> chunks) noexcept;
+    sys::error_code write(std::uint64_t offset, utils::bytes_view_t data) noexcept;
+
+    /* reserves the disk space up to size without changing the file size; returns
+       operation_not_supported if the platform (or the filesystem) cannot do that */
+    sys::error_code allocate(std::uint64_t size) noexcept;
+
+    /* flushes the file data (and the metadata needed to read it back) to the device */
+    sys::error_code sync() noexcept;
+
+    /* the same as above, for non-owned handles */
+    static sys::error_code read_at(native_handle_t handle, std::uint64_t offset,
+                                   std::span<unsigned char> buffer) noexcept;
+    static sys::error_code write_at(native_handle_t handle, std::uint64_t offset, utils::bytes_view_t data) noexcept;
+
+    /* identifies the physical device (or volume) the file resides on, 0 if unknown */
+    static std::uint64_t device_of(native_handle_t handle) noexcept;
+
+    /* flushes all dirty data of the filesystem the directory belongs to; returns
+       operation_not_supported if there is no such facility */
+    static sys::error_code sync_fs(const bfs::path &dir) noexcept;
+
+    /* makes the directory entries (i.e. created or renamed files) durable */
+    static sys::error_code sync_dir(const bfs::path &path) noexcept;
+
+  private:
+    static outcome::result<file_handle_t> open_dir(const bfs::path &path) noexcept;
+
+    native_handle_t handle;
+};
+
+} // namespace syncspirit::fs
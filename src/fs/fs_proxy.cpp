@@ -3,6 +3,7 @@
 
 #include "syncspirit-config.h"
 #include "fs_proxy.h"
+#include "file_cache.h"
 #include "updates_mediator.h"
 #include "utils.h"
 #include <boost/nowide/convert.hpp>
@@ -14,8 +15,59 @@
 #include <unistd.h>
 #endif
 
+#if defined(SYNCSPIRIT_COPY_FILE_RANGE) || defined(SYNCSPIRIT_FICLONERANGE)
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#define SYNCSPIRIT_KERNEL_COPY 1
+#endif
+
+#ifdef SYNCSPIRIT_PUNCH_HOLE
+#include <fcntl.h>
+#endif
+
 using namespace syncspirit::fs;
 
+#ifdef SYNCSPIRIT_KERNEL_COPY
+static sys::error_code kernel_copy(int target_fd, off_t target_offset, int source_fd, off_t source_offset,
+                                   std::uint64_t size) noexcept {
+#ifdef SYNCSPIRIT_FICLONERANGE
+    struct stat stat_info;
+    if (::fstat(target_fd, &stat_info) == 0 && stat_info.st_blksize > 0) {
+        auto align = static_cast<std::uint64_t>(stat_info.st_blksize);
+        auto aligned = !(target_offset % align) && !(source_offset % align) && !(size % align);
+        if (aligned) {
+            auto range = file_clone_range{};
+            range.src_fd = source_fd;
+            range.src_offset = static_cast<std::uint64_t>(source_offset);
+            range.src_length = size;
+            range.dest_offset = static_cast<std::uint64_t>(target_offset);
+            if (::ioctl(target_fd, FICLONERANGE, &range) == 0) {
+                return {};
+            }
+        }
+    }
+#endif
+#ifdef SYNCSPIRIT_COPY_FILE_RANGE
+    while (size) {
+        auto r = ::copy_file_range(source_fd, &source_offset, target_fd, &target_offset, size, 0);
+        if (r == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return sys::error_code{errno, sys::system_category()};
+        } else if (r == 0) {
+            return sys::errc::make_error_code(sys::errc::io_error);
+        }
+        size -= static_cast<std::uint64_t>(r);
+    }
+    return {};
+#else
+    return sys::errc::make_error_code(sys::errc::operation_not_supported);
+#endif
+}
+#endif
+
 fs_proxy_t::fs_proxy_t(updates_mediator_t &updates_mediator_, const pt::ptime &deadline_) noexcept
     : updates_mediator{updates_mediator_}, deadline{deadline_} {}
 
@@ -27,34 +79,36 @@ fs_proxy_t::fs_proxy_t(updates_mediator_t &updates_mediator_, const pt::ptime &d
 #define SS_STAT_BUFF struct stat
 #endif
 
-auto fs_proxy_t::open_write(const bfs::path &path, std::uint64_t file_size) noexcept
-    -> outcome::result<utils::fstream_t> {
-    using mode_t = utils::fstream_t;
+void fs_proxy_t::forget(const bfs::path &path) noexcept {
+    if (ro_cache) {
+        ro_cache->remove(path);
+    }
+}
 
+auto fs_proxy_t::open_write(const bfs::path &path, std::uint64_t file_size, bool preallocate) noexcept
+    -> outcome::result<file_handle_t> {
     bool need_resize = true;
+    forget(path);
 
     SS_STAT_BUFF stat_info;
     auto r = SS_STAT_FN(path, &stat_info);
     if (r == 0) {
         need_resize = static_cast<uint64_t>(stat_info.st_size) == file_size;
     }
-    auto mode = mode_t::in | mode_t::out | mode_t::binary;
-    if (need_resize) {
-        if (r == -1) {
-            auto file = utils::fstream_t(path, mode | mode_t::trunc);
-            if (!file) {
-                return sys::error_code{errno, sys::system_category()};
-            } else {
+
+    auto file = file_handle_t::open(path, file_handle_t::mode_t::read_write);
+    if (!file) {
+        return file.assume_error();
+    }
+    if (r == -1) {
 #ifndef SYNCSPIRIT_WATCHER_KQUEUE
-                updates_mediator.mask(path, {}, deadline);
+        updates_mediator.mask(path, {}, deadline);
 #else
-                updates_mediator.mask(path.parent_path(), {}, deadline);
+        updates_mediator.mask(path.parent_path(), {}, deadline);
 #endif
-                ++mediator_updates;
-            }
-
-            mode = mode & ~mode_t::trunc;
-        }
+        ++mediator_updates;
+    }
+    if (need_resize) {
         auto ec = std::error_code();
         bfs::resize_file(path, file_size, ec);
         if (ec) {
@@ -63,17 +117,22 @@ auto fs_proxy_t::open_write(const bfs::path &path, std::uint64_t file_size) noex
             updates_mediator.mask(path, {}, deadline);
             ++mediator_updates;
         }
+        if (preallocate) {
+            // not all filesystems are able to do that, it is just a hint
+            auto alloc_ec = file.assume_value().allocate(file_size);
+            (void)alloc_ec;
+        }
     }
-
-    auto file = utils::fstream_t(path, mode);
-    if (!file) {
-        return sys::error_code{errno, sys::system_category()};
-    }
-    return std::move(file);
+    return file;
 }
 
 sys::error_code fs_proxy_t::rename(const bfs::path &from, const bfs::path &to) noexcept {
     auto ec = sys::error_code();
+    if (ro_cache) {
+        // directories might be renamed too
+        ro_cache->remove_all(from);
+        ro_cache->remove_all(to);
+    }
     bfs::rename(from, to, ec);
     if (!ec) {
         updates_mediator.mask(to, from, deadline);
@@ -99,6 +158,9 @@ sys::error_code fs_proxy_t::last_write_time(const bfs::path &path, std::int64_t
 
 sys::error_code fs_proxy_t::remove(const bfs::path &path) noexcept {
     sys::error_code ec;
+    if (ro_cache) {
+        ro_cache->remove_all(path);
+    }
     bfs::remove_all(path, ec);
     if (!ec) {
 #ifndef SYNCSPIRIT_WATCHER_KQUEUE
@@ -113,6 +175,7 @@ sys::error_code fs_proxy_t::remove(const bfs::path &path) noexcept {
 
 sys::error_code fs_proxy_t::remove_file(const bfs::path &path) noexcept {
     sys::error_code ec;
+    forget(path);
     bfs::remove(path, ec);
     if (!ec) {
 #ifndef SYNCSPIRIT_WATCHER_KQUEUE
@@ -125,14 +188,15 @@ sys::error_code fs_proxy_t::remove_file(const bfs::path &path) noexcept {
     return ec;
 }
 
-sys::error_code fs_proxy_t::write(const bfs::path &path, utils::fstream_t &stream, utils::bytes_view_t data) noexcept {
-    auto ptr = reinterpret_cast<const char *>(data.data());
-    if (!stream.write(ptr, data.size())) {
-        return sys::errc::make_error_code(sys::errc::io_error);
-    }
-    updates_mediator.mask(path, {}, deadline);
-    if (!stream.flush()) {
-        return sys::errc::make_error_code(sys::errc::io_error);
+sys::error_code fs_proxy_t::write(const bfs::path &path, file_handle_t &handle, std::uint64_t offset,
+                                  utils::bytes_view_t data) noexcept {
+    return write(path, handle, offset, std::span<const utils::bytes_view_t>(&data, 1));
+}
+
+sys::error_code fs_proxy_t::write(const bfs::path &path, file_handle_t &handle, std::uint64_t offset,
+                                  std::span<const utils::bytes_view_t> chunks) noexcept {
+    if (auto ec = handle.write(offset, chunks); ec) {
+        return ec;
     }
     updates_mediator.mask(path, {}, deadline);
     return {};
@@ -172,3 +236,52 @@ sys::error_code fs_proxy_t::create_directories(const bfs::path &path) noexcept {
     }
     return ec;
 }
+
+sys::error_code fs_proxy_t::copy_range(const bfs::path &target, std::uint64_t target_offset, const bfs::path &source,
+                                       std::uint64_t source_offset, std::uint64_t size) noexcept {
+#ifdef SYNCSPIRIT_KERNEL_COPY
+    auto source_fd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source_fd == -1) {
+        return sys::error_code{errno, sys::system_category()};
+    }
+    auto target_fd = ::open(target.c_str(), O_WRONLY | O_CLOEXEC);
+    if (target_fd == -1) {
+        auto ec = sys::error_code{errno, sys::system_category()};
+        ::close(source_fd);
+        return ec;
+    }
+    auto ec = kernel_copy(target_fd, static_cast<off_t>(target_offset), source_fd, static_cast<off_t>(source_offset),
+                          size);
+    ::close(target_fd);
+    ::close(source_fd);
+    if (!ec) {
+        updates_mediator.mask(target, {}, deadline);
+        ++mediator_updates;
+    }
+    return ec;
+#else
+    return sys::errc::make_error_code(sys::errc::operation_not_supported);
+#endif
+}
+
+sys::error_code fs_proxy_t::punch_hole(const bfs::path &path, std::uint64_t offset, std::uint64_t size) noexcept {
+#ifdef SYNCSPIRIT_PUNCH_HOLE
+    auto fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return sys::error_code{errno, sys::system_category()};
+    }
+    auto ec = sys::error_code();
+    auto mode = FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE;
+    if (::fallocate(fd, mode, static_cast<off_t>(offset), static_cast<off_t>(size)) == -1) {
+        ec = sys::error_code{errno, sys::system_category()};
+    }
+    ::close(fd);
+    if (!ec) {
+        updates_mediator.mask(path, {}, deadline);
+        ++mediator_updates;
+    }
+    return ec;
+#else
+    return sys::errc::make_error_code(sys::errc::operation_not_supported);
+#endif
+}
@@ -4,7 +4,7 @@
 #pragma once
 
 #include "updates_mediator.h"
-#include "utils/io.h"
+#include "file_handle.h"
 #include "utils/bytes.h"
 #include "syncspirit-export.h"
 #include <boost/filesystem.hpp>
@@ -19,10 +19,13 @@ namespace sys = boost::system;
 namespace outcome = boost::outcome_v2;
 namespace pt = boost::posix_time;
 
+struct file_cache_t;
+
 struct SYNCSPIRIT_API fs_proxy_t {
     fs_proxy_t(updates_mediator_t &updates_mediator, const pt::ptime &deadline) noexcept;
 
-    outcome::result<utils::fstream_t> open_write(const bfs::path &path, std::uint64_t file_size) noexcept;
+    outcome::result<file_handle_t> open_write(const bfs::path &path, std::uint64_t file_size,
+                                              bool preallocate = false) noexcept;
     sys::error_code rename(const bfs::path &from, const bfs::path &to) noexcept;
     sys::error_code remove(const bfs::path &path) noexcept;
     sys::error_code remove_file(const bfs::path &path) noexcept;
@@ -30,11 +33,29 @@ struct SYNCSPIRIT_API fs_proxy_t {
     sys::error_code set_perms(const bfs::path &path, std::uint32_t permissions) noexcept;
     sys::error_code create_link(const bfs::path &target, const bfs::path &path) noexcept;
     sys::error_code create_directories(const bfs::path &path) noexcept;
-    sys::error_code write(const bfs::path &path, utils::fstream_t &stream, utils::bytes_view_t data) noexcept;
+    sys::error_code write(const bfs::path &path, file_handle_t &handle, std::uint64_t offset,
+                          utils::bytes_view_t data) noexcept;
+    sys::error_code write(const bfs::path &path, file_handle_t &handle, std::uint64_t offset,
+                          std::span<const utils::bytes_view_t> chunks) noexcept;
+
+    /* in-kernel copy of the range (reflink or copy_file_range), returns operation_not_supported
+       if the platform has none of them */
+    sys::error_code copy_range(const bfs::path &target, std::uint64_t target_offset, const bfs::path &source,
+                               std::uint64_t source_offset, std::uint64_t size) noexcept;
+
+    /* deallocates the range, so it reads back as zeroes without occupying the disk space; returns
+       operation_not_supported if the platform (or the underlying filesystem) cannot do that */
+    sys::error_code punch_hole(const bfs::path &path, std::uint64_t offset, std::uint64_t size) noexcept;
 
     pt::ptime deadline;
     updates_mediator_t &updates_mediator;
     std::uint_fast32_t mediator_updates = 0;
+
+    /* cached read-only files, which become stale after local modifications */
+    file_cache_t *ro_cache = nullptr;
+
+  private:
+    void forget(const bfs::path &path) noexcept;
 };
 
 } // namespace syncspirit::fs
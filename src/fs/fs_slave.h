@@ -19,6 +19,7 @@ struct SYNCSPIRIT_API fs_slave_t : payload::foreign_executor_t {
 
     tasks_t tasks_in;
     tasks_t tasks_out;
+    std::string folder_id; // the tasks belong to, used for I/O stats
     sys::error_code ec;
 };
 
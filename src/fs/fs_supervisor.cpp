@@ -9,6 +9,7 @@
 #include "fs_supervisor.h"
 #include "file_actor.h"
 #include "fs_context.h"
+#include "io_pool.h"
 #include "updates_mediator.h"
 #include "watched_folders.h"
 #include "watcher_actor.h"
@@ -39,9 +40,34 @@ void fs_supervisor_t::enqueue(r::message_ptr_t message) noexcept {
 void fs_supervisor_t::on_start() noexcept {
     LOG_TRACE(log, "on_start");
     parent_t::on_start();
+    auto ctx = static_cast<fs_context_t *>(context);
+    if (!ctx->io_engine && fs_config.io_threads > 1) {
+        io_pool.reset(new io_pool_t(fs_config.io_threads));
+        ctx->io_engine = io_pool.get();
+        ctx->io_events = true;
+    }
+    if (fs_config.scan_threads > 1) {
+        scan_pool.reset(new scan_pool_t(fs_config.scan_threads));
+        ctx->scan_pool = scan_pool.get();
+    }
     launch_children();
 }
 
+void fs_supervisor_t::shutdown_finish() noexcept {
+    LOG_TRACE(log, "shutdown_finish");
+    if (io_pool) {
+        auto ctx = static_cast<fs_context_t *>(context);
+        ctx->io_engine = nullptr;
+        ctx->io_events = false;
+        io_pool.reset();
+    }
+    if (scan_pool) {
+        static_cast<fs_context_t *>(context)->scan_pool = nullptr;
+        scan_pool.reset();
+    }
+    parent_t::shutdown_finish();
+}
+
 void fs_supervisor_t::launch_children() noexcept {
     auto retension = pt::milliseconds{fs_config.retension_timeout};
     auto retension_x2 = retension * 2;
@@ -50,6 +76,7 @@ void fs_supervisor_t::launch_children() noexcept {
 
     updates_mediator.reset(new updates_mediator_t(retension_x2));
     watched_folders.reset(new watched_folders_t());
+    auto ro_cache = file_cache_ptr_t(new file_cache_t(fs_config.ro_cache_size));
 
     auto timeout = shutdown_timeout * 9 / 10;
     auto watcher = create_actor<watch_actor_t>()
@@ -57,6 +84,7 @@ void fs_supervisor_t::launch_children() noexcept {
                        .change_retension(retension)
                        .updates_mediator(updates_mediator)
                        .watched_folders(watched_folders)
+                       .ro_cache(ro_cache)
                        .fs_config(fs_config)
                        .finish()
                        .get();
@@ -64,9 +92,13 @@ void fs_supervisor_t::launch_children() noexcept {
     auto notify_watcher = [watcher](const fs::task::scan_dir_t &scan_dir) { watcher->notify(scan_dir); };
     create_actor<file_actor_t>()
         .concurrent_hashes(hasher_threads)
+        .write_buffer(fs_config.write_buffer)
+        .durable(fs_config.durable)
+        .stats_interval(pt::milliseconds{fs_config.stats_interval})
         .change_retension(retension_x2)
         .updates_mediator(updates_mediator)
         .watched_folders(watched_folders)
+        .ro_cache(ro_cache)
         .scan_dir_callback(notify_watcher)
         .timeout(timeout)
         .escalate_failure()
@@ -4,9 +4,12 @@
 #pragma once
 
 #include "config/fs.h"
+#include "io_engine.h"
+#include "scan_pool.h"
 #include "syncspirit-export.h"
 #include "utils/log.h"
 #include <rotor/thread.hpp>
+#include <memory>
 
 namespace syncspirit {
 namespace fs {
@@ -43,6 +46,7 @@ struct SYNCSPIRIT_API fs_supervisor_t : rth::supervisor_thread_t {
     void configure(r::plugin::plugin_base_t &plugin) noexcept override;
     void enqueue(r::message_ptr_t message) noexcept override;
     void on_start() noexcept override;
+    void shutdown_finish() noexcept override;
     void on_child_shutdown(actor_base_t *actor) noexcept override;
     using parent_t::context;
 
@@ -52,6 +56,8 @@ struct SYNCSPIRIT_API fs_supervisor_t : rth::supervisor_thread_t {
     utils::logger_t log;
     config::fs_config_t fs_config;
     uint32_t hasher_threads;
+    std::unique_ptr<io_engine_t> io_pool;
+    std::unique_ptr<scan_pool_t> scan_pool;
 };
 
 } // namespace fs
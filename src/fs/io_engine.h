@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "file_handle.h"
+#include "syncspirit-export.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace syncspirit::fs {
+
+/* positional read or write of a single block; it is owned by the caller and should
+   stay alive until it is finished, i.e. until io_engine_t::complete() returns or
+   until poll() marks it as finished */
+struct io_request_t {
+    native_handle_t fd;
+    bool write;
+    std::uint64_t offset;
+    unsigned char *data;
+    std::uint32_t size;
+    std::uint32_t done = 0;
+    int error = 0;
+    bool finished = false;
+};
+
+/* asynchronous block I/O: requests are queued and then completed all together, so
+   the kernel has the whole batch in flight at once. If the engine has a listener,
+   the requests can be finished in background: the listener is notified when some of
+   them are finished, and then poll() marks them */
+struct SYNCSPIRIT_API io_engine_t {
+    using listener_t = std::function<void()>;
+
+    virtual ~io_engine_t() = default;
+
+    /* returns false if there is no room for the request, i.e. the previous requests
+       should be finished first */
+    virtual bool submit(io_request_t &request) noexcept = 0;
+
+    /* starts the queued requests and marks the finished ones, without waiting */
+    virtual void poll() noexcept = 0;
+
+    /* waits until all submitted requests are done (or failed) */
+    virtual void complete() noexcept = 0;
+
+    /* the listener might be invoked from another thread */
+    virtual void set_listener(listener_t listener_) noexcept { listener = std::move(listener_); }
+
+  protected:
+    /* invokes the listener once, until the next poll() */
+    void notify() noexcept {
+        if (listener && !notified.exchange(true, std::memory_order_acq_rel)) {
+            listener();
+        }
+    }
+
+    listener_t listener;
+    std::atomic_bool notified = false;
+};
+
+} // namespace syncspirit::fs
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "io_pool.h"
+#include "utils/platform.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <thread>
+
+using namespace syncspirit::fs;
+
+struct io_pool_t::worker_t {
+    using requests_t = std::vector<io_request_t *>;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    requests_t requests;
+    bool stop = false;
+};
+
+io_pool_t::io_pool_t(std::uint32_t threads) noexcept {
+    log = utils::get_logger("fs.io_pool");
+    for (std::uint32_t i = 0; i < std::max(threads, 1u); ++i) {
+        auto &worker = workers.emplace_back(new worker_t());
+        worker->thread = std::thread([this, i, w = worker.get()]() {
+            auto name = fmt::format("ss/fs-io-{}", i + 1);
+            utils::platform_t::set_thread_name(name);
+            run(*w);
+        });
+    }
+    LOG_DEBUG(log, "started {} I/O threads", workers.size());
+}
+
+io_pool_t::~io_pool_t() {
+    complete();
+    for (auto &worker : workers) {
+        {
+            auto lock = std::unique_lock(worker->mutex);
+            worker->stop = true;
+        }
+        worker->cv.notify_one();
+        worker->thread.join();
+    }
+}
+
+auto io_pool_t::pick(native_handle_t fd) noexcept -> worker_t & {
+    auto device = file_handle_t::device_of(fd);
+    auto it = devices.find(device);
+    if (it == devices.end()) {
+        auto index = devices.size() % workers.size();
+        it = devices.emplace(device, workers[index].get()).first;
+        LOG_TRACE(log, "device {} is served by I/O thread #{}", device, index + 1);
+    }
+    return *it->second;
+}
+
+bool io_pool_t::submit(io_request_t &request) noexcept {
+    auto &worker = pick(request.fd);
+    {
+        auto lock = std::unique_lock(mutex);
+        ++outstanding;
+    }
+    {
+        auto lock = std::unique_lock(worker.mutex);
+        worker.requests.emplace_back(&request);
+    }
+    worker.cv.notify_one();
+    return true;
+}
+
+void io_pool_t::poll() noexcept {
+    notified.store(false, std::memory_order_release);
+    auto lock = std::unique_lock(mutex);
+    for (auto request : finished) {
+        request->finished = true;
+    }
+    finished.clear();
+}
+
+void io_pool_t::complete() noexcept {
+    {
+        auto lock = std::unique_lock(mutex);
+        done.wait(lock, [&]() { return outstanding == 0; });
+    }
+    poll();
+}
+
+void io_pool_t::set_listener(listener_t listener_) noexcept {
+    auto lock = std::unique_lock(mutex);
+    listener = std::move(listener_);
+}
+
+void io_pool_t::run(worker_t &worker) noexcept {
+    auto batch = worker_t::requests_t();
+    auto lock = std::unique_lock(worker.mutex);
+    while (true) {
+        worker.cv.wait(lock, [&]() { return worker.stop || !worker.requests.empty(); });
+        if (worker.requests.empty()) {
+            return;
+        }
+        std::swap(batch, worker.requests);
+        lock.unlock();
+
+        for (auto request : batch) {
+            auto data = request->data + request->done;
+            auto size = static_cast<std::size_t>(request->size - request->done);
+            auto ec = request->write
+                          ? file_handle_t::write_at(request->fd, request->offset + request->done, {data, size})
+                          : file_handle_t::read_at(request->fd, request->offset + request->done, {data, size});
+            if (ec) {
+                request->error = ec.value();
+            } else {
+                request->done = request->size;
+            }
+        }
+        {
+            auto guard = std::unique_lock(mutex);
+            finished.insert(finished.end(), batch.begin(), batch.end());
+            outstanding -= batch.size();
+            if (!outstanding) {
+                done.notify_all();
+            }
+            notify();
+        }
+        batch.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "io_engine.h"
+#include "utils/log.h"
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace syncspirit::fs {
+
+/* portable io_engine_t: requests are executed by a pool of worker threads with
+   blocking positional I/O. Each device (st_dev / volume) is served by the single
+   worker, so that different disks are accessed in parallel, while requests to the
+   same file are still executed in the submission order. The listener is notified
+   by the workers, when they finish their requests */
+struct SYNCSPIRIT_API io_pool_t final : io_engine_t {
+    io_pool_t(std::uint32_t threads) noexcept;
+    io_pool_t(const io_pool_t &) = delete;
+    ~io_pool_t();
+
+    bool submit(io_request_t &request) noexcept override;
+    void poll() noexcept override;
+    void complete() noexcept override;
+    void set_listener(listener_t listener) noexcept override;
+
+  private:
+    struct worker_t;
+    using worker_ptr_t = std::unique_ptr<worker_t>;
+    using workers_t = std::vector<worker_ptr_t>;
+    using devices_t = std::unordered_map<std::uint64_t, worker_t *>;
+    using requests_t = std::vector<io_request_t *>;
+
+    void run(worker_t &worker) noexcept;
+    worker_t &pick(native_handle_t fd) noexcept;
+
+    workers_t workers;
+    devices_t devices;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t outstanding = 0;
+    requests_t finished; // by workers, but not yet marked as such
+    utils::logger_t log;
+};
+
+} // namespace syncspirit::fs
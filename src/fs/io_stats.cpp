@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "io_stats.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace syncspirit::fs;
+
+std::uint64_t io_stats_t::counter_t::percentile(double share) const noexcept {
+    if (!count) {
+        return 0;
+    }
+    auto threshold = static_cast<std::uint64_t>(std::ceil(share * static_cast<double>(count)));
+    threshold = std::clamp(threshold, std::uint64_t{1}, count);
+    auto accumulated = std::uint64_t{0};
+    auto bound = std::uint64_t{2};
+    for (std::size_t i = 0; i + 1 < buckets_count; ++i) {
+        accumulated += histogram[i];
+        if (accumulated >= threshold) {
+            return std::min(bound, max_us);
+        }
+        bound <<= 1;
+    }
+    // the last bucket is unbounded
+    return max_us;
+}
+
+void io_stats_t::counter_t::merge(const counter_t &other) noexcept {
+    count += other.count;
+    bytes += other.bytes;
+    total_us += other.total_us;
+    max_us = std::max(max_us, other.max_us);
+    for (std::size_t i = 0; i < buckets_count; ++i) {
+        histogram[i] += other.histogram[i];
+    }
+}
+
+std::string_view io_stats_t::get_name(op_t op) noexcept {
+    switch (op) {
+    case op_t::open:
+        return "open";
+    case op_t::read:
+        return "read";
+    case op_t::write:
+        return "write";
+    case op_t::rename:
+        return "rename";
+    case op_t::sync:
+        return "sync";
+    default:
+        return "unknown";
+    }
+}
+
+void io_stats_t::record(op_t op, std::uint64_t bytes, time_point_t started) noexcept {
+    using namespace std::chrono;
+    auto latency = duration_cast<microseconds>(now() - started).count();
+    record(op, bytes, static_cast<std::uint64_t>(std::max(latency, decltype(latency){0})));
+}
+
+void io_stats_t::record(op_t op, std::uint64_t bytes, std::uint64_t latency_us) noexcept {
+    auto &c = counters[static_cast<std::size_t>(op)];
+    auto width = static_cast<std::size_t>(std::bit_width(latency_us));
+    auto bucket = std::min(width ? width - 1 : 0, buckets_count - 1);
+    ++c.count;
+    c.bytes += bytes;
+    c.total_us += latency_us;
+    c.max_us = std::max(c.max_us, latency_us);
+    ++c.histogram[bucket];
+}
+
+void io_stats_t::merge(const io_stats_t &other) noexcept {
+    for (std::size_t i = 0; i < ops_count; ++i) {
+        counters[i].merge(other.counters[i]);
+    }
+}
+
+bool io_stats_t::empty() const noexcept {
+    return std::all_of(counters.begin(), counters.end(), [](const counter_t &c) { return !c.count; });
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "syncspirit-export.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace syncspirit::fs {
+
+/* disk I/O counters of a folder: the amount of operations, bytes and the
+   latencies histogram per operation kind. They are gathered by the fs actor
+   (and its slave tasks) and periodically reported to the model, which
+   accumulates them per folder (see model::diff::local::io_stats_t) */
+struct SYNCSPIRIT_API io_stats_t {
+    using clock_t = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+
+    enum class op_t : std::uint8_t { open = 0, read, write, rename, sync, count };
+    static constexpr std::size_t ops_count = static_cast<std::size_t>(op_t::count);
+
+    // bucket i holds latencies in [2^i, 2^(i+1)) microseconds, the last one
+    // holds everything above, i.e. ~0.5 second
+    static constexpr std::size_t buckets_count = 20;
+
+    struct SYNCSPIRIT_API counter_t {
+        std::uint64_t count = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t total_us = 0;
+        std::uint64_t max_us = 0;
+        std::array<std::uint32_t, buckets_count> histogram = {};
+
+        /* upper estimation of the latency (microseconds), which is not exceeded
+           by the given share (0..1] of operations */
+        std::uint64_t percentile(double share) const noexcept;
+        void merge(const counter_t &other) noexcept;
+    };
+    using counters_t = std::array<counter_t, ops_count>;
+
+    static inline time_point_t now() noexcept { return clock_t::now(); }
+    static std::string_view get_name(op_t op) noexcept;
+
+    void record(op_t op, std::uint64_t bytes, time_point_t started) noexcept;
+    void record(op_t op, std::uint64_t bytes, std::uint64_t latency_us) noexcept;
+    void merge(const io_stats_t &other) noexcept;
+    bool empty() const noexcept;
+
+    inline const counter_t &get(op_t op) const noexcept { return counters[static_cast<std::size_t>(op)]; }
+
+    counters_t counters;
+};
+
+using folder_io_stats_t = std::unordered_map<std::string, io_stats_t>;
+
+} // namespace syncspirit::fs
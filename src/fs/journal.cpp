@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "journal.h"
+#include "utils.h"
+#include "utils/error_code.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace syncspirit::fs;
+
+namespace {
+
+// magic, target file size and modification time
+constexpr unsigned char magic[] = {'S', 'S', 'J', '1'};
+constexpr std::size_t header_size = sizeof(magic) + 8 + 8;
+
+// block index, hash length and the hash itself
+constexpr std::size_t record_header_size = 4 + 1;
+
+void encode(syncspirit::utils::bytes_t &out, std::uint64_t value, std::size_t bytes) noexcept {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+    }
+}
+
+std::uint64_t decode(const unsigned char *ptr, std::size_t bytes) noexcept {
+    auto value = std::uint64_t{0};
+    for (std::size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(ptr[i]) << (i * 8);
+    }
+    return value;
+}
+
+} // namespace
+
+journal_t::journal_t(const bfs::path &target_, std::uint64_t file_size_, std::int64_t modification_s_) noexcept
+    : target{target_}, file_size{file_size_}, modification_s{modification_s_} {}
+
+bool journal_t::matches(std::uint64_t file_size_, std::int64_t modification_s_) const noexcept {
+    return file_size == file_size_ && modification_s == modification_s_;
+}
+
+void journal_t::add(std::uint32_t block_index, utils::bytes_view_t hash, std::uint64_t bytes) noexcept {
+    auto hash_size = std::min(hash.size(), std::size_t{0xFF});
+    encode(records, block_index, 4);
+    encode(records, hash_size, 1);
+    records.insert(records.end(), hash.begin(), hash.begin() + hash_size);
+    pending += bytes;
+}
+
+std::uint64_t journal_t::get_pending() const noexcept { return pending; }
+
+sys::error_code journal_t::flush() noexcept {
+    if (records.empty()) {
+        return {};
+    }
+    if (!handle) {
+        auto path = make_journal(target);
+        auto content = load(target);
+        if (content && content.assume_value().file_size == file_size &&
+            content.assume_value().modification_s == modification_s) {
+            // a trailing partially written record is dropped
+            auto ec = std::error_code();
+            offset = content.assume_value().size;
+            bfs::resize_file(path, offset, ec);
+            if (ec) {
+                return ec;
+            }
+        } else {
+            offset = 0;
+            remove(target);
+        }
+        auto opened = file_handle_t::open(path, file_handle_t::mode_t::read_write);
+        if (!opened) {
+            return opened.assume_error();
+        }
+        handle = std::move(opened.assume_value());
+        if (!offset) {
+            auto header = utils::bytes_t(magic, magic + sizeof(magic));
+            encode(header, file_size, 8);
+            encode(header, static_cast<std::uint64_t>(modification_s), 8);
+            if (auto ec = handle.write(0, utils::bytes_view_t(header)); ec) {
+                handle = {};
+                return ec;
+            }
+            offset = header.size();
+        }
+    }
+    if (auto ec = handle.write(offset, utils::bytes_view_t(records)); ec) {
+        // start over on the next flush
+        handle = {};
+        return ec;
+    }
+    offset += records.size();
+    records.clear();
+    pending = 0;
+    return {};
+}
+
+auto journal_t::load(const bfs::path &target) noexcept -> outcome::result<content_t> {
+    auto path = make_journal(target);
+    auto ec = sys::error_code{};
+    auto size = bfs::file_size(path, ec);
+    if (ec) {
+        return ec;
+    }
+    if (size < header_size) {
+        return utils::make_error_code(utils::error_code_t::invalid_journal);
+    }
+    auto opened = file_handle_t::open(path, file_handle_t::mode_t::read);
+    if (!opened) {
+        return opened.assume_error();
+    }
+    auto data = utils::bytes_t(size);
+    if (auto ec = opened.assume_value().read(0, data); ec) {
+        return ec;
+    }
+    auto ptr = data.data();
+    if (std::memcmp(ptr, magic, sizeof(magic))) {
+        return utils::make_error_code(utils::error_code_t::invalid_journal);
+    }
+    auto content = content_t{};
+    content.file_size = decode(ptr + sizeof(magic), 8);
+    content.modification_s = static_cast<std::int64_t>(decode(ptr + sizeof(magic) + 8, 8));
+
+    auto left = size - header_size;
+    ptr += header_size;
+    while (left >= record_header_size) {
+        auto block_index = static_cast<std::uint32_t>(decode(ptr, 4));
+        auto hash_size = static_cast<std::size_t>(ptr[4]);
+        if (left < record_header_size + hash_size) {
+            break;
+        }
+        // the last record of a block wins
+        content.blocks[block_index] = utils::bytes_t(ptr + record_header_size, ptr + record_header_size + hash_size);
+        ptr += record_header_size + hash_size;
+        left -= record_header_size + hash_size;
+    }
+    content.size = size - left;
+    return content;
+}
+
+sys::error_code journal_t::remove(const bfs::path &target) noexcept {
+    auto ec = sys::error_code{};
+    bfs::remove(make_journal(target), ec);
+    return ec;
+}
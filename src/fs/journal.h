@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "file_handle.h"
+#include "utils/bytes.h"
+#include "syncspirit-export.h"
+#include <boost/outcome.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+
+namespace syncspirit::fs {
+
+namespace bfs = std::filesystem;
+namespace sys = boost::system;
+namespace outcome = boost::outcome_v2;
+
+/* append-only sidecar of a temporal file, which records the hashes of the blocks
+   already written into it (and the version of the target file), so that an
+   interrupted download can be resumed without rehashing the temporal file.
+
+   The records are written only after the file data has been synced, i.e. a
+   recorded block is always on the disk, while the opposite is not required */
+struct SYNCSPIRIT_API journal_t {
+    using blocks_t = std::map<std::uint32_t, utils::bytes_t>;
+
+    struct content_t {
+        std::uint64_t file_size;
+        std::int64_t modification_s;
+        blocks_t blocks;
+        std::uint64_t size; // of the valid journal part
+    };
+
+    journal_t(const bfs::path &target, std::uint64_t file_size, std::int64_t modification_s) noexcept;
+    journal_t(journal_t &&) noexcept = default;
+    journal_t &operator=(journal_t &&) noexcept = default;
+
+    bool matches(std::uint64_t file_size, std::int64_t modification_s) const noexcept;
+    void add(std::uint32_t block_index, utils::bytes_view_t hash, std::uint64_t bytes) noexcept;
+
+    /* amount of the data bytes, which records are not flushed yet */
+    std::uint64_t get_pending() const noexcept;
+
+    /* appends the pending records; the first flush continues the existing
+       journal of the same target version, or starts a new one */
+    sys::error_code flush() noexcept;
+
+    static outcome::result<content_t> load(const bfs::path &target) noexcept;
+    static sys::error_code remove(const bfs::path &target) noexcept;
+
+  private:
+    bfs::path target;
+    std::uint64_t file_size;
+    std::int64_t modification_s;
+    file_handle_t handle;
+    utils::bytes_t records;
+    std::uint64_t pending = 0;
+    std::uint64_t offset = 0;
+};
+
+} // namespace syncspirit::fs
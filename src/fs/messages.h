@@ -5,6 +5,7 @@
 
 #include "proto/proto-fwd.hpp"
 #include "hasher/messages.h"
+#include "utils/block_trace.h"
 #include "utils/bytes.h"
 #include "utils/error_code.h"
 #include "update_type.hpp"
@@ -57,6 +58,7 @@ struct block_request_t : payload_base_t<utils::bytes_t> {
     bfs::path path;
     std::uint64_t offset;
     std::uint64_t block_size;
+    bool uncached = false; // do not keep the read block in the OS page cache
 
     inline block_request_t(extendended_context_prt_t context_, bfs::path path_, std::uint64_t offset_,
                            std::uint64_t block_size_) noexcept
@@ -124,12 +126,25 @@ struct update_meta_t : payload_base_t<void> {
     update_meta_t(update_meta_t &&) noexcept = default;
 };
 
+/* a written block to be recorded in the journal of the temporal file,
+   see journal_t; it is not recorded when block_index is negative */
+struct journal_record_t {
+    std::int64_t modification_s = 0;
+    std::int64_t block_index = -1;
+    utils::bytes_t hash;
+};
+
 struct append_block_t : payload_base_t<void> {
     using parent_t = payload_base_t<void>;
     bfs::path path;
     utils::bytes_t data;
     std::uint64_t offset;
     std::uint64_t file_size;
+    std::uint64_t zeroes = 0; // when non-zero, the data is empty and that many zero bytes are written
+    bool preallocate = false; // reserve the whole file disk space, when it is opened
+    bool uncached = false;    // do not keep the written data in the OS page cache
+    utils::block_trace_t *trace = nullptr; // owned by the context, stamped when tracing is enabled
+    journal_record_t journal;
 
     inline append_block_t(extendended_context_prt_t context_, std::string folder_id_, bfs::path path_,
                           utils::bytes_t data_, std::uint64_t offset_, std::uint64_t file_size_)
@@ -148,6 +163,9 @@ struct clone_block_t : payload_base_t<void> {
     bfs::path source;
     std::uint64_t source_offset;
     std::uint64_t block_size;
+    bool preallocate = false;
+    bool uncached = false;
+    journal_record_t journal;
 
     inline clone_block_t(extendended_context_prt_t context_, std::string folder_id, bfs::path target_,
                          std::uint64_t target_offset_, std::uint64_t target_size_, bfs::path source_,
@@ -160,13 +178,38 @@ struct clone_block_t : payload_base_t<void> {
     clone_block_t(clone_block_t &&) noexcept = default;
 };
 
-using io_command_t =
-    std::variant<block_request_t, remote_copy_t, finish_file_t, append_block_t, clone_block_t, update_meta_t>;
+struct clone_file_t : payload_base_t<void> {
+    using parent_t = payload_base_t<void>;
+
+    bfs::path path; // target
+    bfs::path conflict_path;
+    bfs::path source;
+    std::uint64_t file_size;
+    std::int64_t modification_s;
+    std::uint32_t permissions;
+    bool no_permissions;
+
+    inline clone_file_t(extendended_context_prt_t context_, std::string folder_id_, bfs::path path_,
+                        bfs::path conflict_path_, bfs::path source_, std::uint64_t file_size_,
+                        std::int64_t modification_s_, std::uint32_t permissions_, bool no_permissions_) noexcept
+        : parent_t(std::move(context_), std::move(folder_id_)), path{std::move(path_)},
+          conflict_path{std::move(conflict_path_)}, source{std::move(source_)}, file_size{file_size_},
+          modification_s{modification_s_}, permissions{permissions_}, no_permissions{no_permissions_} {}
+
+    clone_file_t(const clone_file_t &) = delete;
+    clone_file_t(clone_file_t &&) noexcept = default;
+};
+
+using io_command_t = std::variant<block_request_t, remote_copy_t, finish_file_t, append_block_t, clone_block_t,
+                                  clone_file_t, update_meta_t>;
 struct io_commands_t {
     const void *context;
     std::vector<io_command_t> commands;
 };
 
+/* some of the io_engine_t requests are finished */
+struct io_ready_t {};
+
 struct create_dir_t : bfs::path {
     using parent_t = bfs::path;
     using parent_t::parent_t;
@@ -222,6 +265,7 @@ namespace message {
 using foreign_executor_t = r::message_t<payload::foreign_executor_prt_t>;
 
 using io_commands_t = r::message_t<payload::io_commands_t>;
+using io_ready_t = r::message_t<payload::io_ready_t>;
 using create_dir_t = r::message_t<payload::create_dir_t>;
 
 using watch_folder_t = r::message_t<payload::watch_folder_t>;
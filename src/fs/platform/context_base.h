@@ -9,6 +9,11 @@
 #include <cstdint>
 #include "utils/log.h"
 
+namespace syncspirit::fs {
+struct io_engine_t;
+struct scan_pool_t;
+}
+
 namespace syncspirit::fs::platform {
 
 namespace rth = rotor::thread;
@@ -24,6 +29,9 @@ struct SYNCSPIRIT_API context_base_t : rth::system_context_thread_t {
     pt::time_duration poll_timeout;
     int poll_timeout_ms;
     utils::logger_t log;
+    io_engine_t *io_engine = nullptr; // asynchronous block I/O, if the platform has one
+    bool io_events = false;           // the io_engine notifies when its requests are finished
+    scan_pool_t *scan_pool = nullptr; // parallel directories scanning, if enabled
 };
 
 } // namespace syncspirit::fs::platform
@@ -8,6 +8,10 @@
 
 using namespace syncspirit::fs::platform::linux;
 
+#if SYNCSPIRIT_IO_URING
+static constexpr std::uint32_t uring_entries = 256;
+#endif
+
 static void async_cb(int fd, void *data) {
     auto ctx = reinterpret_cast<platform_context_t *>(data);
     char dummy[4];
@@ -24,6 +28,13 @@ static void async_cb(int fd, void *data) {
     ctx->async_flag.store(false, std::memory_order_release);
 }
 
+#if SYNCSPIRIT_IO_URING
+static void uring_cb(int, void *data) {
+    auto ctx = reinterpret_cast<platform_context_t *>(data);
+    ctx->backend.uring->on_event();
+}
+#endif
+
 linux_backend_t::io_guard_t::~io_guard_t() {
     if (fd && ctx) {
         reinterpret_cast<platform_context_t *>(ctx)->backend.unwatch(fd);
@@ -39,6 +50,15 @@ auto linux_backend_t::initialize(int pipe_read_fd, void *platform_context) -> io
         return {};
     }
 
+#if SYNCSPIRIT_IO_URING
+    uring = std::make_unique<uring_engine_t>(uring_entries);
+    if (!uring->ready()) {
+        uring.reset();
+    } else if (auto fd = uring->get_fd(); fd >= 0) {
+        uring_watched = watch(fd, uring_cb, platform_context);
+    }
+#endif
+
     auto ok = watch(pipe_read_fd, async_cb, platform_context);
     if (ok) {
         return io_guard_t(platform_context, pipe_read_fd);
@@ -47,6 +67,12 @@ auto linux_backend_t::initialize(int pipe_read_fd, void *platform_context) -> io
 }
 
 void linux_backend_t::destroy() {
+#if SYNCSPIRIT_IO_URING
+    if (uring_watched) {
+        unwatch(uring->get_fd());
+    }
+    uring.reset();
+#endif
     if (monitor >= 0) {
         close(monitor);
     }
@@ -81,6 +107,13 @@ bool linux_backend_t::watch(int fd, io_callback_t callback, void *data) {
     }
 }
 
+platform_context_t::platform_context_t(const pt::time_duration &poll_timeout_) noexcept : parent_t(poll_timeout_) {
+#if SYNCSPIRIT_IO_URING
+    io_engine = backend.uring.get();
+    io_events = backend.uring_watched;
+#endif
+}
+
 bool linux_backend_t::poll(std::uint32_t timeout) {
     assert(io_callbacks.size() == events.size());
     int i = static_cast<int>(sizeof(events.size()));
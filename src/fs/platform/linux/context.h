@@ -8,8 +8,10 @@
 #if SYNCSPIRIT_WATCHER_INOTIFY
 
 #include "fs/platform/unix/context.hpp"
+#include "uring.h"
 #include "utils/log.h"
 #include <sys/epoll.h>
+#include <memory>
 #include <unordered_map>
 
 namespace syncspirit::fs::platform::linux {
@@ -25,6 +27,9 @@ struct SYNCSPIRIT_API linux_backend_t {
         void *data;
     };
     using io_callbacks_map_t = std::unordered_map<int, io_context_t>;
+#if SYNCSPIRIT_IO_URING
+    using uring_ptr_t = std::unique_ptr<uring_engine_t>;
+#endif
 
     struct io_guard_t : unix::io_guard_t {
         using parent_t = unix::io_guard_t;
@@ -56,6 +61,10 @@ struct SYNCSPIRIT_API linux_backend_t {
     utils::logger_t log;
     events_t events;
     io_callbacks_map_t io_callbacks;
+#if SYNCSPIRIT_IO_URING
+    uring_ptr_t uring;
+    bool uring_watched = false; // i.e. its completions are delivered via the event loop
+#endif
 };
 
 namespace details {
@@ -64,7 +73,7 @@ using base_t = platform::unix::platform_context_t<linux_backend_t>;
 
 struct SYNCSPIRIT_API platform_context_t : details::base_t {
     using parent_t = details::base_t;
-    using parent_t::parent_t;
+    platform_context_t(const pt::time_duration &poll_timeout) noexcept;
 };
 
 } // namespace syncspirit::fs::platform::linux
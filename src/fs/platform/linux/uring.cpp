@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "uring.h"
+
+#if SYNCSPIRIT_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+using namespace syncspirit::fs::platform::linux;
+
+static int uring_setup(unsigned entries, io_uring_params *params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template <typename T> static T *at(void *base, std::uint32_t offset) noexcept {
+    return reinterpret_cast<T *>(reinterpret_cast<char *>(base) + offset);
+}
+
+uring_engine_t::uring_engine_t(std::uint32_t entries) noexcept {
+    log = utils::get_logger("fs.uring");
+
+    auto params = io_uring_params{};
+    auto fd = uring_setup(entries, &params);
+    if (fd < 0) {
+        LOG_INFO(log, "io_uring is not available: {}", strerror(errno));
+        return;
+    }
+    ring_fd = fd;
+
+    auto probe_ops = std::size_t{IORING_OP_WRITE + 1};
+    auto probe_size = sizeof(io_uring_probe) + probe_ops * sizeof(io_uring_probe_op);
+    auto probe_buff = std::make_unique<unsigned char[]>(probe_size);
+    std::fill_n(probe_buff.get(), probe_size, 0);
+    auto probe = reinterpret_cast<io_uring_probe *>(probe_buff.get());
+    auto supported = [&](unsigned op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    auto r = uring_register(ring_fd, IORING_REGISTER_PROBE, probe, static_cast<unsigned>(probe_ops));
+    if (r < 0 || !supported(IORING_OP_READ) || !supported(IORING_OP_WRITE)) {
+        LOG_INFO(log, "io_uring does not support positional read/write, won't use it");
+        ::close(ring_fd);
+        ring_fd = -1;
+        return;
+    }
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_map = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_map) {
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+    }
+
+    auto map = [&](std::size_t size, off_t offset) -> void * {
+        auto ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    };
+
+    sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+    cq_ring = single_map ? sq_ring : map(cq_ring_size, IORING_OFF_CQ_RING);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = reinterpret_cast<io_uring_sqe *>(map(sqes_size, IORING_OFF_SQES));
+    if (!sq_ring || !cq_ring || !sqes) {
+        LOG_WARN(log, "cannot map io_uring: {}", strerror(errno));
+        release();
+        return;
+    }
+
+    sq_head = at<unsigned>(sq_ring, params.sq_off.head);
+    sq_tail = at<unsigned>(sq_ring, params.sq_off.tail);
+    sq_array = at<unsigned>(sq_ring, params.sq_off.array);
+    sq_mask = *at<unsigned>(sq_ring, params.sq_off.ring_mask);
+    sq_entries = params.sq_entries;
+
+    cq_head = at<unsigned>(cq_ring, params.cq_off.head);
+    cq_tail = at<unsigned>(cq_ring, params.cq_off.tail);
+    cqes = at<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+    cq_mask = *at<unsigned>(cq_ring, params.cq_off.ring_mask);
+    cq_entries = params.cq_entries;
+
+    auto efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd >= 0 && uring_register(ring_fd, IORING_REGISTER_EVENTFD, &efd, 1) == 0) {
+        event_fd = efd;
+    } else {
+        LOG_DEBUG(log, "io_uring completions cannot be signalled: {}", strerror(errno));
+        if (efd >= 0) {
+            ::close(efd);
+        }
+    }
+
+    requests.reserve(cq_entries);
+    LOG_DEBUG(log, "io_uring is ready, sq/cq entries: {}/{}, event fd: {}", sq_entries, cq_entries, event_fd);
+}
+
+uring_engine_t::~uring_engine_t() {
+    release();
+    // it is closed only here, as it might be watched by the event loop
+    if (event_fd >= 0) {
+        ::close(event_fd);
+    }
+}
+
+void uring_engine_t::release() noexcept {
+    if (sqes) {
+        ::munmap(sqes, sqes_size);
+        sqes = nullptr;
+    }
+    if (cq_ring && cq_ring != sq_ring) {
+        ::munmap(cq_ring, cq_ring_size);
+    }
+    if (sq_ring) {
+        ::munmap(sq_ring, sq_ring_size);
+    }
+    sq_ring = cq_ring = nullptr;
+    if (ring_fd >= 0) {
+        ::close(ring_fd);
+        ring_fd = -1;
+    }
+}
+
+bool uring_engine_t::ready() const noexcept { return ring_fd >= 0; }
+
+int uring_engine_t::get_fd() const noexcept { return event_fd; }
+
+void uring_engine_t::on_event() noexcept {
+    auto value = eventfd_t{};
+    while (::eventfd_read(event_fd, &value) == 0) {}
+    notify();
+}
+
+bool uring_engine_t::submit(io_request_t &request) noexcept {
+    if (push(request)) {
+        requests.emplace_back(&request);
+        return true;
+    }
+    return false;
+}
+
+bool uring_engine_t::push(io_request_t &request) noexcept {
+    if (ring_fd < 0 || queued == sq_entries || queued + inflight == cq_entries) {
+        return false;
+    }
+
+    auto tail = *sq_tail;
+    auto index = tail & sq_mask;
+    auto sqe = sqes + index;
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = request.fd;
+    sqe->off = request.offset + request.done;
+    sqe->addr = reinterpret_cast<std::uintptr_t>(request.data + request.done);
+    sqe->len = request.size - request.done;
+    sqe->user_data = reinterpret_cast<std::uintptr_t>(&request);
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++queued;
+    return true;
+}
+
+void uring_engine_t::poll() noexcept {
+    notified.store(false, std::memory_order_release);
+    if (ring_fd < 0) {
+        return;
+    }
+    reap();
+    // the reaped requests might be pushed back, if they are done partially
+    while (queued) {
+        auto r = uring_enter(ring_fd, queued, 0, 0);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                if (inflight) {
+                    // will be retried on the next completion
+                    break;
+                }
+                return complete();
+            }
+            LOG_CRITICAL(log, "io_uring_enter() failed: {}", strerror(errno));
+            return fail(errno);
+        }
+        queued -= static_cast<unsigned>(r);
+        inflight += static_cast<unsigned>(r);
+        reap();
+    }
+    if (!queued && !inflight) {
+        requests.clear();
+    }
+}
+
+void uring_engine_t::complete() noexcept {
+    while (queued || inflight) {
+        auto r = uring_enter(ring_fd, queued, queued + inflight, IORING_ENTER_GETEVENTS);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                reap();
+                continue;
+            }
+            LOG_CRITICAL(log, "io_uring_enter() failed: {}", strerror(errno));
+            fail(errno);
+            break;
+        }
+        queued -= static_cast<unsigned>(r);
+        inflight += static_cast<unsigned>(r);
+        reap();
+    }
+    requests.clear();
+}
+
+void uring_engine_t::reap() noexcept {
+    auto head = *cq_head;
+    auto tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        auto &cqe = cqes[head & cq_mask];
+        auto &request = *reinterpret_cast<io_request_t *>(cqe.user_data);
+        --inflight;
+        ++head;
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            if (!push(request)) {
+                request.error = EAGAIN;
+            }
+        } else if (cqe.res < 0) {
+            request.error = -cqe.res;
+        } else if (cqe.res == 0) {
+            // unexpected end of file
+            request.error = EIO;
+        } else {
+            request.done += static_cast<std::uint32_t>(cqe.res);
+            if (request.done < request.size && !push(request)) {
+                request.error = EAGAIN;
+            }
+        }
+        request.finished = request.error || request.done == request.size;
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+void uring_engine_t::fail(int error) noexcept {
+    for (auto request : requests) {
+        if (!request->error && request->done < request->size) {
+            request->error = error;
+        }
+        request->finished = true;
+    }
+    queued = inflight = 0;
+    release();
+}
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "syncspirit-config.h"
+
+#if SYNCSPIRIT_IO_URING
+
+#include "fs/io_engine.h"
+#include "utils/log.h"
+#include <cstddef>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace syncspirit::fs::platform::linux {
+
+/* io_uring via raw syscalls, no liburing is needed. The completions are signalled
+   via eventfd, which should be watched by the event loop of the thread, see get_fd() */
+struct SYNCSPIRIT_API uring_engine_t final : io_engine_t {
+    uring_engine_t(std::uint32_t entries) noexcept;
+    uring_engine_t(const uring_engine_t &) = delete;
+    ~uring_engine_t();
+
+    bool ready() const noexcept;
+
+    bool submit(io_request_t &request) noexcept override;
+    void poll() noexcept override;
+    void complete() noexcept override;
+
+    /* eventfd, which becomes readable when requests are finished, or -1 */
+    int get_fd() const noexcept;
+
+    /* should be invoked when get_fd() is readable */
+    void on_event() noexcept;
+
+  private:
+    bool push(io_request_t &request) noexcept;
+    void reap() noexcept;
+    void fail(int error) noexcept;
+    void release() noexcept;
+
+    int ring_fd = -1;
+    int event_fd = -1;
+    void *sq_ring = nullptr;
+    void *cq_ring = nullptr;
+    std::size_t sq_ring_size = 0;
+    std::size_t cq_ring_size = 0;
+    io_uring_sqe *sqes = nullptr;
+    std::size_t sqes_size = 0;
+
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    io_uring_cqe *cqes;
+    unsigned cq_mask;
+    unsigned cq_entries;
+
+    unsigned queued = 0;
+    unsigned inflight = 0;
+    std::vector<io_request_t *> requests;
+    utils::logger_t log;
+};
+
+} // namespace syncspirit::fs::platform::linux
+
+#endif
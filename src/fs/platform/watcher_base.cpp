@@ -264,7 +264,7 @@ auto FU::make(const folder_info_t &folder_info, watcher_base_t &actor) noexcept
 
 watcher_base_t::watcher_base_t(config_t &cfg)
     : parent_t{cfg}, retension(cfg.change_retension), updates_mediator{std::move(cfg.updates_mediator)},
-      watched_folders(cfg.watched_folders), fs_config{cfg.fs_config} {
+      watched_folders(cfg.watched_folders), ro_cache{std::move(cfg.ro_cache)}, fs_config{cfg.fs_config} {
     log = utils::get_logger(actor_identity);
     if (!retension.is_positive()) {
         LOG_ERROR(log, "retension interval should be positive");
@@ -320,6 +320,16 @@ void watcher_base_t::push(const timepoint_t &deadline, std::string_view folder_i
     auto source = (bulk_update_t *)(nullptr);
     auto target = (bulk_update_t *)(nullptr);
     LOG_DEBUG(log, "file event '{}' for '{}' in folder {}", support::stringify(type), relative_path, folder_id);
+    if (ro_cache) {
+        // cached descriptors might refer to the replaced or deleted files
+        if (auto it = watched_folders->find(folder_id); it != watched_folders->end()) {
+            auto &folder_path = it->second.path;
+            ro_cache->remove_all(folder_path / boost::nowide::widen(relative_path));
+            if (!prev_path.empty()) {
+                ro_cache->remove_all(folder_path / boost::nowide::widen(prev_path));
+            }
+        }
+    }
     if (next.deadline == deadline) {
         target = &next;
     } else if (next.deadline.is_not_a_date_time()) {
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "read_ahead.h"
+#include <algorithm>
+
+using namespace syncspirit::fs;
+
+auto read_ahead_t::read(const void *reader, std::uint64_t offset, std::uint32_t size) noexcept -> range_t {
+    auto it = std::find_if(streams.begin(), streams.end(), [&](auto &s) { return s.used && s.reader == reader; });
+    if (it == streams.end()) {
+        it = streams.begin() + victim;
+        victim = (victim + 1) % max_readers;
+        *it = stream_t{reader, offset + size, 0, 0, true};
+        return {};
+    }
+
+    auto &stream = *it;
+    if (offset != stream.next || !size) {
+        stream.next = offset + size;
+        stream.prefetched = stream.blocks = 0;
+        return {};
+    }
+
+    stream.next = offset + size;
+    stream.blocks = std::clamp(stream.blocks * 2, 2u, max_blocks);
+    auto window = std::uint64_t{stream.blocks} * size;
+    if (stream.prefetched >= stream.next + window / 2) {
+        return {};
+    }
+    auto start = std::max(stream.prefetched, stream.next);
+    auto end = stream.next + window;
+    stream.prefetched = end;
+    return {start, end - start};
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "syncspirit-export.h"
+#include <array>
+#include <cstdint>
+
+namespace syncspirit::fs {
+
+/* detects sequential reads of a file per reader (i.e. per peer) and suggests the range
+   to be read in advance; the window doubles with each sequential read up to max_blocks
+   blocks ahead and it is re-suggested only when half of it has been consumed */
+struct SYNCSPIRIT_API read_ahead_t {
+    struct range_t {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    static constexpr std::uint32_t max_readers = 4;
+    static constexpr std::uint32_t max_blocks = 16;
+
+    range_t read(const void *reader, std::uint64_t offset, std::uint32_t size) noexcept;
+
+  private:
+    struct stream_t {
+        const void *reader = nullptr;
+        std::uint64_t next = 0;
+        std::uint64_t prefetched = 0;
+        std::uint32_t blocks = 0;
+        bool used = false;
+    };
+    using streams_t = std::array<stream_t, max_readers>;
+
+    streams_t streams;
+    std::uint32_t victim = 0;
+};
+
+} // namespace syncspirit::fs
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "scan_pool.h"
+#include "task/scan_dir.h"
+#include "utils/platform.h"
+#include <fmt/format.h>
+#include <algorithm>
+
+using namespace syncspirit::fs;
+
+namespace {
+// directories to scan ahead per worker
+constexpr std::uint32_t frontier_per_thread = 64;
+} // namespace
+
+scan_pool_t::scan_pool_t(std::uint32_t threads_) noexcept {
+    log = utils::get_logger("fs.scan_pool");
+    for (std::uint32_t i = 0; i < std::max(threads_, 1u); ++i) {
+        threads.emplace_back([this, i]() {
+            auto name = fmt::format("ss/fs-scan-{}", i + 1);
+            utils::platform_t::set_thread_name(name);
+            run();
+        });
+    }
+    LOG_DEBUG(log, "started {} scan threads", threads.size());
+}
+
+scan_pool_t::~scan_pool_t() {
+    {
+        auto lock = std::unique_lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+std::uint32_t scan_pool_t::get_frontier() const noexcept {
+    return static_cast<std::uint32_t>(threads.size()) * frontier_per_thread;
+}
+
+void scan_pool_t::scan(tasks_t tasks) noexcept {
+    if (tasks.empty()) {
+        return;
+    }
+    auto lock = std::unique_lock(mutex);
+    queue.insert(queue.end(), tasks.begin(), tasks.end());
+    outstanding += tasks.size();
+    cv.notify_all();
+    done.wait(lock, [&]() { return outstanding == 0; });
+}
+
+void scan_pool_t::run() noexcept {
+    auto lock = std::unique_lock(mutex);
+    while (true) {
+        cv.wait(lock, [&]() { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        auto task = queue.back();
+        queue.pop_back();
+        lock.unlock();
+
+        task->scan();
+
+        lock.lock();
+        if (--outstanding == 0) {
+            done.notify_all();
+        }
+    }
+}
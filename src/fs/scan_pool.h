@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "syncspirit-export.h"
+#include "utils/log.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace syncspirit::fs {
+
+namespace task {
+struct scan_dir_t;
+}
+
+/* scans directories by a pool of worker threads, so that the metadata latency
+   of many directories (NFS, SSD queues) overlaps. It is used by the fs thread
+   to scan ahead the subdirectories of a scanned directory, the results are
+   consumed later by the folder traversal in its own order */
+struct SYNCSPIRIT_API scan_pool_t {
+    using tasks_t = std::span<task::scan_dir_t *>;
+
+    scan_pool_t(std::uint32_t threads) noexcept;
+    scan_pool_t(const scan_pool_t &) = delete;
+    ~scan_pool_t();
+
+    /* max amount of directories to be scanned ahead by a single scan */
+    std::uint32_t get_frontier() const noexcept;
+
+    /* scans the directories in parallel and waits until all of them are done */
+    void scan(tasks_t tasks) noexcept;
+
+  private:
+    using threads_t = std::vector<std::thread>;
+    using queue_t = std::vector<task::scan_dir_t *>;
+
+    void run() noexcept;
+
+    threads_t threads;
+    queue_t queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable done;
+    std::size_t outstanding = 0;
+    bool stop = false;
+    utils::logger_t log;
+};
+
+} // namespace syncspirit::fs
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "load_journal.h"
+#include "fs/utils.h"
+#include "utils/error_code.h"
+
+using namespace syncspirit::fs::task;
+
+load_journal_t::load_journal_t(bfs::path path_, hasher::payload::extendended_context_prt_t context_) noexcept
+    : path{std::move(path_)}, content{}, context{std::move(context_)} {}
+
+bool load_journal_t::process(fs_slave_t &fs_slave, execution_context_t &context) noexcept {
+    auto target = path;
+    target.replace_extension();
+    auto result = journal_t::load(target);
+    if (!result) {
+        ec = result.assume_error();
+        if (ec != sys::errc::no_such_file_or_directory) {
+            journal_t::remove(target);
+        }
+        return false;
+    }
+    content = std::move(result.assume_value());
+
+    // the records are meaningless, if the file has been truncated or extended
+    auto size = bfs::file_size(path, ec);
+    if (!ec && size != content.file_size) {
+        ec = utils::make_error_code(utils::error_code_t::invalid_journal);
+    }
+    if (ec) {
+        journal_t::remove(target);
+    }
+    return false;
+}
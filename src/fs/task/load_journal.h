@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "task.h"
+#include "fs/journal.h"
+
+namespace syncspirit::fs::task {
+
+/* loads the journal of the temporal file; on success the journal is valid
+   for the file, otherwise it is removed */
+struct SYNCSPIRIT_API load_journal_t {
+    load_journal_t(bfs::path path, hasher::payload::extendended_context_prt_t context) noexcept;
+    bool process(fs_slave_t &fs_slave, execution_context_t &context) noexcept;
+
+    bfs::path path; // temporal file
+    journal_t::content_t content;
+    sys::error_code ec;
+    hasher::payload::extendended_context_prt_t context;
+};
+
+} // namespace syncspirit::fs::task
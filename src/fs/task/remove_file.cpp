@@ -4,6 +4,8 @@
 #include "remove_file.h"
 #include "fs/messages.h"
 #include "fs/fs_proxy.h"
+#include "fs/journal.h"
+#include "fs/utils.h"
 
 using namespace syncspirit::fs::task;
 
@@ -12,6 +14,10 @@ remove_file_t::remove_file_t(bfs::path path_) noexcept : path{std::move(path_)}
 bool remove_file_t::process(fs_slave_t &fs_slave, execution_context_t &context) noexcept {
     ec = context.fs_proxy->remove_file(path);
     if (!ec) {
+        if (is_temporal(path) && !is_journal(path)) {
+            auto target = path;
+            journal_t::remove(target.replace_extension());
+        }
         return true;
     }
     return false;
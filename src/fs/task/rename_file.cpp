@@ -3,6 +3,9 @@
 
 #include "rename_file.h"
 #include "fs/fs_proxy.h"
+#include "fs/io_stats.h"
+#include "fs/journal.h"
+#include "fs/utils.h"
 
 using namespace syncspirit::fs::task;
 
@@ -13,8 +16,17 @@ rename_file_t::rename_file_t(bfs::path path_, bfs::path new_name_, std::int64_t
 
 bool rename_file_t::process(fs_slave_t &fs_slave, execution_context_t &context) noexcept {
     auto new_path = path.parent_path() / new_name;
+    auto started = io_stats_t::now();
     ec = context.fs_proxy->rename(path, new_path);
+    if (context.io_stats) {
+        context.io_stats->record(io_stats_t::op_t::rename, 0, started);
+    }
     if (!ec) {
+        if (is_temporal(path)) {
+            // the incomplete file has been finalized
+            auto target = path;
+            journal_t::remove(target.replace_extension());
+        }
         ec = context.fs_proxy->last_write_time(new_path, modification_s);
         return true;
     }
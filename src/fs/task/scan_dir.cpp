@@ -1,12 +1,36 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
+#include "syncspirit-config.h"
 #include "scan_dir.h"
 #include "fs/fs_slave.h"
+#include "fs/scan_pool.h"
 #include <algorithm>
+#include <array>
+#include <fstream>
+#include <boost/nowide/convert.hpp>
+
+#if !(defined(WIN32) || defined(_WIN32) || defined(__WIN32))
+#include <sys/stat.h>
+#endif
+
+#if defined(SYNCSPIRIT_STATX) && defined(SYNCSPIRIT_GETDENTS64)
+#define SYNCSPIRIT_SCAN_GETDENTS 1
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+#endif
 
 using namespace syncspirit::fs;
 using namespace syncspirit::fs::task;
+using match_t = syncspirit::model::ignores_t::match_t;
 
 // inverse files sorting as files will be inversed again (inderectly) by
 // stack structure
@@ -28,67 +52,442 @@ scan_dir_t::scan_dir_t(bfs::path path_, presentation::presence_ptr_t presence_,
       ec(utils::make_error_code(utils::error_code_t::no_action)), single_child{std::move(single_child_)},
       notify{notify_ ? 1u : 0}, recurse{recurse_ ? 1u : 0}, requires_refinement{requires_refinement_ ? 1u : 0} {}
 
-bool scan_dir_t::process(fs_slave_t &slave, execution_context_t &context) noexcept {
-    ec = {};
+/* ignored subtrees are neither stat'ed nor descended into; the dir itself might be
+   ignored, while some of its children are not */
+static bool is_ignored(match_t match, bfs::file_type type) noexcept {
+    return match == match_t::ignored || (match == match_t::ignored_self && type != bfs::file_type::directory);
+}
+
+#ifdef SYNCSPIRIT_SCAN_GETDENTS
+namespace {
+
+// the layout used by the kernel, glibc does not always expose it
+struct linux_dirent64_t {
+    std::uint64_t d_ino;
+    std::int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[256];
+};
+
+inline bfs::file_time_type to_file_time(const struct statx_timestamp &ts) noexcept {
+    using namespace std::chrono;
+    auto since_epoch = seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec);
+    auto sys_at = system_clock::time_point(duration_cast<system_clock::duration>(since_epoch));
+    return bfs::file_time_type::clock::from_sys(sys_at);
+}
+
+inline bfs::file_type to_file_type(std::uint32_t mode) noexcept {
     using FT = bfs::file_type;
-    auto it = bfs::directory_iterator(path, ec);
-    if (ec) {
+    switch (mode & S_IFMT) {
+    case S_IFREG:
+        return FT::regular;
+    case S_IFDIR:
+        return FT::directory;
+    case S_IFLNK:
+        return FT::symlink;
+    default:
+        return FT::unknown;
+    }
+}
+
+static constexpr auto statx_mask = STATX_TYPE | STATX_MODE | STATX_MTIME | STATX_SIZE | STATX_INO | STATX_CTIME;
+static constexpr auto statx_flags = AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT;
+
+// returns false for the entries, which are not synchronized
+bool fill(scan_dir_t::child_info_t &info, const struct statx &stx) noexcept {
+    using FT = bfs::file_type;
+    auto file_type = to_file_type(stx.stx_mode);
+    if (file_type == FT::unknown) {
+        return false;
+    }
+    auto perms = static_cast<bfs::perms>(stx.stx_mode & 07777);
+    info.status = bfs::file_status(file_type, perms);
+    if (file_type != FT::symlink) {
+        info.last_write_time = to_file_time(stx.stx_mtime);
+        info.device = ::makedev(stx.stx_dev_major, stx.stx_dev_minor);
+        info.inode = stx.stx_ino;
+        info.ctime_s = stx.stx_ctime.tv_sec;
+        info.ctime_ns = static_cast<std::int32_t>(stx.stx_ctime.tv_nsec);
+    }
+    if (file_type == FT::regular) {
+        info.size = stx.stx_size;
+    } else if (file_type == FT::symlink) {
+        // symlinks are rare, so the target is read the usual way
+        info.target = bfs::read_symlink(info.path, info.ec);
+    }
+    return true;
+}
+
+/* enumerates the directory entries via a few getdents64 calls and gets the needed
+   metadata with a single statx per entry, relative to the directory descriptor,
+   i.e. without resolving the full path again and again.
+
+   Returns false if the facility is not available (e.g. statx is filtered out by
+   seccomp), the generic enumeration should be used then */
+bool scan_native(scan_dir_t &task) noexcept {
+    auto dir_fd = ::open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        task.ec = sys::error_code(errno, sys::system_category());
+        return true;
+    }
+
+    auto &single_child = task.single_child.native();
+    auto buffer = std::array<char, 32 * 1024>();
+    auto done = false;
+    auto supported = true;
+    while (!done && supported) {
+        auto r = ::syscall(SYS_getdents64, dir_fd, buffer.data(), buffer.size());
+        if (r < 0) {
+            supported = errno != ENOSYS;
+            task.ec = sys::error_code(errno, sys::system_category());
+            break;
+        } else if (r == 0) {
+            break;
+        }
+        for (long offset = 0; offset < r;) {
+            auto entry = reinterpret_cast<linux_dirent64_t *>(buffer.data() + offset);
+            offset += entry->d_reclen;
+
+            auto name = entry->d_name;
+            if (!std::strcmp(name, ".") || !std::strcmp(name, "..")) {
+                continue;
+            }
+            // fifos, sockets and devices are not synchronized, no need to stat them
+            auto d_type = entry->d_type;
+            if (d_type != DT_UNKNOWN && d_type != DT_REG && d_type != DT_DIR && d_type != DT_LNK) {
+                continue;
+            }
+            if (!single_child.empty()) {
+                if (single_child != name) {
+                    continue;
+                }
+                done = true;
+            }
+
+            auto match = task.match(name);
+            auto d_dir = d_type == DT_DIR || d_type == DT_UNKNOWN;
+            if (match == match_t::ignored || (match == match_t::ignored_self && !d_dir)) {
+                continue;
+            }
+
+            auto child_info = task::scan_dir_t::child_info_t{};
+            child_info.path = task.path / name;
+            struct statx stx;
+            if (::statx(dir_fd, name, statx_flags, statx_mask, &stx) != 0) {
+                if (errno == ENOSYS) {
+                    supported = false;
+                    break;
+                }
+                child_info.ec = sys::error_code(errno, sys::system_category());
+                task.child_infos.emplace_back(std::move(child_info));
+                continue;
+            }
+
+            if (fill(child_info, stx) && !is_ignored(match, child_info.status.type())) {
+                task.child_infos.emplace_back(std::move(child_info));
+            }
+            if (done) {
+                break;
+            }
+        }
+    }
+    ::close(dir_fd);
+
+    if (!supported) {
+        task.ec = {};
+        task.child_infos.clear();
+    }
+    return supported;
+}
+
+/* stats the known entries of the unchanged directory, relative to its descriptor */
+bool scan_known_native(scan_dir_t &task) noexcept {
+    auto dir_fd = ::open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        task.ec = sys::error_code(errno, sys::system_category());
+        return true;
+    }
+
+    auto supported = true;
+    for (auto &name : task.known_children) {
+        auto match = task.match(name.native());
+        if (match == match_t::ignored) {
+            continue;
+        }
+        auto child_info = task::scan_dir_t::child_info_t{};
+        child_info.path = task.path / name;
+        struct statx stx;
+        if (::statx(dir_fd, name.c_str(), statx_flags, statx_mask, &stx) != 0) {
+            if (errno == ENOSYS) {
+                supported = false;
+                break;
+            } else if (errno != ENOENT) {
+                child_info.ec = sys::error_code(errno, sys::system_category());
+                task.child_infos.emplace_back(std::move(child_info));
+            }
+            continue;
+        }
+        if (fill(child_info, stx) && !is_ignored(match, child_info.status.type())) {
+            task.child_infos.emplace_back(std::move(child_info));
+        }
+    }
+    ::close(dir_fd);
+
+    if (!supported) {
+        task.child_infos.clear();
+    }
+    return supported;
+}
+
+} // namespace
+#endif
+
+// the on-disk identity is optional, so failures are ignored
+static void fill_identity(scan_dir_t::child_info_t &info) noexcept {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+    (void)info;
+#else
+    struct stat st;
+    if (::lstat(info.path.c_str(), &st) == 0) {
+        info.device = static_cast<std::uint64_t>(st.st_dev);
+        info.inode = static_cast<std::uint64_t>(st.st_ino);
+#if defined(__APPLE__)
+        info.ctime_s = st.st_ctimespec.tv_sec;
+        info.ctime_ns = static_cast<std::int32_t>(st.st_ctimespec.tv_nsec);
+#else
+        info.ctime_s = st.st_ctim.tv_sec;
+        info.ctime_ns = static_cast<std::int32_t>(st.st_ctim.tv_nsec);
+#endif
+    }
+#endif
+}
+
+static outcome::result<std::string> read_file(const bfs::path &path) noexcept {
+    auto in = std::ifstream(path, std::ios::binary);
+    if (!in) {
+        return sys::errc::make_error_code(sys::errc::no_such_file_or_directory);
+    }
+    auto content = std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (in.bad()) {
+        return sys::errc::make_error_code(sys::errc::io_error);
+    }
+    return content;
+}
+
+auto scan_dir_t::read_ignores(const bfs::path &root) noexcept -> outcome::result<model::ignores_ptr_t> {
+    using boost::nowide::widen;
+    auto ec = sys::error_code();
+    auto path = root / model::ignores_t::file_name;
+    if (!bfs::exists(path, ec)) {
+        return model::ignores_ptr_t{};
+    }
+    auto content = read_file(path);
+    if (!content) {
+        return content.assume_error();
+    }
+    auto loader = [&](std::string_view name) { return read_file(root / bfs::path(widen(name))); };
+    return model::ignores_t::parse(content.assume_value(), loader);
+}
+
+// returns false if the entry does not exist
+static bool examine(scan_dir_t::child_infos_t &child_infos, bfs::path path) noexcept {
+    using FT = bfs::file_type;
+    auto ec = sys::error_code();
+    auto child_info = task::scan_dir_t::child_info_t{};
+    child_info.path = std::move(path);
+    auto status = bfs::symlink_status(child_info.path, ec);
+    if (status.type() == FT::not_found) {
         return false;
+    } else if (ec) {
+        child_info.ec = ec;
+        child_infos.emplace_back(std::move(child_info));
+        return true;
+    }
+    auto file_type = status.type();
+    auto is_regular = file_type == FT::regular;
+    auto is_dir = file_type == FT::directory;
+    auto is_link = file_type == FT::symlink;
+    if (!is_regular && !is_dir && !is_link) {
+        return true;
+    }
+    auto &last = child_infos.emplace_back(std::move(child_info));
+    last.status = std::move(status);
+
+    if (is_regular || is_dir) {
+        last.last_write_time = bfs::last_write_time(last.path, ec);
+        if (ec) {
+            last.ec = ec;
+            return true;
+        }
+        fill_identity(last);
+    }
+    if (is_regular) {
+        last.size = bfs::file_size(last.path, ec);
+        if (ec) {
+            last.ec = ec;
+        }
+    } else if (is_link) {
+        last.target = bfs::read_symlink(last.path, ec);
+        if (ec) {
+            last.ec = ec;
+        }
+    }
+    return true;
+}
+
+static void scan_generic(scan_dir_t &task) noexcept {
+    auto &ec = task.ec;
+    auto &single_child = task.single_child;
+    auto it = bfs::directory_iterator(task.path, ec);
+    if (ec) {
+        return;
     }
     for (; it != bfs::directory_iterator(); ++it) {
         auto &child = *it;
+        auto filename = child.path().filename();
         if (!single_child.empty()) {
-            if (single_child.filename() != child.path().filename()) {
+            if (single_child.filename() != filename) {
                 continue;
             }
         }
-        auto child_info = task::scan_dir_t::child_info_t{};
-        child_info.path = child;
-        auto status = bfs::symlink_status(child_info.path, ec);
-        if (ec) {
-            child_info.ec = ec;
-            child_infos.emplace_back(std::move(child_info));
+        auto match = task.match(boost::nowide::narrow(filename.generic_wstring()));
+        if (match == match_t::ignored) {
             continue;
+        }
+        auto count = task.child_infos.size();
+        examine(task.child_infos, child.path());
+        if (task.child_infos.size() > count && is_ignored(match, task.child_infos.back().status.type())) {
+            task.child_infos.pop_back();
+        }
+    }
+    ec = {};
+}
+
+static void scan_known_generic(scan_dir_t &task) noexcept {
+    auto &ec = task.ec;
+    auto status = bfs::status(task.path, ec);
+    if (ec) {
+        return;
+    }
+    if (status.type() != bfs::file_type::directory) {
+        ec = sys::errc::make_error_code(sys::errc::not_a_directory);
+        return;
+    }
+    for (auto &name : task.known_children) {
+        auto match = task.match(boost::nowide::narrow(name.generic_wstring()));
+        if (match == match_t::ignored) {
+            continue;
+        }
+        auto count = task.child_infos.size();
+        examine(task.child_infos, task.path / name);
+        if (task.child_infos.size() > count && is_ignored(match, task.child_infos.back().status.type())) {
+            task.child_infos.pop_back();
+        }
+    }
+}
+
+auto scan_dir_t::match(std::string_view name) const noexcept -> match_t {
+    if (!ignores) {
+        return match_t::included;
+    }
+    if (relative_path.empty()) {
+        return ignores->match(name);
+    } else {
+        auto buffer = std::array<char, 256>();
+        auto full_size = relative_path.size() + 1 + name.size();
+        auto full = std::string();
+        auto out = buffer.data();
+        if (full_size > buffer.size()) {
+            full.resize(full_size);
+            out = full.data();
+        }
+        auto end = std::copy(relative_path.begin(), relative_path.end(), out);
+        *end++ = '/';
+        std::copy(name.begin(), name.end(), end);
+        return ignores->match(std::string_view(out, full_size));
+    }
+}
+
+void scan_dir_t::scan() noexcept {
+    ec = {};
+    if (load_ignores) {
+        auto r = read_ignores(path);
+        if (!r) {
+            ec = r.assume_error();
+            return;
+        }
+        ignores = std::move(r.assume_value());
+    }
+#ifdef SYNCSPIRIT_SCAN_GETDENTS
+    auto scanned = pruned ? scan_known_native(*this) : scan_native(*this);
+#else
+    auto scanned = false;
+#endif
+    if (!scanned) {
+        if (pruned) {
+            scan_known_generic(*this);
         } else {
-            auto file_type = status.type();
-            auto is_regular = file_type == FT::regular;
-            auto is_dir = file_type == FT::directory;
-            auto is_link = file_type == FT::symlink;
-            if (!is_regular && !is_dir && !is_link) {
-                continue;
-            }
-            auto &last = child_infos.emplace_back(std::move(child_info));
-            last.status = std::move(status);
+            scan_generic(*this);
+        }
+    }
+    if (!ec) {
+        auto b = child_infos.begin();
+        auto e = child_infos.end();
+        std::sort(b, e, comparator_t());
+    }
+}
 
-            if (is_regular || is_dir) {
-                last.last_write_time = bfs::last_write_time(last.path, ec);
-                if (ec) {
-                    last.ec = ec;
-                    continue;
+void scan_dir_t::scan_ahead(scan_pool_t &pool) noexcept {
+    using tasks_t = std::vector<scan_dir_t *>;
+    auto limit = static_cast<std::size_t>(std::min(prefetch, pool.get_frontier()));
+    // the tasks of the current level are referred by pointers
+    prefetched.reserve(limit);
+
+    auto level = tasks_t{this};
+    auto next = tasks_t{};
+    while (!level.empty() && prefetched.size() < limit) {
+        for (auto dir : level) {
+            for (auto &info : dir->child_infos) {
+                if (prefetched.size() == limit) {
+                    break;
                 }
-            }
-            if (is_regular) {
-                last.size = bfs::file_size(last.path, ec);
-                if (ec) {
-                    last.ec = ec;
-                    continue;
-                }
-            } else if (is_link) {
-                last.target = bfs::read_symlink(last.path, ec);
-                if (ec) {
-                    last.ec = ec;
-                    continue;
+                if (!info.ec && info.status.type() == bfs::file_type::directory) {
+                    auto &task = prefetched.emplace_back(info.path, presentation::presence_ptr_t{}, bfs::path{},
+                                                         notify != 0, recurse != 0, requires_refinement != 0);
+                    auto name = boost::nowide::narrow(info.path.filename().generic_wstring());
+                    task.ignores = dir->ignores;
+                    task.relative_path = dir->relative_path.empty() ? name : dir->relative_path + '/' + name;
+                    next.emplace_back(&task);
                 }
             }
         }
+        pool.scan(next);
+        std::swap(level, next);
+        next.clear();
+    }
+}
+
+bool scan_dir_t::process(fs_slave_t &slave, execution_context_t &context) noexcept {
+    scan();
+    if (ec) {
+        return false;
     }
-    auto b = child_infos.begin();
-    auto e = child_infos.end();
-    std::sort(b, e, comparator_t());
 
     if (notify && context.scan_dir_callback) {
         context.scan_dir_callback(*this);
     }
 
+    if (recurse && prefetch && context.scan_pool) {
+        scan_ahead(*context.scan_pool);
+        if (notify && context.scan_dir_callback) {
+            for (auto &task : prefetched) {
+                if (!task.ec) {
+                    context.scan_dir_callback(task);
+                }
+            }
+        }
+    }
+
     return false;
 }
@@ -5,6 +5,13 @@
 
 #include "task.h"
 #include "presentation/presence.h"
+#include "model/misc/ignores.h"
+
+namespace syncspirit::fs {
+
+struct scan_pool_t;
+
+}
 
 namespace syncspirit::fs::task {
 
@@ -16,18 +23,45 @@ struct SYNCSPIRIT_API scan_dir_t {
         bfs::file_time_type last_write_time = {};
         std::uintmax_t size;
         sys::error_code ec;
+        std::uint64_t device = 0; // the identity of regular files and dirs, if available
+        std::uint64_t inode = 0;
+        std::int64_t ctime_s = 0;
+        std::int32_t ctime_ns = 0;
     };
     using child_infos_t = std::vector<child_info_t>;
+    using prefetched_t = std::vector<scan_dir_t>;
+    using names_t = std::vector<bfs::path>;
 
     scan_dir_t(bfs::path path, presentation::presence_ptr_t presence, bfs::path single_child, bool notify, bool recurse,
                bool requires_refinement) noexcept;
     bool process(fs_slave_t &fs_slave, execution_context_t &context) noexcept;
 
+    /* lists the directory (or examines the known children only), might be
+       invoked from any thread */
+    void scan() noexcept;
+
+    /* scans subdirectories level by level in parallel, until there are no more
+       or the prefetch limit is reached */
+    void scan_ahead(scan_pool_t &pool) noexcept;
+
+    /* reads and compiles .stignore of the folder root, null if there is none */
+    static outcome::result<model::ignores_ptr_t> read_ignores(const bfs::path &root) noexcept;
+
+    /* matches the child, which name is relative to the dir, against the ignores */
+    model::ignores_t::match_t match(std::string_view name) const noexcept;
+
     bfs::path path;
     presentation::presence_ptr_t presence;
     sys::error_code ec;
     child_infos_t child_infos;
     bfs::path single_child;
+    std::uint32_t prefetch = 0;   // max amount of subdirectories to scan ahead
+    prefetched_t prefetched;      // subdirectories scanned ahead, without presences
+    names_t known_children;       // examined instead of listing, if the dir is pruned
+    bool pruned = false;          // the dir is unchanged, missing known children are skipped
+    model::ignores_ptr_t ignores; // ignored children are not examined at all
+    std::string relative_path;    // of the dir, utf-8, empty for the folder root
+    bool load_ignores = false;    // (re)read .stignore of the folder root into ignores
     unsigned notify : 1;
     unsigned recurse : 1;
     unsigned requires_refinement : 1;
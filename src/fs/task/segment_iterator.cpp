@@ -1,16 +1,70 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
+#include "syncspirit-config.h"
 #include "segment_iterator.h"
 #include "hasher/messages.h"
 #include "hasher/hasher_plugin.h"
+#include "fs/io_stats.h"
 #include "fs/utils.h"
+#include "utils/mapped_region.h"
 #include <boost/system/errc.hpp>
+#include <limits>
 #include <memory_resource>
 
+#ifdef SYNCSPIRIT_SEEK_DATA
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace syncspirit::fs;
 using namespace syncspirit::fs::task;
 
+namespace {
+
+// smaller segments are cheaper to read than to map
+constexpr std::int64_t mmap_threshold = 1024 * 1024;
+
+/* locates holes of sparse files, so that they are not read */
+struct holes_detector_t {
+#ifdef SYNCSPIRIT_SEEK_DATA
+    holes_detector_t(const bfs::path &path) noexcept : fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)} {}
+    ~holes_detector_t() {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    }
+
+    bool is_hole(std::int64_t offset, std::int64_t size) noexcept {
+        if (fd == -1) {
+            return false;
+        }
+        if (offset >= next_data) {
+            next_data = ::lseek(fd, static_cast<off_t>(offset), SEEK_DATA);
+            if (next_data == -1) {
+                if (errno != ENXIO) {
+                    // no support by the filesystem, just read everything
+                    ::close(fd);
+                    fd = -1;
+                    return false;
+                }
+                // no data up to the end of the file
+                next_data = std::numeric_limits<std::int64_t>::max();
+            }
+        }
+        return next_data >= offset + size;
+    }
+
+    int fd;
+    std::int64_t next_data = -1;
+#else
+    holes_detector_t(const bfs::path &) noexcept {}
+    bool is_hole(std::int64_t, std::int64_t) noexcept { return false; }
+#endif
+};
+
+} // namespace
+
 segment_iterator_t::segment_iterator_t(const r::address_ptr_t &back_addr_,
                                        hasher::payload::extendended_context_prt_t context_, bfs::path path_,
                                        std::int64_t offset_, std::int32_t block_index_, std::int32_t block_count_,
@@ -29,8 +83,13 @@ bool segment_iterator_t::process(fs_slave_t &fs_slave, execution_context_t &exec
     auto allocator = std::pmr::polymorphic_allocator<char>(&pool);
 
     assert(!ec);
+    auto stats = exec_ctx.io_stats;
     if (!file.has_backend()) {
+        auto started = io_stats_t::now();
         auto opt = file_t::open_read(path);
+        if (stats) {
+            stats->record(io_stats_t::op_t::open, 0, started);
+        }
         if (!opt.has_value()) {
             ec = opt.assume_error();
             return false;
@@ -49,13 +108,43 @@ bool segment_iterator_t::process(fs_slave_t &fs_slave, execution_context_t &exec
         return false;
     }
 
+    auto segment_size = std::int64_t{block_size} * (block_count - 1) + last_block_size;
+    if (!uncached && segment_size >= mmap_threshold) {
+        // the pages are hashed in-place, which also gets the holes for free
+        auto started = io_stats_t::now();
+        if (auto region = utils::mapped_region_t::map(path, offset, segment_size); region) {
+            if (stats) {
+                // the actual reads are page faults in hashers, only the mapping is accounted
+                stats->record(io_stats_t::op_t::read, static_cast<std::uint64_t>(segment_size), started);
+            }
+            for (std::int32_t i = block_index, j = 0; j < block_count; ++i, ++j) {
+                auto bs = (j + 1 == block_count) ? last_block_size : block_size;
+                auto off = offset + std::int64_t{block_size} * j;
+                auto data = region->view(static_cast<std::uint64_t>(off), static_cast<std::uint64_t>(bs));
+                exec_ctx.plugin->calc_digest(region, data, i, back_addr, context);
+            }
+            current_block = block_count;
+            return false;
+        }
+    }
+
     auto byte_chunks = byte_chunks_t(allocator);
+    auto holes = holes_detector_t(path);
 
     for (std::int32_t j = 0; j < block_count && !ec; ++j) {
         auto bs = (j + 1 == block_count) ? last_block_size : block_size;
         auto off = offset + std::int64_t{block_size} * j;
+        if (holes.is_hole(off, bs)) {
+            ++current_block;
+            byte_chunks.emplace_back(utils::bytes_t(static_cast<std::size_t>(bs)));
+            continue;
+        }
+        auto started = io_stats_t::now();
         auto block_opt = file.read(off, bs);
         ++current_block;
+        if (stats) {
+            stats->record(io_stats_t::op_t::read, block_opt ? static_cast<std::uint64_t>(bs) : 0, started);
+        }
         if (!block_opt) {
             if (errno) {
                 ec = sys::error_code{errno, sys::system_category()};
@@ -69,6 +158,10 @@ bool segment_iterator_t::process(fs_slave_t &fs_slave, execution_context_t &exec
         }
     }
 
+    if (uncached) {
+        file.drop_cache(static_cast<std::uint64_t>(offset), static_cast<std::uint64_t>(segment_size));
+    }
+
     for (std::int32_t i = block_index, j = 0; j < block_count && !ec; ++i, ++j) {
         auto &bytes = byte_chunks[j];
         exec_ctx.plugin->calc_digest(std::move(bytes), i, back_addr, context);
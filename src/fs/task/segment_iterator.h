@@ -26,6 +26,7 @@ struct SYNCSPIRIT_API segment_iterator_t {
     sys::error_code ec;
     file_t file;
     std::int32_t current_block = 0;
+    bool uncached = false;
     hasher::payload::extendended_context_prt_t context;
 };
 
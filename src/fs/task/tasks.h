@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "load_journal.h"
 #include "noop.h"
 #include "remove_file.h"
 #include "rename_file.h"
@@ -12,8 +13,8 @@
 
 namespace syncspirit::fs {
 
-using task_t =
-    std::variant<task::scan_dir_t, task::segment_iterator_t, task::remove_file_t, task::rename_file_t, task::noop_t>;
+using task_t = std::variant<task::scan_dir_t, task::segment_iterator_t, task::remove_file_t, task::rename_file_t,
+                            task::load_journal_t, task::noop_t>;
 using tasks_t = std::list<task_t>;
 
 } // namespace syncspirit::fs
@@ -8,6 +8,8 @@ namespace syncspirit::fs {
 
 const std::string_view tmp_suffix = ".syncspirit-tmp";
 const std::wstring_view tmp_wsuffix = L".syncspirit-tmp";
+// the journal is a temporal file too, i.e. it is ignored by watchers
+const std::string_view journal_suffix = ".syncspirit-journal.syncspirit-tmp";
 
 template <typename T> struct tmp_suffix_t;
 
@@ -37,30 +39,31 @@ const std::int32_t *block_sizes = _block_sizes;
 
 static const constexpr size_t max_blocks_count = 2000;
 
+/* the smallest block size, which gives no more than max_blocks_count blocks,
+ * i.e. files larger than 256MiB have 1000..2000 blocks (up to 16MiB blocks).
+ *
+ * The previous block size is retained, if it is adjacent to the desired one,
+ * so the block size of a growing (or shrinking) file does not flip around the
+ * boundaries, and the unchanged blocks can still be reused. */
 block_division_t get_block_size(int64_t sz, int32_t prev_size) noexcept {
-    auto bs = std::int64_t{0};
-    if (block_sizes[0] <= sz) {
-        for (size_t i = 0; i < block_sizes_sz; ++i) {
-            if (block_sizes[i] == prev_size) {
-                bs = prev_size;
-                break;
-            }
-        }
+    auto index = size_t{0};
+    while (index + 1 < block_sizes_sz && block_sizes[index] * static_cast<std::int64_t>(max_blocks_count) < sz) {
+        ++index;
     }
+    auto bs = std::int64_t{block_sizes[index]};
 
-    if (!bs) {
+    if (prev_size && block_sizes[0] <= sz) {
         for (size_t i = 0; i < block_sizes_sz; ++i) {
-            if (block_sizes[i] * static_cast<std::int64_t>(max_blocks_count) >= sz) {
-                bs = block_sizes[i];
-                if (bs > sz) {
-                    bs = sz;
+            if (block_sizes[i] == prev_size) {
+                if (i + 1 >= index && i <= index + 1) {
+                    bs = prev_size;
                 }
                 break;
             }
         }
     }
-    if (bs == 0 && sz) {
-        bs = block_sizes[block_sizes_sz - 1];
+    if (bs > sz) {
+        bs = sz;
     }
 
     auto count = std::int32_t{0};
@@ -80,11 +83,11 @@ bfs::path make_temporal(const bfs::path &path) noexcept {
     return copy;
 }
 
-template <typename T> static bool _is_temporal(const T *ptr, const T *end) {
-    if ((end - ptr) >= tmp_suffix.size()) {
-        auto ptr_1 = end - tmp_suffix.size();
-        auto ptr_2 = tmp_suffix.data();
-        for (size_t i = 0; i < tmp_suffix.size(); ++i, ++ptr_1, ++ptr_2) {
+template <typename T> static bool _has_suffix(const T *ptr, const T *end, std::string_view suffix) {
+    if ((end - ptr) >= suffix.size()) {
+        auto ptr_1 = end - suffix.size();
+        auto ptr_2 = suffix.data();
+        for (size_t i = 0; i < suffix.size(); ++i, ++ptr_1, ++ptr_2) {
             if (*ptr_1 != *ptr_2) {
                 return false;
             }
@@ -96,10 +99,23 @@ template <typename T> static bool _is_temporal(const T *ptr, const T *end) {
 
 bool is_temporal(const bfs::path &path) noexcept {
     auto &str = path.native();
-    return _is_temporal(str.data(), str.data() + str.size());
+    return _has_suffix(str.data(), str.data() + str.size(), tmp_suffix);
+}
+
+bool is_temporal(const std::string_view path) noexcept {
+    return _has_suffix(path.data(), path.data() + path.size(), tmp_suffix);
 }
 
-bool is_temporal(const std::string_view path) noexcept { return _is_temporal(path.data(), path.data() + path.size()); }
+bfs::path make_journal(const bfs::path &path) noexcept {
+    auto copy = path;
+    copy += journal_suffix.data();
+    return copy;
+}
+
+bool is_journal(const bfs::path &path) noexcept {
+    auto &str = path.native();
+    return _has_suffix(str.data(), str.data() + str.size(), journal_suffix);
+}
 
 bfs::path relativize(const bfs::path &path, const bfs::path &root) noexcept {
     auto it_path = path.begin();
@@ -26,6 +26,8 @@ struct block_division_t {
 SYNCSPIRIT_API bfs::path make_temporal(const bfs::path &path) noexcept;
 SYNCSPIRIT_API bool is_temporal(const bfs::path &path) noexcept;
 SYNCSPIRIT_API bool is_temporal(const std::string_view path) noexcept;
+SYNCSPIRIT_API bfs::path make_journal(const bfs::path &path) noexcept;
+SYNCSPIRIT_API bool is_journal(const bfs::path &path) noexcept;
 SYNCSPIRIT_API block_division_t get_block_size(int64_t file_size, int32_t prev_size) noexcept;
 SYNCSPIRIT_API bfs::path relativize(const bfs::path &path, const bfs::path &root) noexcept;
 SYNCSPIRIT_API std::int64_t to_unix(const fs_time_t &at);
@@ -34,6 +36,7 @@ SYNCSPIRIT_API fs_time_t from_unix(std::int64_t at);
 SYNCSPIRIT_API extern const std::size_t block_sizes_sz;
 SYNCSPIRIT_API extern const std::int32_t *block_sizes;
 SYNCSPIRIT_API extern const std::string_view tmp_suffix;
+SYNCSPIRIT_API extern const std::string_view journal_suffix;
 
 } // namespace fs
 } // namespace syncspirit
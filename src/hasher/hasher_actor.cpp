@@ -34,9 +34,29 @@ void hasher_actor_t::shutdown_finish() noexcept {
 void hasher_actor_t::on_digest(message::digest_t &req) noexcept {
 
     unsigned char digest[SZ];
-    auto &data = req.payload.data;
+    auto &p = req.payload;
+    auto data = p.get_data();
     LOG_TRACE(log, "on_digest ({} bytes)", data.size());
 
-    utils::digest(data.data(), data.size(), digest);
-    req.payload.result = utils::bytes_t(digest, digest + SZ);
+    if (p.region) {
+        // the hashing might be interrupted by SIGBUS, so everything is allocated beforehand
+        if (!sha256.init()) {
+            p.result = utils::make_error_code(utils::error_code_t::tls_sha256_init_failure);
+            return;
+        }
+        auto ok = true;
+        auto hash = [&]() { ok = sha256.update(data.data(), data.size()); };
+        if (!utils::mapped_region_t::access(hash)) {
+            LOG_WARN(log, "mapped file has been truncated during hashing");
+            p.result = utils::make_error_code(utils::error_code_t::concurrent_file_modification);
+            return;
+        }
+        if (!ok || !sha256.final(digest)) {
+            p.result = utils::make_error_code(utils::error_code_t::tls_sha256_failure);
+            return;
+        }
+    } else {
+        utils::digest(data.data(), data.size(), digest);
+    }
+    p.result = utils::bytes_t(digest, digest + SZ);
 }
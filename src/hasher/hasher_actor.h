@@ -4,6 +4,7 @@
 #pragma once
 
 #include "utils/log.h"
+#include "utils/tls.h"
 #include "messages.h"
 #include "syncspirit-export.h"
 
@@ -42,6 +43,7 @@ struct SYNCSPIRIT_API hasher_actor_t : public r::actor_base_t {
 
     utils::logger_t log;
     uint32_t index;
+    utils::sha256_t sha256; // for the mapped regions
 };
 
 } // namespace hasher
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #include "hasher_plugin.h"
 #include "messages.h"
@@ -45,8 +45,7 @@ void hasher_plugin_t::configure_hashers(std::uint32_t number) noexcept {
     }
 }
 
-void hasher_plugin_t::calc_digest(utils::bytes_t data, std::int32_t block_index, const r::address_ptr_t &reply_back,
-                                  payload::extendended_context_prt_t context) noexcept {
+auto hasher_plugin_t::pick_hasher(std::size_t bytes) noexcept -> const r::address_ptr_t & {
     static constexpr auto LIMIT = std::numeric_limits<int>::max();
     assert(hashers.size());
     int min_index;
@@ -63,11 +62,23 @@ void hasher_plugin_t::calc_digest(utils::bytes_t data, std::int32_t block_index,
         }
         assert(min_index >= 0);
         min_usage = min_value;
-        usages[min_index] += static_cast<std::int32_t>(data.size());
+        usages[min_index] += static_cast<std::int32_t>(bytes);
     } else {
         min_index = 0;
     }
     assert(min_index >= 0);
-    auto &addr = hashers[min_index];
+    return hashers[min_index];
+}
+
+void hasher_plugin_t::calc_digest(utils::bytes_t data, std::int32_t block_index, const r::address_ptr_t &reply_back,
+                                  payload::extendended_context_prt_t context) noexcept {
+    auto &addr = pick_hasher(data.size());
     actor->route<payload::digest_t>(addr, reply_back, std::move(data), block_index, std::move(context));
 }
+
+void hasher_plugin_t::calc_digest(utils::mapped_region_ptr_t region, utils::bytes_view_t data,
+                                  std::int32_t block_index, const r::address_ptr_t &reply_back,
+                                  payload::extendended_context_prt_t context) noexcept {
+    auto &addr = pick_hasher(data.size());
+    actor->route<payload::digest_t>(addr, reply_back, std::move(region), data, block_index, std::move(context));
+}
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #pragma once
 
@@ -32,7 +32,13 @@ struct SYNCSPIRIT_API hasher_plugin_t : public r::plugin::registry_plugin_t {
     void calc_digest(utils::bytes_t data, std::int32_t block_index, const r::address_ptr_t &reply_back,
                      payload::extendended_context_prt_t context = {}) noexcept;
 
+    /* hashes the data right from the mapped file pages, i.e. without copying them */
+    void calc_digest(utils::mapped_region_ptr_t region, utils::bytes_view_t data, std::int32_t block_index,
+                     const r::address_ptr_t &reply_back, payload::extendended_context_prt_t context = {}) noexcept;
+
   private:
+    const r::address_ptr_t &pick_hasher(std::size_t bytes) noexcept;
+
     using hashers_t = std::vector<r::address_ptr_t>;
     using usages_t = std::vector<std::int32_t>;
     hashers_t hashers;
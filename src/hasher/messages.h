@@ -1,10 +1,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
 #include "utils/bytes.h"
 #include "utils/error_code.h"
+#include "utils/mapped_region.h"
 
 #include <rotor.hpp>
 #include <boost/outcome.hpp>
@@ -25,6 +26,8 @@ using extendended_context_prt_t = boost::intrusive_ptr<extendended_context_t>;
 
 struct digest_t {
     utils::bytes_t data;
+    utils::mapped_region_ptr_t region; // when set, file pages are hashed instead of data
+    utils::bytes_view_t mapped;
     std::int32_t block_index;
     extendended_context_prt_t context;
     r::address_ptr_t back_addr;
@@ -34,8 +37,17 @@ struct digest_t {
     digest_t(utils::bytes_view_t data_, std::int32_t block_index_, extendended_context_prt_t context_ = {}) noexcept
         : data{std::move(data_)}, block_index{block_index_},
           result{utils::make_error_code(utils::error_code_t::no_action)}, context{std::move(context_)} {}
+    digest_t(utils::bytes_t &&data_, std::int32_t block_index_, extendended_context_prt_t context_ = {}) noexcept
+        : data{std::move(data_)}, block_index{block_index_},
+          result{utils::make_error_code(utils::error_code_t::no_action)}, context{std::move(context_)} {}
+    digest_t(utils::mapped_region_ptr_t region_, utils::bytes_view_t mapped_, std::int32_t block_index_,
+             extendended_context_prt_t context_ = {}) noexcept
+        : region{std::move(region_)}, mapped{mapped_}, block_index{block_index_},
+          result{utils::make_error_code(utils::error_code_t::no_action)}, context{std::move(context_)} {}
     digest_t(const digest_t &) = delete;
     digest_t(digest_t &&) noexcept = default;
+
+    inline utils::bytes_view_t get_data() const noexcept { return region ? mapped : utils::bytes_view_t(data); }
 };
 
 } // namespace payload
@@ -1,12 +1,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "block_info.h"
 #include "file_info.h"
 #include "proto/proto-helpers.h"
 #include "db/prefix.h"
 #include "misc/error_code.h"
+#include "utils/tls.h"
 #include <spdlog/spdlog.h>
+#include <mutex>
 
 namespace syncspirit::model {
 
@@ -234,6 +236,35 @@ std::uint32_t block_info_t::refcouner_dec() const noexcept {
 
 std::uint32_t block_info_t::use_count() const noexcept { return counter & COUNTER_MASK; }
 
+bool block_info_t::is_zero() const noexcept {
+    // bep block sizes are 128KiB .. 16MiB, powers of 2
+    static constexpr std::uint32_t min_size = 128 * 1024;
+    static constexpr std::size_t sizes_count = 8;
+    static std::once_flag flags[sizes_count];
+    static unsigned char hashes[sizes_count][digest_length];
+
+    auto sz = static_cast<std::uint32_t>(size);
+    if (sz < min_size || (sz & (sz - 1))) {
+        return false;
+    }
+    auto index = std::size_t{0};
+    for (auto s = min_size; s < sz; s <<= 1) {
+        ++index;
+    }
+    if (index >= sizes_count) {
+        return false;
+    }
+    std::call_once(flags[index], [&]() {
+        auto zeroes = utils::bytes_t(sz);
+        auto digest = utils::sha256_digest(zeroes);
+        if (digest) {
+            auto &bytes = digest.assume_value();
+            std::copy(bytes.begin(), bytes.end(), hashes[index]);
+        }
+    });
+    return std::equal(hash, hash + digest_length, hashes[index]);
+}
+
 block_info_ptr_t block_infos_map_t::by_hash(utils::bytes_view_t hash) const noexcept {
     auto &proj = get<0>();
     auto it = proj.find(hash);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -63,6 +63,10 @@ struct SYNCSPIRIT_API block_info_t {
 
     inline utils::bytes_view_t get_hash() const noexcept { return utils::bytes_view_t(hash, digest_length); }
     inline std::uint32_t get_size() const noexcept { return size; }
+
+    /* whether the block is a standard-sized one consisting of zeroes only,
+     * i.e. it can be reproduced locally without fetching */
+    bool is_zero() const noexcept;
     std::uint32_t usages() const noexcept;
 
     file_blocks_iterator_t iterate_blocks(std::uint32_t start_index = 0) const;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "cluster.h"
 #include "proto/proto-helpers.h"
@@ -70,6 +70,77 @@ path_guard_t cluster_t::lock(path_t *path) noexcept {
     return guard;
 }
 
+static const folder_info_t *find_active_folder_info(const folders_map_t &folders, utils::bytes_view_t uuid) noexcept {
+    for (auto &folder_it : folders) {
+        auto &folder = *folder_it.item;
+        if (auto fi = folder.get_folder_infos().by_uuid(uuid); fi) {
+            return folder.is_suspended() ? nullptr : fi.get();
+        }
+    }
+    return nullptr;
+}
+
+block_source_t cluster_t::find_block_source(const block_info_t &block) const noexcept {
+    auto r = block_source_t{};
+    auto it = block.iterate_blocks();
+    while (auto fb = it.next()) {
+        if (!fb->is_locally_available()) {
+            continue;
+        }
+        auto file = fb->file();
+        auto complete = file->is_locally_available();
+        if (r && (r.complete || !complete)) {
+            continue;
+        }
+        auto folder_info = find_active_folder_info(folders, file->get_folder_uuid());
+        if (!folder_info) {
+            continue;
+        }
+        complete = complete && folder_info->get_device() == device.get();
+        if (!r || (complete && !r.complete)) {
+            auto block_index = fb->block_index();
+            r = block_source_t{file, folder_info, block_index, file->get_block_offset(block_index), complete};
+            if (complete) {
+                break;
+            }
+        }
+    }
+    return r;
+}
+
+block_source_t cluster_t::find_file_source(const file_info_t &file) const noexcept {
+    auto blocks_count = file.iterate_blocks().get_total();
+    if (!blocks_count) {
+        return {};
+    }
+    auto first_block = file.iterate_blocks().next();
+    auto file_size = file.get_size();
+    auto it = first_block->iterate_blocks();
+    while (auto fb = it.next()) {
+        auto candidate = fb->file();
+        if (candidate == &file || fb->block_index() != 0 || candidate->get_size() != file_size) {
+            continue;
+        }
+        if (!candidate->is_locally_available() || candidate->iterate_blocks().get_total() != blocks_count) {
+            continue;
+        }
+        auto mine = file.iterate_blocks(1);
+        auto theirs = candidate->iterate_blocks(1);
+        auto same = true;
+        for (auto b = mine.next(); b && same; b = mine.next()) {
+            same = b == theirs.next();
+        }
+        if (!same) {
+            continue;
+        }
+        auto folder_info = find_active_folder_info(folders, candidate->get_folder_uuid());
+        if (folder_info && folder_info->get_device() == device.get()) {
+            return block_source_t{candidate, folder_info, 0, 0, true};
+        }
+    }
+    return {};
+}
+
 void cluster_t::modify_write_requests(int32_t delta) noexcept {
     write_requests += delta;
     assert(write_requests >= 0);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -31,6 +31,16 @@ struct SYNCSPIRIT_API path_guard_t {
     cluster_t *cluster = {};
 };
 
+struct SYNCSPIRIT_API block_source_t {
+    inline explicit operator bool() const noexcept { return file; }
+
+    const file_info_t *file = nullptr;
+    const folder_info_t *folder_info = nullptr;
+    std::uint32_t block_index = 0;
+    std::uint64_t offset = 0;
+    bool complete = false;
+};
+
 struct SYNCSPIRIT_API cluster_t final : arc_base_t<cluster_t> {
     cluster_t(device_ptr_t device_, int32_t write_requests) noexcept;
     cluster_t(const cluster_t &) = delete;
@@ -59,6 +69,15 @@ struct SYNCSPIRIT_API cluster_t final : arc_base_t<cluster_t> {
     path_guard_t lock(path_t *path) noexcept;
     bool is_locked(path_t *path) noexcept;
 
+    /* returns the best locally readable copy of the block among all folders;
+     * completely synchronized local files are preferred over partially
+     * downloaded ones (they are readable only from temporal files) */
+    block_source_t find_block_source(const block_info_t &block) const noexcept;
+
+    /* returns a completely synchronized local file with exactly the same
+     * content (i.e. blocks), which can be cloned as whole */
+    block_source_t find_file_source(const file_info_t &file) const noexcept;
+
   private:
     struct path_hasher_t {
         using is_transparent = void;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "advance.h"
 #include "remote_copy.h"
@@ -43,8 +43,9 @@ auto advance_t::create(advance_action_t action, const model::file_info_t &source
 }
 
 advance_t::advance_t(std::string_view folder_id_, utils::bytes_view_t peer_id_, advance_action_t action_,
-                     bool disable_blocks_removal_) noexcept
-    : folder_id{folder_id_}, action{action_}, disable_blocks_removal{disable_blocks_removal_} {
+                     bool disable_blocks_removal_, bool readd_blocks_) noexcept
+    : folder_id{folder_id_}, action{action_}, disable_blocks_removal{disable_blocks_removal_},
+      readd_blocks{readd_blocks_} {
     peer_id = utils::bytes_t(peer_id_.begin(), peer_id_.end());
 }
 
@@ -88,9 +89,11 @@ void advance_t::initialize(const cluster_t &cluster, sequencer_t &sequencer, pro
             auto h = proto::get_hash(proto_block);
             auto strict_hash = block_info_t::make_strict_hash(h);
             auto block = blocks_map.by_hash(strict_hash.get_hash());
-            if (!block) {
+            if (!block || readd_blocks) {
+                // known blocks might be orphaned by a preceding, not yet applied, diff
                 new_blocks.push_back(proto_block);
-            } else {
+            }
+            if (block) {
                 auto it = orphans.find(strict_hash.get_hash());
                 if (it != orphans.end()) {
                     orphans.erase(it);
@@ -177,6 +180,10 @@ auto advance_t::apply_impl(apply_controller_t &controller, void *custom) const n
         }
     }
 
+    if (local_stat) {
+        local_file->set_local_stat(local_stat);
+    }
+
     auto sequence = local_folder->get_max_sequence() + 1;
     local_file->mark_local(true);
     local_file->set_sequence(sequence);
@@ -185,6 +192,8 @@ auto advance_t::apply_impl(apply_controller_t &controller, void *custom) const n
     LOG_TRACE(log, "advance_t ({}), file: '{}', size: {}, blocks: {}, seq.: {}", stringify(action), *local_file, size,
               proto::get_blocks_size(proto_local), sequence);
 
+    // re-queue (or drop) the corresponding peer files in the pull iterators
+    local_file->recheck(*local_folder);
     local_file->notify_update();
 
     return applicator_t::apply_sibling(controller, custom);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -23,12 +23,14 @@ struct SYNCSPIRIT_API advance_t : cluster_diff_t {
     std::string folder_id;
     utils::bytes_t peer_id;
     bu::uuid uuid;
+    local_stat_t local_stat; // of the scanned local file, if known
     advance_action_t action;
     bool disable_blocks_removal;
+    bool readd_blocks;
 
   protected:
     advance_t(std::string_view folder_id, utils::bytes_view_t peer_id, advance_action_t action,
-              bool disable_blocks_removal = false) noexcept;
+              bool disable_blocks_removal = false, bool readd_blocks = false) noexcept;
     void initialize(const cluster_t &cluster, sequencer_t &sequencer, proto::FileInfo proto_source,
                     std::string_view local_file_name) noexcept;
 };
@@ -11,9 +11,9 @@
 using namespace syncspirit::model::diff::advance;
 
 local_update_t::local_update_t(const cluster_t &cluster, sequencer_t &sequencer, proto::FileInfo proto_file_,
-                               std::string_view folder_id_, bool disable_blocks_removal_) noexcept
+                               std::string_view folder_id_, bool disable_blocks_removal_, bool readd_blocks_) noexcept
     : advance_t(folder_id_, cluster.get_device()->device_id().get_sha256(), advance_action_t::local_update,
-                disable_blocks_removal_) {
+                disable_blocks_removal_, readd_blocks_) {
 
     auto buffer = std::array<std::byte, 256>();
     auto pool = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
@@ -42,15 +42,15 @@ local_update_t::local_update_t(const cluster_t &cluster, sequencer_t &sequencer,
         if (local_file) {
             version = local_file->get_version();
             version.update(device);
-            if (disable_blocks_removal) {
-                assign(uuid, local_file->get_uuid());
-            }
         } else {
             version = version_t(device);
         }
         auto &proto_version = proto::get_version(proto_local);
         version.to_proto(proto_version);
     }
+    if (local_file && disable_blocks_removal) {
+        assign(uuid, local_file->get_uuid());
+    }
 }
 
 auto local_update_t::get_original(const model::folder_infos_map_t &fis, const model::device_t &self,
@@ -13,7 +13,7 @@ struct SYNCSPIRIT_API local_update_t : advance_t {
     using parent_t::parent_t;
 
     local_update_t(const cluster_t &cluster, sequencer_t &sequencer, proto::FileInfo proto_file,
-                   std::string_view folder_id, bool disable_blocks_removal = false) noexcept;
+                   std::string_view folder_id, bool disable_blocks_removal = false, bool readd_blocks = false) noexcept;
 
     outcome::result<void> apply_impl(apply_controller_t &, void *) const noexcept override;
     outcome::result<void> visit(cluster_visitor_t &, void *) const noexcept override;
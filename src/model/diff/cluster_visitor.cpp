@@ -20,11 +20,14 @@
 #include "load/pending_devices.h"
 #include "load/remove_corrupted_files.h"
 #include "local/blocks_availability.h"
+#include "local/ignores_update.h"
 #include "local/io_failure.h"
+#include "local/io_stats.h"
 #include "local/file_availability.h"
 #include "local/scan_finish.h"
 #include "local/scan_request.h"
 #include "local/scan_start.h"
+#include "local/stat_update.h"
 #include "local/synchronization_finish.h"
 #include "local/synchronization_start.h"
 #include "modify/add_blocks.h"
@@ -145,10 +148,19 @@ auto cluster_visitor_t::operator()(const local::file_availability_t &diff, void
     return diff.visit_next(*this, custom);
 }
 
+auto cluster_visitor_t::operator()(const local::ignores_update_t &diff, void *custom) noexcept
+    -> outcome::result<void> {
+    return diff.visit_next(*this, custom);
+}
+
 auto cluster_visitor_t::operator()(const local::io_failure_t &diff, void *custom) noexcept -> outcome::result<void> {
     return diff.visit_next(*this, custom);
 }
 
+auto cluster_visitor_t::operator()(const local::io_stats_t &diff, void *custom) noexcept -> outcome::result<void> {
+    return diff.visit_next(*this, custom);
+}
+
 auto cluster_visitor_t::operator()(const local::scan_finish_t &diff, void *custom) noexcept -> outcome::result<void> {
     return diff.visit_next(*this, custom);
 }
@@ -161,6 +173,10 @@ auto cluster_visitor_t::operator()(const local::scan_start_t &diff, void *custom
     return diff.visit_next(*this, custom);
 }
 
+auto cluster_visitor_t::operator()(const local::stat_update_t &diff, void *custom) noexcept -> outcome::result<void> {
+    return diff.visit_next(*this, custom);
+}
+
 auto cluster_visitor_t::operator()(const local::synchronization_start_t &diff, void *custom) noexcept
     -> outcome::result<void> {
     return diff.visit_next(*this, custom);
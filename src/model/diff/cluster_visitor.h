@@ -35,10 +35,13 @@ struct SYNCSPIRIT_API cluster_visitor_t {
 
     virtual outcome::result<void> operator()(const local::blocks_availability_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::file_availability_t &, void *custom) noexcept;
+    virtual outcome::result<void> operator()(const local::ignores_update_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::io_failure_t &, void *custom) noexcept;
+    virtual outcome::result<void> operator()(const local::io_stats_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::scan_finish_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::scan_request_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::scan_start_t &, void *custom) noexcept;
+    virtual outcome::result<void> operator()(const local::stat_update_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::synchronization_start_t &, void *custom) noexcept;
     virtual outcome::result<void> operator()(const local::synchronization_finish_t &, void *custom) noexcept;
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -39,10 +39,13 @@ struct pending_devices_t;
 namespace local {
 struct blocks_availability_t;
 struct file_availability_t;
+struct ignores_update_t;
 struct io_failure_t;
+struct io_stats_t;
 struct scan_finish_t;
 struct scan_request_t;
 struct scan_start_t;
+struct stat_update_t;
 struct synchronization_start_t;
 struct synchronization_finish_t;
 } // namespace local
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "ignores_update.h"
+#include "model/cluster.h"
+#include "model/diff/apply_controller.h"
+#include "model/diff/cluster_visitor.h"
+#include "model/misc/file_iterator.h"
+
+using namespace syncspirit::model::diff::local;
+
+ignores_update_t::ignores_update_t(std::string_view folder_id_, model::ignores_ptr_t ignores_) noexcept
+    : folder_id{folder_id_}, ignores{std::move(ignores_)} {
+    LOG_DEBUG(log, "ignores_update_t, folder = {}, patterns = {}", folder_id, ignores ? ignores->size() : 0);
+}
+
+auto ignores_update_t::apply_impl(apply_controller_t &controller, void *custom) const noexcept
+    -> outcome::result<void> {
+    auto &cluster = controller.get_cluster();
+    if (auto folder = cluster.get_folders().by_id(folder_id); folder) {
+        folder->set_ignores(ignores);
+        for (auto it : cluster.get_devices()) {
+            auto &device = *it.item;
+            if (&device != cluster.get_device().get() && folder->is_shared_with(device)) {
+                if (auto iterator = device.get_iterator(); iterator) {
+                    iterator->reset(*folder);
+                }
+            }
+        }
+    }
+    return applicator_t::apply_sibling(controller, custom);
+}
+
+auto ignores_update_t::visit(cluster_visitor_t &visitor, void *custom) const noexcept -> outcome::result<void> {
+    LOG_TRACE(log, "visiting ignores_update_t, folder: {}", folder_id);
+    return visitor(*this, custom);
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include <string>
+#include "model/misc/ignores.h"
+#include "../cluster_diff.h"
+
+namespace syncspirit::model::diff::local {
+
+/* the (re)loaded .stignore patterns of the folder, null if there are none;
+   the peer files of the folder are re-evaluated for pulling */
+struct SYNCSPIRIT_API ignores_update_t final : cluster_diff_t {
+    ignores_update_t(std::string_view folder_id, model::ignores_ptr_t ignores) noexcept;
+
+    outcome::result<void> apply_impl(apply_controller_t &, void *) const noexcept override;
+    outcome::result<void> visit(cluster_visitor_t &, void *) const noexcept override;
+
+    std::string folder_id;
+    model::ignores_ptr_t ignores;
+};
+
+} // namespace syncspirit::model::diff::local
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "io_stats.h"
+#include "model/cluster.h"
+#include "model/diff/apply_controller.h"
+#include "model/diff/cluster_visitor.h"
+
+using namespace syncspirit::model::diff::local;
+
+io_stats_t::io_stats_t(folders_io_t folders_) noexcept : folders{std::move(folders_)} {}
+
+auto io_stats_t::apply_impl(apply_controller_t &controller, void *custom) const noexcept -> outcome::result<void> {
+    auto &cluster = controller.get_cluster();
+    auto &folders_map = cluster.get_folders();
+    for (auto &[folder_id, counters] : folders) {
+        auto folder = folders_map.by_id(folder_id);
+        if (!folder) {
+            // might be already removed
+            continue;
+        }
+        auto &totals = folder->get_io_counters();
+        for (auto &[operation, counter] : counters) {
+            auto &total = totals[operation];
+            total.count += counter.count;
+            total.bytes += counter.bytes;
+            total.total_us += counter.total_us;
+            total.p99_us = counter.p99_us;
+            total.max_us = counter.max_us;
+        }
+        if (auto local_folder = folder->get_folder_infos().by_device(*cluster.get_device()); local_folder) {
+            local_folder->notify_update();
+        }
+        folder->notify_update();
+    }
+    return applicator_t::apply_sibling(controller, custom);
+}
+
+auto io_stats_t::visit(cluster_visitor_t &visitor, void *custom) const noexcept -> outcome::result<void> {
+    LOG_TRACE(log, "visiting io_stats_t");
+    return visitor(*this, custom);
+}
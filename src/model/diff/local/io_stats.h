@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "../cluster_diff.h"
+#include "model/folder.h"
+#include <string>
+#include <vector>
+
+namespace syncspirit::model::diff::local {
+
+struct folder_io_t {
+    std::string folder_id;
+    folder_t::io_counters_t counters; // since the previous report
+};
+
+using folders_io_t = std::vector<folder_io_t>;
+
+struct SYNCSPIRIT_API io_stats_t final : cluster_diff_t {
+    io_stats_t(folders_io_t folders) noexcept;
+
+    outcome::result<void> apply_impl(apply_controller_t &, void *) const noexcept override;
+    outcome::result<void> visit(cluster_visitor_t &, void *) const noexcept override;
+
+    folders_io_t folders;
+};
+
+} // namespace syncspirit::model::diff::local
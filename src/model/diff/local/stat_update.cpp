@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "stat_update.h"
+#include "model/diff/apply_controller.h"
+#include "model/diff/cluster_visitor.h"
+#include "utils/format.hpp"
+
+using namespace syncspirit::model::diff::local;
+
+stat_update_t::stat_update_t(const model::file_info_t &file, const folder_info_t &fi,
+                             const local_stat_t &local_stat_) noexcept
+    : local_stat{local_stat_} {
+    LOG_DEBUG(log, "stat_update_t, file: {}, inode: {}", file, local_stat.inode);
+    folder_id = fi.get_folder()->get_id();
+    name = file.get_name()->get_full_name();
+    version = file.get_version();
+}
+
+auto stat_update_t::apply_impl(apply_controller_t &controller, void *custom) const noexcept -> outcome::result<void> {
+    auto &cluster = controller.get_cluster();
+    auto folder = cluster.get_folders().by_id(folder_id);
+    if (folder) {
+        auto &folder_info = *folder->get_folder_infos().by_device(*cluster.get_device());
+        auto f = folder_info.get_file_infos().by_name(name);
+        if (f && f->get_version().identical_to(version)) {
+            LOG_TRACE(log, "stat_update_t, file '{}', inode = {}", name, local_stat.inode);
+            f->set_local_stat(local_stat);
+        }
+    }
+    return applicator_t::apply_sibling(controller, custom);
+}
+
+auto stat_update_t::visit(cluster_visitor_t &visitor, void *custom) const noexcept -> outcome::result<void> {
+    LOG_TRACE(log, "visiting stat_update_t, file: '{}'", name);
+    return visitor(*this, custom);
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "model/cluster.h"
+#include "../cluster_diff.h"
+#include "../cluster_visitor.h"
+
+namespace syncspirit::model::diff::local {
+
+/* remembers the on-disk identity of an unchanged local file (or directory),
+   i.e. when it has not been known yet or it has been changed without content
+   changes */
+struct SYNCSPIRIT_API stat_update_t final : cluster_diff_t {
+
+    stat_update_t(const model::file_info_t &file, const folder_info_t &fi, const local_stat_t &local_stat) noexcept;
+
+    outcome::result<void> apply_impl(apply_controller_t &, void *) const noexcept override;
+    outcome::result<void> visit(cluster_visitor_t &, void *) const noexcept override;
+
+    std::string folder_id;
+    std::string name;
+    model::version_t version;
+    local_stat_t local_stat;
+};
+
+} // namespace syncspirit::model::diff::local
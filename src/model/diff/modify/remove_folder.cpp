@@ -44,6 +44,8 @@ remove_folder_t::remove_folder_t(const model::cluster_t &cluster, model::sequenc
             db::set_path(db_f, folder.get_path().string());
             db::set_folder_type(db_f, folder.get_folder_type());
             db::set_pull_order(db_f, folder.get_pull_order());
+            db::set_pull_priority(db_f, folder.get_pull_priority());
+            db::set_pull_weight(db_f, folder.get_pull_weight());
 
             auto sha256 = d->device_id().get_sha256();
             auto peer_id = utils::bytes_t{sha256.begin(), sha256.end()};
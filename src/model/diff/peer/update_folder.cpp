@@ -57,6 +57,7 @@ auto update_folder_t::apply_impl(apply_controller_t &controller, void *custom) c
 
     auto max_seq = folder_info->get_max_sequence();
     auto &fm = folder_info->get_file_infos();
+    auto iterator = folder_info->get_device()->get_iterator();
 
     for (std::size_t i = 0; i < files.size(); ++i) {
         auto &f = files[i];
@@ -86,6 +87,9 @@ auto update_folder_t::apply_impl(apply_controller_t &controller, void *custom) c
             auto prev_seq = prev_file->get_sequence();
             auto new_seq = file->get_sequence();
             if (prev_seq < new_seq) {
+                if (iterator) {
+                    iterator->on_remove(*folder_info, *prev_file);
+                }
                 fm.remove(prev_file);
                 prev_file->update(*file);
                 file = std::move(prev_file);
@@ -98,6 +102,9 @@ auto update_folder_t::apply_impl(apply_controller_t &controller, void *custom) c
 
         if (add_file) {
             folder_info->add_strict(file);
+            if (iterator) {
+                iterator->on_upsert(*folder_info, *file);
+            }
         }
     }
 
@@ -105,7 +112,8 @@ auto update_folder_t::apply_impl(apply_controller_t &controller, void *custom) c
 
     r = applicator_t::apply_sibling(controller, custom);
 
-    if (auto iterator = folder_info->get_device()->get_iterator(); iterator) {
+    if (iterator) {
+        // no-op for already tracked folder, as the touched files are already (re)queued
         iterator->on_upsert(folder_info);
     }
 
@@ -199,6 +199,16 @@ utils::bytes_t file_info_t::create_key(const bu::uuid &uuid, const folder_info_p
     return key;
 }
 
+void file_info_t::set_local_stat(const local_stat_t &value) noexcept {
+    if (!value) {
+        local_stat.reset();
+    } else if (local_stat) {
+        *local_stat = value;
+    } else {
+        local_stat.reset(new local_stat_t(value));
+    }
+}
+
 auto file_info_t::get_name() const noexcept -> const path_ptr_t & { return name; }
 
 std::uint64_t file_info_t::get_block_offset(size_t block_index) const noexcept {
@@ -226,6 +236,10 @@ auto file_info_t::fields_update(const db::FileInfo &source, model::path_cache_t
     if (db::get_no_permissions(source)) {
         flags |= flags_t::f_no_permissions;
     }
+    if (auto inode = db::get_inode(source); inode) {
+        local_stat.reset(new local_stat_t{db::get_device(source), inode, db::get_ctime_s(source),
+                                          db::get_ctime_ns(source)});
+    }
 
     version = version_t(db::get_version(source));
 
@@ -304,6 +318,12 @@ db::FileInfo file_info_t::as_db(bool include_blocks) const noexcept {
     db::set_invalid(r, flags & f_invalid);
     db::set_no_permissions(r, flags & f_no_permissions);
     db::set_version(r, version.as_proto());
+    if (local_stat) {
+        db::set_device(r, local_stat->device);
+        db::set_inode(r, local_stat->inode);
+        db::set_ctime_s(r, local_stat->ctime_s);
+        db::set_ctime_ns(r, local_stat->ctime_ns);
+    }
     if (flags & f_type_file) {
         db::set_size(r, get_size());
         db::set_block_size(r, get_block_size());
@@ -559,6 +579,7 @@ void file_info_t::update(const file_info_t &other) noexcept {
     modified_by = other.modified_by;
     version = other.version;
     sequence = other.sequence;
+    local_stat.reset(other.local_stat ? new local_stat_t(*other.local_stat) : nullptr);
     if (prev_symlink && new_symlink) {
         content.non_file.symlink_target = other.content.non_file.symlink_target;
     }
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <unordered_set>
 #include <filesystem>
+#include <memory>
 #include <boost/outcome.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include "utils/compact_vector.hpp"
@@ -35,6 +36,19 @@ using file_info_ptr_t = intrusive_ptr_t<file_info_t>;
 struct path_cache_t;
 struct path_guard_t;
 
+/* on-disk identity of a local file, which survives renames and moves within
+   the same device; the file content is the same while the inode, size and
+   modification time are the same */
+struct local_stat_t {
+    std::uint64_t device = 0;
+    std::uint64_t inode = 0;
+    std::int64_t ctime_s = 0;
+    std::int32_t ctime_ns = 0;
+
+    inline explicit operator bool() const noexcept { return inode != 0; }
+    bool operator==(const local_stat_t &) const noexcept = default;
+};
+
 struct SYNCSPIRIT_API file_info_t {
 
     // clang-format off
@@ -186,6 +200,8 @@ struct SYNCSPIRIT_API file_info_t {
     bfs::path get_path(const folder_info_t &folder_info) const noexcept;
 
     inline std::int64_t get_modified_s() const noexcept { return modified_s; }
+    inline const local_stat_t *get_local_stat() const noexcept { return local_stat.get(); }
+    void set_local_stat(const local_stat_t &value) noexcept;
     inline std::int32_t get_modified_ns() const noexcept { return modified_ns; }
     inline std::uint64_t get_modified_by() const noexcept { return modified_by; }
 
@@ -263,6 +279,7 @@ struct SYNCSPIRIT_API file_info_t {
 
     content_t content;
     version_t version;
+    std::unique_ptr<local_stat_t> local_stat; // of local files only
     std::uint16_t flags = 0;
     mutable std::uint16_t counter = 0;
 
@@ -1,14 +1,17 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <optional>
+#include <string>
 #include "misc/augmentation.h"
 #include "device.h"
 #include "folder_info.h"
 #include "misc/uuid.h"
+#include "misc/ignores.h"
 #include "folder_data.h"
 #include "syncspirit-export.h"
 #include "proto/proto-fwd.hpp"
@@ -29,6 +32,16 @@ struct folder_t;
 using folder_ptr_t = intrusive_ptr_t<folder_t>;
 
 struct SYNCSPIRIT_API folder_t final : augmentable_t, folder_data_t {
+    /* disk I/O counters of an operation kind (open, read, write etc.), as reported by the fs actor */
+    struct io_counter_t {
+        std::uint64_t count = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t total_us = 0;
+        std::uint64_t p99_us = 0; // of the latest report
+        std::uint64_t max_us = 0; // ditto
+    };
+    using io_counters_t = std::map<std::string, io_counter_t, std::less<>>;
+
     static outcome::result<folder_ptr_t> create(utils::bytes_view_t key, const db::Folder &folder) noexcept;
     static outcome::result<folder_ptr_t> create(const bu::uuid &uuid, const db::Folder &folder) noexcept;
 
@@ -59,6 +72,10 @@ struct SYNCSPIRIT_API folder_t final : augmentable_t, folder_data_t {
     void mark_suspended(bool value, const sys::error_code &ec = {}) noexcept;
     bool is_suspended() const noexcept;
     const sys::error_code &get_suspend_reason() const noexcept;
+    inline const ignores_ptr_t &get_ignores() const noexcept { return ignores; }
+    inline void set_ignores(ignores_ptr_t value) noexcept { ignores = std::move(value); }
+    inline io_counters_t &get_io_counters() noexcept { return io_counters; }
+    inline const io_counters_t &get_io_counters() const noexcept { return io_counters; }
 
     using folder_data_t::get_path;
     using folder_data_t::set_path;
@@ -81,6 +98,8 @@ struct SYNCSPIRIT_API folder_t final : augmentable_t, folder_data_t {
     unsigned char key[data_length];
     std::int_fast32_t synchronizing = 0;
     sys::error_code suspend_reason;
+    ignores_ptr_t ignores;
+    io_counters_t io_counters;
     bool suspended;
 };
 
@@ -5,6 +5,7 @@
 #include "proto/proto-helpers.h"
 
 #include <boost/nowide/convert.hpp>
+#include <algorithm>
 
 using namespace syncspirit::model;
 
@@ -15,12 +16,16 @@ void folder_data_t::assign_fields(const db::Folder &item) noexcept {
     folder_type = db::get_folder_type(item);
     rescan_interval = db::get_rescan_interval(item);
     pull_order = db::get_pull_order(item);
+    pull_priority = db::get_pull_priority(item);
+    pull_weight = std::max(db::get_pull_weight(item), std::uint32_t{1});
     scheduled = db::get_scheduled(item);
     ignore_permissions = db::get_ignore_permissions(item);
     ignore_delete = db::get_ignore_delete(item);
     disable_temp_indixes = db::get_disable_temp_indexes(item);
     paused = db::get_paused(item);
     watched = db::get_watched(item);
+    preallocate = db::get_preallocate(item);
+    uncached = db::get_uncached(item);
 }
 
 void folder_data_t::serialize(db::Folder &r) const noexcept {
@@ -31,9 +36,13 @@ void folder_data_t::serialize(db::Folder &r) const noexcept {
     db::set_disable_temp_indexes(r, disable_temp_indixes);
     db::set_paused(r, paused);
     db::set_watched(r, watched);
+    db::set_preallocate(r, preallocate);
+    db::set_uncached(r, uncached);
     db::set_scheduled(r, scheduled);
     db::set_path(r, path.string());
     db::set_folder_type(r, folder_type);
     db::set_pull_order(r, pull_order);
+    db::set_pull_priority(r, pull_priority);
+    db::set_pull_weight(r, pull_weight);
     db::set_rescan_interval(r, rescan_interval);
 }
@@ -26,8 +26,12 @@ struct SYNCSPIRIT_API folder_data_t {
     inline bool is_paused() const noexcept { return paused; }
     inline bool is_scheduled() const noexcept { return scheduled; }
     inline bool is_watched() const noexcept { return watched; }
+    inline bool is_preallocated() const noexcept { return preallocate; }
+    inline bool is_uncached() const noexcept { return uncached; }
     inline folder_type_t get_folder_type() const noexcept { return folder_type; }
     inline pull_order_t get_pull_order() const noexcept { return pull_order; }
+    inline std::int32_t get_pull_priority() const noexcept { return pull_priority; }
+    inline std::uint32_t get_pull_weight() const noexcept { return pull_weight; }
     inline const bfs::path &get_path() const noexcept { return path; }
     inline void set_path(const bfs::path &value) noexcept { path = value; }
     inline std::uint32_t get_rescan_interval() const noexcept { return rescan_interval; };
@@ -47,12 +51,16 @@ struct SYNCSPIRIT_API folder_data_t {
     folder_type_t folder_type;
     std::uint32_t rescan_interval;
     pull_order_t pull_order;
+    std::int32_t pull_priority;
+    std::uint32_t pull_weight;
     bool scheduled;
     bool ignore_permissions;
     bool ignore_delete;
     bool disable_temp_indixes;
     bool paused;
     bool watched;
+    bool preallocate;
+    bool uncached;
 };
 
 } // namespace syncspirit::model
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "error_code.h"
 
@@ -117,6 +117,12 @@ std::string error_code_category_t::message(int c) const {
     case error_code_t::empty_folder_name:
         r = "folder name is empty";
         break;
+    case error_code_t::invalid_ignore_pattern:
+        r = "invalid ignore pattern";
+        break;
+    case error_code_t::too_deep_ignores_include:
+        r = "too deep (or recursive) includes of ignore patterns";
+        break;
     default:
         r = "unknown";
         break;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -44,6 +44,8 @@ enum class error_code_t {
     mismatch_file_size,
     invalid_sequence,
     empty_folder_name,
+    invalid_ignore_pattern,
+    too_deep_ignores_include,
 };
 
 namespace detail {
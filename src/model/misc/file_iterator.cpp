@@ -1,11 +1,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "file_iterator.h"
 #include "resolver.h"
 #include "model/cluster.h"
 
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 using namespace syncspirit::model;
 
@@ -45,7 +46,7 @@ bool file_iterator_t::file_comparator_t::operator()(const file_info_t *l, const
 }
 
 file_iterator_t::file_iterator_t(cluster_t &cluster_, const device_ptr_t &peer_) noexcept
-    : cluster{cluster_}, peer{peer_.get()}, folder_index{0} {
+    : cluster{cluster_}, peer{peer_.get()}, virtual_time{0} {
     auto &folders = cluster.get_folders();
 
     for (auto &[folder, _] : folders) {
@@ -67,6 +68,15 @@ auto file_iterator_t::find_folder(folder_t *folder) noexcept -> folder_iterator_
     return *it;
 }
 
+auto file_iterator_t::find_folder(const folder_info_t &peer_folder) noexcept -> folder_iterator_t * {
+    for (auto &it : folders_list) {
+        if (it.peer_folder.get() == &peer_folder) {
+            return &it;
+        }
+    }
+    return nullptr;
+}
+
 auto file_iterator_t::prepare_folder(folder_info_ptr_t peer_folder) noexcept -> folder_iterator_t & {
     auto &files = peer_folder->get_file_infos();
     auto folder = peer_folder->get_folder();
@@ -96,45 +106,71 @@ auto file_iterator_t::prepare_folder(folder_info_ptr_t peer_folder) noexcept ->
     return folders_list.back();
 }
 
-auto file_iterator_t::next() noexcept -> result_t {
-    auto folders_count = folders_list.size();
-    auto folder_scans = size_t{0};
+bool file_iterator_t::is_pullable(folder_iterator_t &fi) noexcept {
+    auto &peer_folder = *fi.peer_folder;
+    auto folder = peer_folder.get_folder();
+    auto r = !folder->is_paused() && !folder->is_scheduled() && !folder->is_suspended() && !fi.files_queue->empty();
+    if (r) {
+        if (auto view = peer->get_remote_view_map().get(peer->device_id().get_sha256(), folder->get_id()); view) {
+            r = view->max_sequence <= peer_folder.get_max_sequence();
+        } else {
+            r = false;
+        }
+    }
+    return r;
+}
+
+/* folders with higher pull priority are always served first; folders with the
+ * same priority share the pulling proportionally to their weights */
+auto file_iterator_t::pick_folder() noexcept -> folder_iterator_t * {
+    auto best = (folder_iterator_t *)(nullptr);
+    auto best_priority = std::int32_t{0};
+    auto best_start = std::uint64_t{0};
+    for (auto &fi : folders_list) {
+        if (!is_pullable(fi)) {
+            continue;
+        }
+        auto priority = fi.peer_folder->get_folder()->get_pull_priority();
+        auto start = std::max(fi.virtual_finish, virtual_time);
+        if (!best || priority > best_priority || (priority == best_priority && start < best_start)) {
+            best = &fi;
+            best_priority = priority;
+            best_start = start;
+        }
+    }
+    return best;
+}
 
-    while (folder_scans < folders_count) {
-        auto &fi = folders_list[folder_index];
-        auto &peer_folder = *fi.peer_folder;
+void file_iterator_t::charge(folder_iterator_t &fi, const file_info_t &file) noexcept {
+    static constexpr std::uint64_t unit = 1 << 16;
+    auto weight = std::max(fi.peer_folder->get_folder()->get_pull_weight(), std::uint32_t{1});
+    auto cost = std::uint64_t{1} + file.iterate_blocks().get_total();
+    auto start = std::max(fi.virtual_finish, virtual_time);
+    virtual_time = start;
+    fi.virtual_finish = start + cost * unit / weight;
+}
+
+auto file_iterator_t::next() noexcept -> result_t {
+    while (auto fi = pick_folder()) {
+        auto &peer_folder = *fi->peer_folder;
         auto folder = peer_folder.get_folder();
-        auto &folders = folder->get_folder_infos();
-        auto &local_folder = *folders.by_device(*cluster.get_device());
+        auto &local_folder = *folder->get_folder_infos().by_device(*cluster.get_device());
         auto &local_files = local_folder.get_file_infos();
 
-        auto &queue = fi.files_queue;
-        auto do_scan = !folder->is_paused() && !folder->is_scheduled() && !folder->is_suspended() && !queue->empty();
-
-        if (do_scan) {
-            if (auto view = peer->get_remote_view_map().get(peer->device_id().get_sha256(), folder->get_id()); view) {
-                do_scan = view->max_sequence <= peer_folder.get_max_sequence();
-            } else {
-                do_scan = false;
-            }
-        }
-        // check other files
-        if (do_scan) {
-            auto it = queue->begin();
-            while (it != queue->end()) {
-                auto file = *it;
-                it = queue->erase(it);
-                if (!cluster.is_locked(file->get_name().get())) {
-                    auto local_file = local_files.by_name(file->get_name()->get_full_name()).get();
-                    auto action = resolve(*file, local_file, local_folder);
-                    if (action != advance_action_t::ignore) {
-                        return {file, &peer_folder, local_file, action};
-                    }
+        auto &queue = fi->files_queue;
+        auto it = queue->begin();
+        while (it != queue->end()) {
+            auto file = *it;
+            it = queue->erase(it);
+            if (!cluster.is_locked(file->get_name().get())) {
+                auto local_file = local_files.by_name(file->get_name()->get_full_name()).get();
+                auto action = resolve(*file, local_file, local_folder);
+                if (action != advance_action_t::ignore) {
+                    charge(*fi, *file);
+                    return {file, &peer_folder, local_file, action};
                 }
             }
         }
-        folder_index = (folder_index + 1) % folders_count;
-        ++folder_scans;
     }
     return {nullptr, nullptr, nullptr, advance_action_t::ignore};
 }
@@ -151,11 +187,12 @@ void file_iterator_t::on_upsert(folder_info_ptr_t peer_folder) noexcept {
 
 void file_iterator_t::populate(folder_iterator_t &it) noexcept {
     auto peer_folder = it.peer_folder.get();
-    auto seen_sequence = it.seen_sequence;
     if (peer_folder->get_index() != it.seen_index) {
+        it.seen_index = peer_folder->get_index();
         it.seen_sequence = 0;
         it.files_queue->clear();
     }
+    auto seen_sequence = it.seen_sequence;
     auto &files_map = peer_folder->get_file_infos();
     auto folder = peer_folder->get_folder();
     auto &local_folder = *folder->get_folder_infos().by_device(*folder->get_cluster()->get_device());
@@ -185,9 +222,10 @@ void file_iterator_t::on_upsert(folder_t &folder) noexcept {
                     it.seen_sequence = 0;
                     populate(it);
                 } else if (it.files_queue->key_comp().pull_order != order) {
+                    // re-link the existing nodes, no reallocations
                     auto new_set = std::make_unique<queue_t>(file_comparator_t{order});
-                    for (auto fi : *it.files_queue) {
-                        new_set->insert(fi);
+                    while (!it.files_queue->empty()) {
+                        new_set->insert(it.files_queue->extract(it.files_queue->begin()));
                     }
                     it.files_queue = std::move(new_set);
                     it.it = it.files_queue->begin();
@@ -203,29 +241,55 @@ void file_iterator_t::on_upsert(folder_t &folder) noexcept {
     }
 }
 
+void file_iterator_t::reset(folder_t &folder) noexcept {
+    for (auto &it : folders_list) {
+        if (it.peer_folder->get_folder() == &folder) {
+            it.files_queue->clear();
+            it.it = it.files_queue->begin();
+            if (it.can_receive) {
+                it.seen_sequence = 0;
+                populate(it);
+            }
+        }
+    }
+}
+
 void file_iterator_t::on_remove(folder_info_ptr_t peer_folder) noexcept {
     for (auto it = folders_list.begin(); it != folders_list.end(); ++it) {
         if (it->peer_folder == peer_folder) {
             folders_list.erase(it);
-            folder_index = 0;
             return;
         }
     }
 }
 
+void file_iterator_t::on_remove(const folder_info_t &peer_folder, file_info_t &file) noexcept {
+    if (auto fi = find_folder(peer_folder); fi) {
+        fi->files_queue->erase(&file);
+        fi->it = fi->files_queue->begin();
+    }
+}
+
+void file_iterator_t::on_upsert(const folder_info_t &peer_folder, file_info_t &file) noexcept {
+    auto fi = find_folder(peer_folder);
+    if (fi && fi->can_receive && fi->seen_index == peer_folder.get_index()) {
+        recheck(peer_folder, file);
+        fi->seen_sequence = std::max(fi->seen_sequence, file.get_sequence());
+    }
+}
+
 void file_iterator_t::recheck(const folder_info_t &remote_fi, file_info_t &remote) noexcept {
-    for (auto &fi : folders_list) {
-        if (fi.peer_folder.get() == &remote_fi) {
-            if (fi.can_receive) {
-                auto folder = fi.peer_folder->get_folder();
-                auto &local_folder = *folder->get_folder_infos().by_device(*folder->get_cluster()->get_device());
-                auto &local_files = local_folder.get_file_infos();
-                auto local_file = local_files.by_name(remote.get_name()->get_full_name());
-                if (resolve(remote, local_file.get(), local_folder) != advance_action_t::ignore) {
-                    fi.files_queue->emplace(&remote);
-                }
-            }
-            break;
+    auto fi = find_folder(remote_fi);
+    if (fi && fi->can_receive) {
+        auto folder = fi->peer_folder->get_folder();
+        auto &local_folder = *folder->get_folder_infos().by_device(*folder->get_cluster()->get_device());
+        auto &local_files = local_folder.get_file_infos();
+        auto local_file = local_files.by_name(remote.get_name()->get_full_name());
+        if (resolve(remote, local_file.get(), local_folder) != advance_action_t::ignore) {
+            fi->files_queue->emplace(&remote);
+        } else {
+            fi->files_queue->erase(&remote);
         }
+        fi->it = fi->files_queue->begin();
     }
 }
@@ -34,6 +34,14 @@ struct SYNCSPIRIT_API file_iterator_t : arc_base_t<file_iterator_t> {
     void on_upsert(folder_t &folder) noexcept;
     void on_upsert(folder_info_ptr_t peer_folder) noexcept;
     void on_remove(folder_info_ptr_t peer_folder) noexcept;
+    /* re-evaluates all peer files of the folder, e.g. when its ignores are changed */
+    void reset(folder_t &folder) noexcept;
+
+    /* incremental maintenance: the file has to be removed from the queue
+     * before it is mutated (the queue is ordered by file properties) and
+     * (re)inserted after the update */
+    void on_remove(const folder_info_t &peer_folder, file_info_t &file) noexcept;
+    void on_upsert(const folder_info_t &peer_folder, file_info_t &file) noexcept;
     void recheck(const folder_info_t &fi, file_info_t &file) noexcept;
 
   private:
@@ -53,16 +61,22 @@ struct SYNCSPIRIT_API file_iterator_t : arc_base_t<file_iterator_t> {
         std::int64_t seen_sequence;
         it_t it;
         bool can_receive;
+        // weighted fair queueing: virtual time, when the folder is served next time
+        std::uint64_t virtual_finish = 0;
     };
     using folder_iterators_t = std::vector<folder_iterator_t>;
 
     folder_iterator_t &prepare_folder(folder_info_ptr_t peer_folder) noexcept;
     folder_iterator_t &find_folder(folder_t *folder) noexcept;
+    folder_iterator_t *find_folder(const folder_info_t &peer_folder) noexcept;
     void populate(folder_iterator_t &it) noexcept;
+    bool is_pullable(folder_iterator_t &it) noexcept;
+    folder_iterator_t *pick_folder() noexcept;
+    void charge(folder_iterator_t &it, const file_info_t &file) noexcept;
 
     cluster_t &cluster;
     device_t *peer;
-    std::size_t folder_index;
+    std::uint64_t virtual_time;
     folder_iterators_t folders_list;
 };
 
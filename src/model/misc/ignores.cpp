@@ -0,0 +1,738 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "ignores.h"
+#include "error_code.h"
+#include <algorithm>
+#include <bit>
+
+using namespace syncspirit::model;
+
+namespace {
+
+static constexpr std::uint32_t max_include_depth = 8;
+static constexpr std::size_t max_alternatives = 256;
+
+inline char lower(char c) noexcept { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+inline char32_t lower(char32_t c) noexcept { return (c >= U'A' && c <= U'Z') ? c - U'A' + U'a' : c; }
+inline char32_t upper(char32_t c) noexcept { return (c >= U'a' && c <= U'z') ? c - U'a' + U'A' : c; }
+
+// invalid sequences are consumed byte by byte
+char32_t decode(std::string_view str, std::size_t &pos) noexcept {
+    auto byte = [&](std::size_t i) { return static_cast<unsigned char>(str[i]); };
+    auto lead = byte(pos);
+    auto length = std::size_t{1};
+    auto cp = char32_t{lead};
+    if (lead >= 0xF0) {
+        length = 4;
+        cp = lead & 0x07;
+    } else if (lead >= 0xE0) {
+        length = 3;
+        cp = lead & 0x0F;
+    } else if (lead >= 0xC0) {
+        length = 2;
+        cp = lead & 0x1F;
+    }
+    if (length > 1) {
+        if (pos + length > str.size()) {
+            ++pos;
+            return lead;
+        }
+        for (std::size_t i = 1; i < length; ++i) {
+            auto next = byte(pos + i);
+            if ((next & 0xC0) != 0x80) {
+                ++pos;
+                return lead;
+            }
+            cp = (cp << 6) | (next & 0x3F);
+        }
+    }
+    pos += length;
+    return cp;
+}
+
+void encode(std::string &out, char32_t cp) noexcept {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+std::string_view trim(std::string_view line) noexcept {
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+    while (!line.empty() && is_space(line.front())) {
+        line.remove_prefix(1);
+    }
+    while (!line.empty() && is_space(line.back())) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+static constexpr bool escaping = false;
+#else
+static constexpr bool escaping = true;
+#endif
+
+// the position of the closing bracket or npos
+std::size_t find_closing(std::string_view str, std::size_t pos, char open, char close) noexcept {
+    auto depth = 0;
+    for (auto i = pos; i < str.size(); ++i) {
+        auto c = str[i];
+        if (c == '\\' && escaping) {
+            ++i;
+        } else if (c == open) {
+            ++depth;
+        } else if (c == close) {
+            if (--depth == 0) {
+                return i;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool expand(std::string_view pattern, std::vector<std::string> &out) noexcept {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        auto c = pattern[i];
+        if (c == '\\' && escaping) {
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            continue;
+        }
+        auto end = find_closing(pattern, i, '{', '}');
+        if (end == std::string_view::npos) {
+            break;
+        }
+        auto head = pattern.substr(0, i);
+        auto tail = pattern.substr(end + 1);
+        auto body = pattern.substr(i + 1, end - i - 1);
+        auto depth = 0;
+        auto start = std::size_t{0};
+        for (std::size_t j = 0; j <= body.size(); ++j) {
+            auto last = j == body.size();
+            auto b = last ? ',' : body[j];
+            if (b == '\\' && escaping) {
+                ++j;
+            } else if (b == '{') {
+                ++depth;
+            } else if (b == '}') {
+                --depth;
+            } else if (b == ',' && depth == 0) {
+                auto alternative = std::string(head);
+                alternative += body.substr(start, j - start);
+                alternative += tail;
+                if (!expand(alternative, out)) {
+                    return false;
+                }
+                start = j + 1;
+            }
+        }
+        return true;
+    }
+    if (out.size() >= max_alternatives) {
+        return false;
+    }
+    out.emplace_back(pattern);
+    return true;
+}
+
+} // namespace
+
+void ignores_t::trie_t::add(std::string_view path, index_t pattern) noexcept {
+    if (nodes.empty()) {
+        nodes.emplace_back();
+    }
+    auto node = std::size_t{0};
+    while (!path.empty()) {
+        auto slash = path.find('/');
+        auto name = path.substr(0, slash);
+        path = slash == std::string_view::npos ? std::string_view() : path.substr(slash + 1);
+        if (name.empty()) {
+            continue;
+        }
+        auto &children = nodes[node].children;
+        if (auto it = children.find(name); it != children.end()) {
+            node = it->second;
+        } else {
+            auto next = static_cast<index_t>(nodes.size());
+            children.emplace(std::string(name), next);
+            nodes.emplace_back();
+            node = next;
+        }
+    }
+    auto &target = nodes[node].pattern;
+    target = std::min(target, pattern);
+}
+
+auto ignores_t::trie_t::match(std::string_view path, index_t best) const noexcept -> index_t {
+    if (nodes.empty()) {
+        return best;
+    }
+    auto node = &nodes.front();
+    while (true) {
+        auto slash = path.find('/');
+        auto it = node->children.find(path.substr(0, slash));
+        if (it == node->children.end()) {
+            break;
+        }
+        node = &nodes[it->second];
+        best = std::min(best, node->pattern);
+        if (slash == std::string_view::npos) {
+            break;
+        }
+        path = path.substr(slash + 1);
+    }
+    return best;
+}
+
+void ignores_t::affixes_t::add(std::string_view affix, index_t pattern) noexcept {
+    auto [it, inserted] = map.try_emplace(std::string(affix), pattern);
+    if (!inserted) {
+        it->second = std::min(it->second, pattern);
+    }
+    if (std::find(lengths.begin(), lengths.end(), affix.size()) == lengths.end()) {
+        lengths.emplace_back(affix.size());
+    }
+}
+
+auto ignores_t::affixes_t::match(std::string_view name, bool suffix, index_t best) const noexcept -> index_t {
+    for (auto length : lengths) {
+        if (length <= name.size()) {
+            auto key = suffix ? name.substr(name.size() - length) : name.substr(0, length);
+            if (auto it = map.find(key); it != map.end()) {
+                best = std::min(best, it->second);
+            }
+        }
+    }
+    return best;
+}
+
+auto ignores_t::literals_t::match(std::string_view path, index_t best) const noexcept -> index_t {
+    if (empty) {
+        return best;
+    }
+    best = anchored.match(path, best);
+    while (true) {
+        auto slash = path.find('/');
+        auto name = path.substr(0, slash);
+        best = floating.match(path, best);
+        best = suffixes.match(name, true, best);
+        best = prefixes.match(name, false, best);
+        if (slash == std::string_view::npos) {
+            break;
+        }
+        path = path.substr(slash + 1);
+    }
+    return best;
+}
+
+void ignores_t::scanner_t::add(std::string literal, std::uint32_t glob) noexcept {
+    literals.emplace_back(std::move(literal), glob);
+}
+
+void ignores_t::scanner_t::build() noexcept {
+    if (literals.empty()) {
+        return;
+    }
+    // only the bytes of the literals are distinguished
+    for (auto &[literal, _] : literals) {
+        for (auto c : literal) {
+            auto &symbol = alphabet[static_cast<unsigned char>(c)];
+            if (!symbol) {
+                symbol = static_cast<std::uint8_t>(symbols++);
+            }
+        }
+    }
+    static constexpr auto absent = static_cast<std::uint32_t>(-1);
+    auto node_transitions = [&](std::uint32_t node) { return transitions.data() + node * symbols; };
+    auto add_node = [&]() {
+        transitions.resize(transitions.size() + symbols, absent);
+        outputs.emplace_back();
+        return static_cast<std::uint32_t>(outputs.size() - 1);
+    };
+    add_node();
+    for (auto &[literal, glob] : literals) {
+        auto node = std::uint32_t{0};
+        for (auto c : literal) {
+            auto symbol = alphabet[static_cast<unsigned char>(c)];
+            auto next = node_transitions(node)[symbol];
+            if (next == absent) {
+                next = add_node();
+                node_transitions(node)[symbol] = next;
+            }
+            node = next;
+        }
+        outputs[node].emplace_back(glob);
+    }
+
+    // breadth-first: missing transitions follow the failure links, outputs are merged
+    auto failures = std::vector<std::uint32_t>(outputs.size(), 0);
+    auto queue = std::vector<std::uint32_t>();
+    for (std::uint32_t s = 0; s < symbols; ++s) {
+        auto &next = node_transitions(0)[s];
+        if (next == absent) {
+            next = 0;
+        } else {
+            queue.emplace_back(next);
+        }
+    }
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        auto node = queue[i];
+        for (std::uint32_t s = 0; s < symbols; ++s) {
+            auto fallback = node_transitions(failures[node])[s];
+            auto &next = node_transitions(node)[s];
+            if (next == absent) {
+                next = fallback;
+            } else {
+                failures[next] = fallback;
+                auto &inherited = outputs[fallback];
+                outputs[next].insert(outputs[next].end(), inherited.begin(), inherited.end());
+                queue.emplace_back(next);
+            }
+        }
+    }
+    // the row offsets are stored instead of the nodes, the nodes with outputs are marked
+    for (auto &next : transitions) {
+        auto marker = outputs[next].empty() ? 0 : output_marker;
+        next = (next * symbols) | marker;
+    }
+    literals.clear();
+}
+
+void ignores_t::scanner_t::scan(std::string_view path, glob_indices_t &globs) const noexcept {
+    if (outputs.empty()) {
+        return;
+    }
+    auto row = std::uint32_t{0};
+    for (auto c : path) {
+        row = transitions[row + alphabet[static_cast<unsigned char>(c)]];
+        if (row & output_marker) {
+            row &= ~output_marker;
+            auto &found = outputs[row / symbols];
+            globs.insert(globs.end(), found.begin(), found.end());
+        }
+    }
+}
+
+bool ignores_t::klass_t::matches(char32_t cp, bool icase) const noexcept {
+    auto in_ranges = [&](char32_t c) {
+        for (auto &[from, to] : ranges) {
+            if (c >= from && c <= to) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto r = in_ranges(cp) || (icase && in_ranges(upper(cp)));
+    return r != negated;
+}
+
+void ignores_t::glob_t::close(states_t &states) const noexcept {
+    auto n = tokens.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (states[i / 64] & (std::uint64_t{1} << (i % 64))) {
+            auto &token = tokens[i];
+            if (token.kind == token_t::star || token.kind == token_t::dstar) {
+                states[(i + 1) / 64] |= std::uint64_t{1} << ((i + 1) % 64);
+                if (token.skip_dir) {
+                    states[(i + 2) / 64] |= std::uint64_t{1} << ((i + 2) % 64);
+                }
+            }
+        }
+    }
+}
+
+bool ignores_t::glob_t::match(std::string_view path, const std::vector<klass_t> &klasses) const noexcept {
+    auto n = tokens.size();
+    auto set = [](states_t &states, std::size_t i) { states[i / 64] |= std::uint64_t{1} << (i % 64); };
+    auto accepted = [&](const states_t &states) { return (states[n / 64] & (std::uint64_t{1} << (n % 64))) != 0; };
+    auto is_empty = [](const states_t &states) {
+        return std::all_of(states.begin(), states.end(), [](auto word) { return word == 0; });
+    };
+
+    auto current = states_t{};
+    set(current, 0);
+    close(current);
+    auto pos = std::size_t{0};
+    while (pos < path.size()) {
+        auto cp = decode(path, pos);
+        auto is_slash = cp == U'/';
+        if (is_slash && accepted(current)) {
+            return true;
+        }
+        auto next = states_t{};
+        for (std::size_t w = 0; w < current.size(); ++w) {
+            for (auto word = current[w]; word; word &= word - 1) {
+                auto i = w * 64 + static_cast<std::size_t>(std::countr_zero(word));
+                if (i >= n) {
+                    break;
+                }
+                auto &token = tokens[i];
+                switch (token.kind) {
+                case token_t::symbol:
+                    if (token.cp == cp) {
+                        set(next, i + 1);
+                    }
+                    break;
+                case token_t::any:
+                    if (!is_slash) {
+                        set(next, i + 1);
+                    }
+                    break;
+                case token_t::klass:
+                    if (!is_slash && klasses[token.klass_index].matches(cp, icase)) {
+                        set(next, i + 1);
+                    }
+                    break;
+                case token_t::star:
+                    if (!is_slash) {
+                        set(next, i);
+                    }
+                    break;
+                case token_t::dstar:
+                    set(next, i);
+                    break;
+                }
+            }
+        }
+        if (is_slash && !anchored) {
+            set(next, 0);
+        }
+        close(next);
+        if (is_empty(next)) {
+            if (anchored) {
+                return false;
+            }
+            // nothing matches in the current component, restart from the next one
+            auto slash = path.find('/', pos);
+            if (slash == std::string_view::npos) {
+                return false;
+            }
+            pos = slash + 1;
+            set(next, 0);
+            close(next);
+        }
+        current = next;
+    }
+    return accepted(current);
+}
+
+struct ignores_t::parser_t {
+    ignores_t &self;
+    const loader_t &loader;
+
+    outcome::result<void> parse(std::string_view content, std::string_view dir, std::uint32_t depth) noexcept {
+        while (!content.empty()) {
+            auto eol = content.find('\n');
+            auto line = trim(content.substr(0, eol));
+            content = eol == std::string_view::npos ? std::string_view() : content.substr(eol + 1);
+            if (line.empty() || line.starts_with("//")) {
+                continue;
+            }
+            if (line.starts_with("#include")) {
+                auto r = include(trim(line.substr(8)), dir, depth);
+                if (!r) {
+                    return r;
+                }
+            } else if (line.starts_with('#')) {
+                continue;
+            } else {
+                auto r = add(line);
+                if (!r) {
+                    return r;
+                }
+            }
+        }
+        return outcome::success();
+    }
+
+    outcome::result<void> include(std::string_view name, std::string_view dir, std::uint32_t depth) noexcept {
+        if (name.empty() || !loader) {
+            return make_error_code(error_code_t::invalid_ignore_pattern);
+        }
+        if (depth >= max_include_depth) {
+            return make_error_code(error_code_t::too_deep_ignores_include);
+        }
+        auto path = std::string();
+        if (name.starts_with('/')) {
+            path = name.substr(1);
+        } else {
+            path = dir;
+            if (!path.empty()) {
+                path += '/';
+            }
+            path += name;
+        }
+        auto content = loader(path);
+        if (!content) {
+            return content.assume_error();
+        }
+        auto slash = path.rfind('/');
+        auto sub_dir = slash == std::string::npos ? std::string() : path.substr(0, slash);
+        return parse(content.assume_value(), sub_dir, depth + 1);
+    }
+
+    outcome::result<void> add(std::string_view line) noexcept {
+        auto negated = false;
+        auto deletable = false;
+        auto icase = false;
+        auto body = line;
+        while (true) {
+            if (body.starts_with('!')) {
+                negated = true;
+                body.remove_prefix(1);
+            } else if (body.starts_with("(?i)")) {
+                icase = true;
+                body.remove_prefix(4);
+            } else if (body.starts_with("(?d)")) {
+                deletable = true;
+                body.remove_prefix(4);
+            } else {
+                break;
+            }
+        }
+        auto text = std::string(body);
+        if constexpr (!escaping) {
+            std::replace(text.begin(), text.end(), '\\', '/');
+        }
+        auto pattern = std::string_view(text);
+        auto anchored = pattern.starts_with('/');
+        while (pattern.starts_with('/')) {
+            pattern.remove_prefix(1);
+        }
+        while (pattern.ends_with('/')) {
+            pattern.remove_suffix(1);
+        }
+        if (pattern.empty()) {
+            return make_error_code(error_code_t::invalid_ignore_pattern);
+        }
+
+        auto index = static_cast<index_t>(self.patterns.size());
+        self.patterns.emplace_back(pattern_t{std::string(line), negated, deletable});
+        if (negated) {
+            self.first_negated = std::min(self.first_negated, index);
+        }
+        self.has_icase = self.has_icase || icase;
+
+        auto alternatives = std::vector<std::string>();
+        if (!expand(pattern, alternatives)) {
+            return make_error_code(error_code_t::invalid_ignore_pattern);
+        }
+        for (auto &alternative : alternatives) {
+            auto r = compile(alternative, index, anchored, icase);
+            if (!r) {
+                return r;
+            }
+        }
+        return outcome::success();
+    }
+
+    outcome::result<void> compile(std::string_view pattern, index_t index, bool anchored, bool icase) noexcept {
+        auto tokens = tokens_t();
+        auto pos = std::size_t{0};
+        while (pos < pattern.size()) {
+            auto c = pattern[pos];
+            if (c == '\\' && escaping && pos + 1 < pattern.size()) {
+                ++pos;
+                auto cp = decode(pattern, pos);
+                tokens.emplace_back(token_t{token_t::symbol, false, icase ? lower(cp) : cp});
+            } else if (c == '*') {
+                auto stars = std::size_t{0};
+                while (pos < pattern.size() && pattern[pos] == '*') {
+                    ++stars;
+                    ++pos;
+                }
+                if (stars == 1) {
+                    tokens.emplace_back(token_t{token_t::star});
+                } else {
+                    auto at_start = tokens.empty() || (tokens.back().kind == token_t::symbol && tokens.back().cp == U'/');
+                    auto skip_dir = at_start && pos < pattern.size() && pattern[pos] == '/';
+                    tokens.emplace_back(token_t{token_t::dstar, skip_dir});
+                }
+            } else if (c == '?') {
+                tokens.emplace_back(token_t{token_t::any});
+                ++pos;
+            } else if (c == '[' && pattern.find(']', pos + 2) != std::string_view::npos) {
+                pos = parse_klass(pattern, pos + 1);
+                auto klass_index = static_cast<std::uint32_t>(self.klasses.size() - 1);
+                tokens.emplace_back(token_t{token_t::klass, false, 0, klass_index});
+            } else {
+                auto cp = decode(pattern, pos);
+                tokens.emplace_back(token_t{token_t::symbol, false, icase ? lower(cp) : cp});
+            }
+        }
+
+        auto &literals = self.literals[icase ? 1 : 0];
+        auto is_symbol = [](const token_t &t) { return t.kind == token_t::symbol; };
+        auto is_separator = [](const token_t &t) { return t.kind == token_t::symbol && t.cp == U'/'; };
+        auto text = [](tokens_t::const_iterator b, tokens_t::const_iterator e) {
+            auto r = std::string();
+            for (auto it = b; it != e; ++it) {
+                encode(r, it->cp);
+            }
+            return r;
+        };
+        auto b = tokens.cbegin();
+        auto e = tokens.cend();
+        auto single_name = std::none_of(b, e, is_separator);
+        if (std::all_of(b, e, is_symbol)) {
+            auto &trie = anchored ? literals.anchored : literals.floating;
+            trie.add(text(b, e), index);
+            literals.empty = false;
+            return outcome::success();
+        }
+        if (!anchored && single_name && tokens.size() > 1) {
+            if (b->kind == token_t::star && std::all_of(b + 1, e, is_symbol)) {
+                literals.suffixes.add(text(b + 1, e), index);
+                literals.empty = false;
+                return outcome::success();
+            }
+            if ((e - 1)->kind == token_t::star && std::all_of(b, e - 1, is_symbol)) {
+                literals.prefixes.add(text(b, e - 1), index);
+                literals.empty = false;
+                return outcome::success();
+            }
+        }
+
+        if (tokens.size() > glob_t::max_tokens) {
+            return make_error_code(error_code_t::invalid_ignore_pattern);
+        }
+        auto literal = std::string();
+        for (auto it = b; it != e;) {
+            // `**/` might match nothing, i.e. the separator is absent at the path start
+            if (it != b && (it - 1)->skip_dir && is_separator(*it)) {
+                ++it;
+            }
+            auto end = std::find_if_not(it, e, is_symbol);
+            if (end - it > 0) {
+                auto candidate = text(it, end);
+                if (candidate.size() > literal.size()) {
+                    literal = std::move(candidate);
+                }
+                it = end;
+            } else {
+                ++it;
+            }
+        }
+        auto glob_index = static_cast<std::uint32_t>(self.globs.size());
+        self.globs.emplace_back(glob_t{std::move(tokens), index, anchored, icase});
+        if (literal.empty()) {
+            self.unconditional_globs.emplace_back(glob_index);
+        } else {
+            literals.scanner.add(std::move(literal), glob_index);
+        }
+        return outcome::success();
+    }
+
+    // returns the position after the closing bracket
+    std::size_t parse_klass(std::string_view pattern, std::size_t pos) noexcept {
+        auto &klass = self.klasses.emplace_back();
+        if (pattern[pos] == '!' || pattern[pos] == '^') {
+            klass.negated = true;
+            ++pos;
+        }
+        auto first = true;
+        while (pos < pattern.size() && (first || pattern[pos] != ']')) {
+            first = false;
+            if (pattern[pos] == '\\' && escaping && pos + 1 < pattern.size()) {
+                ++pos;
+            }
+            auto from = decode(pattern, pos);
+            auto to = from;
+            if (pos + 1 < pattern.size() && pattern[pos] == '-' && pattern[pos + 1] != ']') {
+                ++pos;
+                to = decode(pattern, pos);
+            }
+            klass.ranges.emplace_back(from, to);
+        }
+        return pos + 1;
+    }
+};
+
+auto ignores_t::parse(std::string_view content, const loader_t &loader) noexcept -> outcome::result<ignores_ptr_t> {
+    auto self = ignores_ptr_t(new ignores_t());
+    auto parser = parser_t{*self, loader};
+    auto r = parser.add(std::string("/").append(file_name));
+    if (r) {
+        r = parser.parse(content, {}, 0);
+    }
+    if (!r) {
+        return r.assume_error();
+    }
+    for (auto &literals : self->literals) {
+        literals.scanner.build();
+    }
+    return self;
+}
+
+auto ignores_t::find(std::string_view path) const noexcept -> index_t {
+    auto buffer = std::array<char, 256>();
+    auto lowered_str = std::string();
+    auto lowered = std::string_view();
+    if (has_icase) {
+        auto out = buffer.data();
+        if (path.size() > buffer.size()) {
+            lowered_str.resize(path.size());
+            out = lowered_str.data();
+        }
+        std::transform(path.begin(), path.end(), out, [](char c) { return lower(c); });
+        lowered = std::string_view(out, path.size());
+    }
+    auto best = literals[0].match(path, none);
+    best = literals[1].match(lowered, best);
+    if (globs.empty()) {
+        return best;
+    }
+
+    auto candidates = unconditional_globs;
+    literals[0].scanner.scan(path, candidates);
+    literals[1].scanner.scan(lowered, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    auto last = std::unique(candidates.begin(), candidates.end());
+    for (auto it = candidates.begin(); it != last; ++it) {
+        auto &glob = globs[*it];
+        if (glob.pattern >= best) {
+            break;
+        }
+        if (glob.match(glob.icase ? lowered : path, klasses)) {
+            best = glob.pattern;
+            break;
+        }
+    }
+    return best;
+}
+
+auto ignores_t::match(std::string_view path) const noexcept -> match_t {
+    auto index = find(path);
+    if (index == none || patterns[index].negated) {
+        return match_t::included;
+    }
+    return first_negated < index ? match_t::ignored_self : match_t::ignored;
+}
+
+bool ignores_t::is_deletable(std::string_view path) const noexcept {
+    auto index = find(path);
+    return index != none && !patterns[index].negated && patterns[index].deletable;
+}
+
+std::size_t ignores_t::size() const noexcept { return patterns.size() - 1; }
+
+bool ignores_t::operator==(const ignores_t &other) const noexcept {
+    auto same_line = [](const pattern_t &l, const pattern_t &r) { return l.line == r.line; };
+    return std::equal(patterns.begin(), patterns.end(), other.patterns.begin(), other.patterns.end(), same_line);
+}
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "syncspirit-export.h"
+#include "arc.hpp"
+#include "utils/string_comparator.hpp"
+#include <boost/outcome.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace syncspirit::model {
+
+namespace outcome = boost::outcome_v2;
+
+struct ignores_t;
+using ignores_ptr_t = intrusive_ptr_t<ignores_t>;
+
+/* .stignore compatible patterns of a folder, i.e. `//` comments, `#include`,
+ * `!`, `(?i)` and `(?d)` prefixes, `*`, `**`, `?`, `[...]`, `{a,b}` globs,
+ * anchoring with leading `/` and the first matching pattern wins. A pattern
+ * matches a path, when it matches the path itself or any of its parent dirs.
+ *
+ * The patterns are compiled once: literal ones are looked up in tries of path
+ * components, `*.ext` and `prefix*` names in hash maps, and the remaining ones
+ * are globs (NFA over code points). A glob is tried only if its longest literal
+ * part occurs in the path, which is checked for all globs at once by a single
+ * pass of Aho-Corasick automaton.
+ *
+ * The .stignore file itself is always ignored. Immutable after parsing, i.e.
+ * it can be shared between threads */
+struct SYNCSPIRIT_API ignores_t : boost::intrusive_ref_counter<ignores_t, boost::thread_safe_counter> {
+    enum class match_t : std::uint8_t {
+        included,
+        ignored,
+        ignored_self, // but something below the dir might be included, i.e. it has to be descended into
+    };
+
+    /* reads the included file, the path is relative to the folder root */
+    using loader_t = std::function<outcome::result<std::string>(std::string_view path)>;
+
+    static constexpr std::string_view file_name = ".stignore";
+
+    static outcome::result<ignores_ptr_t> parse(std::string_view content, const loader_t &loader = {}) noexcept;
+
+    /* the path is relative to the folder root, utf-8, with `/` separators */
+    match_t match(std::string_view path) const noexcept;
+    inline bool is_ignored(std::string_view path) const noexcept { return match(path) != match_t::included; }
+
+    /* ignored entries, which are allowed to be removed, e.g. to delete their parent dir */
+    bool is_deletable(std::string_view path) const noexcept;
+
+    std::size_t size() const noexcept;
+    bool operator==(const ignores_t &other) const noexcept;
+
+  private:
+    using index_t = std::uint32_t;
+    static constexpr index_t none = static_cast<index_t>(-1);
+
+    struct pattern_t {
+        std::string line;
+        bool negated;
+        bool deletable;
+    };
+    using patterns_t = std::vector<pattern_t>;
+
+    using indices_t = std::unordered_map<std::string, index_t, utils::string_hash_t, utils::string_eq_t>;
+
+    struct trie_t {
+        struct node_t {
+            indices_t children; // child node by the component name
+            index_t pattern = none;
+        };
+        void add(std::string_view path, index_t pattern) noexcept;
+        // the minimal pattern index, matching the path (or its parent) from the component
+        index_t match(std::string_view path, index_t best) const noexcept;
+
+        std::vector<node_t> nodes;
+    };
+
+    // `*suffix` / `prefix*` file names
+    struct affixes_t {
+        void add(std::string_view affix, index_t pattern) noexcept;
+        index_t match(std::string_view name, bool suffix, index_t best) const noexcept;
+
+        indices_t map;
+        std::vector<std::size_t> lengths;
+    };
+
+    struct token_t {
+        enum kind_t : std::uint8_t { symbol, any, klass, star, dstar };
+        kind_t kind;
+        bool skip_dir = false; // `**/` does match nothing
+        char32_t cp = 0;
+        std::uint32_t klass_index = 0;
+    };
+    using tokens_t = std::vector<token_t>;
+
+    struct klass_t {
+        std::vector<std::pair<char32_t, char32_t>> ranges;
+        bool negated = false;
+        bool matches(char32_t cp, bool icase) const noexcept;
+    };
+
+    struct glob_t {
+        static constexpr std::size_t max_tokens = 255;
+        using states_t = std::array<std::uint64_t, (max_tokens + 1 + 63) / 64>;
+
+        bool match(std::string_view path, const std::vector<klass_t> &klasses) const noexcept;
+        // `*` and `**` might match nothing
+        void close(states_t &states) const noexcept;
+
+        tokens_t tokens;
+        index_t pattern;
+        bool anchored;
+        bool icase;
+    };
+    using globs_t = std::vector<glob_t>;
+    using glob_indices_t = std::vector<std::uint32_t>;
+
+    struct scanner_t {
+        void add(std::string literal, std::uint32_t glob) noexcept;
+        void build() noexcept;
+        // appends the globs, which literals occur in the path
+        void scan(std::string_view path, glob_indices_t &globs) const noexcept;
+
+        std::vector<std::pair<std::string, std::uint32_t>> literals;
+        std::array<std::uint8_t, 256> alphabet = {};
+        std::uint32_t symbols = 1;
+        static constexpr std::uint32_t output_marker = 1u << 31;
+        std::vector<std::uint32_t> transitions; // row (node * symbols) + symbol
+        std::vector<glob_indices_t> outputs;
+    };
+
+    struct literals_t {
+        index_t match(std::string_view path, index_t best) const noexcept;
+
+        trie_t anchored;
+        trie_t floating;
+        affixes_t suffixes;
+        affixes_t prefixes;
+        scanner_t scanner;
+        bool empty = true;
+    };
+
+    struct parser_t;
+
+    ignores_t() noexcept = default;
+    index_t find(std::string_view path) const noexcept;
+
+    patterns_t patterns;
+    std::array<literals_t, 2> literals; // case-sensitive and insensitive ones
+    globs_t globs;                      // ordered by pattern index
+    glob_indices_t unconditional_globs; // without literal parts
+    std::vector<klass_t> klasses;
+    index_t first_negated = none;
+    bool has_icase = false;
+};
+
+} // namespace syncspirit::model
@@ -1,8 +1,9 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2022 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <boost/multi_index/global_fun.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
@@ -44,9 +45,10 @@ template <typename Item> class mru_list_t {
         }
     }
 
-    void remove(const Item &item) noexcept {
+    void remove(const Item &item) noexcept { remove_key(get_lru_key(item)); }
+
+    void remove_key(std::string_view key) noexcept {
         auto &projection = il.template get<1>();
-        auto key = get_lru_key(item);
         auto it = projection.find(key);
         if (it != projection.end()) {
             auto it_0 = il.template project<tag_seq>(it);
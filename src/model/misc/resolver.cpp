@@ -125,6 +125,9 @@ advance_action_t resolve(const file_info_t &remote, const file_info_t *local,
     if (!P::path_supported(remote_name)) {
         return advance_action_t::ignore;
     }
+    if (auto &ignores = local_folder.get_folder()->get_ignores(); ignores && ignores->is_ignored(remote_name)) {
+        return advance_action_t::ignore;
+    }
     auto action = _resolve(remote, local, local_folder);
     if (action == advance_action_t::resolve_remote_win) {
         auto name = remote.get_name()->get_own_name();
@@ -4,12 +4,18 @@
 #include "cluster_supervisor.h"
 #include "controller_actor.h"
 #include "utils/format.hpp"
+#include "utils/location.h"
 #include "model/diff/contact/peer_state.h"
 
 using namespace syncspirit::net;
 
 cluster_supervisor_t::cluster_supervisor_t(config_t &config)
-    : parent_t{config}, config{config.config}, sequencer{config.sequencer} {}
+    : parent_t{config}, config{config.config}, sequencer{config.sequencer} {
+    auto &trace_file = this->config.bep_config.trace_file;
+    if (!trace_file.empty()) {
+        pull_tracer = new pull_tracer_t(utils::expand_home(trace_file, utils::get_home_dir()));
+    }
+}
 
 void cluster_supervisor_t::configure(r::plugin::plugin_base_t &plugin) noexcept {
     parent_t::configure(plugin);
@@ -24,6 +30,14 @@ void cluster_supervisor_t::on_start() noexcept {
     parent_t::on_start();
 }
 
+void cluster_supervisor_t::shutdown_finish() noexcept {
+    if (pull_tracer) {
+        pull_tracer->log_summary();
+        pull_tracer.reset();
+    }
+    parent_t::shutdown_finish();
+}
+
 void cluster_supervisor_t::visit(const model::diff::cluster_diff_t &diff,
                                  model::payload::apply_context_t &ctx) noexcept {
     LOG_TRACE(log, "visit");
@@ -56,6 +70,7 @@ auto cluster_supervisor_t::operator()(const model::diff::contact::peer_state_t &
                 .request_pool(bep.rx_buff_size)
                 .hasher_threads(config.hasher_threads)
                 .default_path(config.default_location)
+                .pull_tracer(pull_tracer)
                 .finish();
         }
     }
@@ -8,6 +8,7 @@
 #include "model_actor.hpp"
 #include "model/diff/cluster_visitor.h"
 #include "model/misc/sequencer.h"
+#include "pull_tracer.h"
 #include <boost/asio.hpp>
 #include <rotor/asio.hpp>
 
@@ -49,6 +50,7 @@ struct SYNCSPIRIT_API cluster_supervisor_t final : public model_actor_t<ra::supe
     void configure(r::plugin::plugin_base_t &plugin) noexcept override;
     void on_child_shutdown(actor_base_t *actor) noexcept override;
     void on_start() noexcept override;
+    void shutdown_finish() noexcept override;
     void visit(const model::diff::cluster_diff_t &, model::payload::apply_context_t &) noexcept override;
 
   private:
@@ -56,6 +58,7 @@ struct SYNCSPIRIT_API cluster_supervisor_t final : public model_actor_t<ra::supe
 
     config::main_t config;
     model::sequencer_ptr_t sequencer;
+    pull_tracer_ptr_t pull_tracer;
 };
 
 } // namespace net
@@ -67,6 +67,7 @@ struct peer_request_context_t final : fs::payload::extendended_context_t {
     proto::Request request;
     std::int64_t sequence;
     std::int32_t block_index;
+    utils::block_trace_t trace;
 };
 
 } // namespace
@@ -82,6 +83,7 @@ struct C::block_ack_context_t final : fs::payload::extendended_context_t {
     model::folder_info_ptr_t target_folder;
     model::folder_ptr_t folder;
     std::uint32_t block_index;
+    utils::block_trace_t trace;
 };
 
 struct C::stack_context_t : model::diff::diff_assember_t {
@@ -137,6 +139,7 @@ struct C::stack_context_t : model::diff::diff_assember_t {
     void push(fs::payload::io_command_t command) noexcept { io_commands.emplace_back(std::move(command)); }
     void push(fs::payload::append_block_t command) noexcept { push_checked(std::move(command)); }
     void push(fs::payload::clone_block_t command) noexcept { push_checked(std::move(command)); }
+    void push(fs::payload::clone_file_t command) noexcept { push_checked(std::move(command)); }
     void push(utils::bytes_t data) noexcept {
         peer_data.reserve(peer_data.size() + data.size());
         auto out = std::back_insert_iterator(peer_data);
@@ -278,7 +281,7 @@ controller_actor_t::controller_actor_t(config_t &config)
       peer_state{peer->get_state().clone()}, peer_address{config.peer_addr}, rx_blocks_requested{0},
       tx_blocks_requested{0}, outgoing_buffer_max{config.outgoing_buffer_max}, request_pool{config.request_pool},
       hasher_threads{config.hasher_threads}, advances_per_iteration{config.advances_per_iteration},
-      default_path(std::move(config.default_path)), announced{false} {
+      default_path(std::move(config.default_path)), pull_tracer{std::move(config.pull_tracer)}, announced{false} {
     {
         assert(cluster);
         assert(sequencer);
@@ -337,6 +340,9 @@ void controller_actor_t::on_start() noexcept {
     send<payload::controller_up_t>(coordinator, address, my_url->clone(), peer->device_id(), outgoing_buffer);
     send_cluster_config(stack_ctx);
     resources->acquire(resource::peer);
+    if (pull_tracer) {
+        pull_tracer->add_peer(peer->device_id().get_uint(), peer->device_id().get_short());
+    }
     LOG_INFO(log, "is online (connection: {})", my_url);
     announced = true;
 }
@@ -424,7 +430,8 @@ void controller_actor_t::on_postprocess_io(fs::message::io_commands_t &message)
                 if constexpr (std::is_same_v<T, p::block_request_t>) {
                     postprocess_io(cmd, stack_ctx);
                 } else {
-                    constexpr auto modify = std::is_same_v<T, p::append_block_t> || std::is_same_v<T, p::clone_block_t>;
+                    constexpr auto modify = std::is_same_v<T, p::append_block_t> ||
+                                            std::is_same_v<T, p::clone_block_t> || std::is_same_v<T, p::clone_file_t>;
                     if constexpr (modify) {
                         cluster->modify_write_requests(+1);
                     }
@@ -567,6 +574,10 @@ OUTER:
             }
             auto ld = compare_with_local(*file, local_file);
             if (ld == local_difference_t::content) {
+                if (io_clone_file(local_file, *file, *peer_folder, action, context)) {
+                    ++advances;
+                    continue;
+                }
                 auto bi = model::block_iterator_ptr_t();
                 bi = new model::blocks_iterator_t(*file, *peer_folder);
                 if (*bi) {
@@ -632,52 +643,46 @@ void controller_actor_t::io_advance(model::advance_action_t action, model::file_
 }
 
 void controller_actor_t::io_append_block(model::file_info_t &peer_file, model::folder_info_t &peer_folder,
-                                         uint32_t block_index, utils::bytes_t data, stack_context_t &ctx) {
+                                         uint32_t block_index, utils::bytes_t data, stack_context_t &ctx,
+                                         const utils::block_trace_t *trace) {
     auto path = peer_file.get_path(peer_folder);
     auto file_size = peer_file.get_size();
     auto block = const_cast<model::block_info_t *>(peer_file.iterate_blocks(block_index).next());
     auto offset = peer_file.get_block_offset(block_index);
     auto context = fs::payload::extendended_context_prt_t{};
-    context.reset(new block_ack_context_t(block, peer_file, peer_folder, block_index));
+    auto ack_context = new block_ack_context_t(block, peer_file, peer_folder, block_index);
+    context.reset(ack_context);
     auto folder_id = std::string(peer_folder.get_folder()->get_id());
     auto payload =
         fs::payload::append_block_t(std::move(context), std::move(folder_id), path, std::move(data), offset, file_size);
+    if (payload.data.empty()) {
+        payload.zeroes = block->get_size();
+    }
+    payload.preallocate = peer_folder.get_folder()->is_preallocated();
+    payload.uncached = peer_folder.get_folder()->is_uncached();
+    payload.journal = {peer_file.get_modified_s(), block_index, utils::bytes_t(block->get_hash())};
+    if (trace) {
+        ack_context->trace = *trace;
+        ack_context->trace.mark(utils::block_stage_t::write_queued);
+        payload.trace = &ack_context->trace;
+    }
     ctx.push(std::move(payload));
 }
 
-void controller_actor_t::io_clone_block(const model::file_block_t &file_block, model::folder_info_t &target_fi,
-                                        stack_context_t &ctx) {
-    auto src = (const model::file_info_t *)(nullptr);
+void controller_actor_t::io_clone_block(const model::file_block_t &file_block, const model::block_source_t &source,
+                                        model::folder_info_t &target_fi, stack_context_t &ctx) {
+    auto src = source.file;
     auto target = const_cast<model::file_info_t *>(file_block.file());
     auto block = const_cast<model::block_info_t *>(file_block.block());
-    auto it = block->iterate_blocks();
-    auto src_block_index = std::uint32_t(0);
-    auto src_fi = (const model::folder_info_t *)(nullptr);
+    auto src_block_index = source.block_index;
     auto target_block_index = file_block.block_index();
-    while (auto b = it.next()) {
-        if (b->is_locally_available()) {
-            src_block_index = b->block_index();
-            src = b->file();
-            auto folder_uuid = src->get_folder_uuid();
-            for (auto &folder_it : cluster->get_folders()) {
-                if (auto fi = folder_it.item->get_folder_infos().by_uuid(folder_uuid)) {
-                    src_fi = fi.get();
-                    break;
-                }
-            }
-            if (src_fi) {
-                break;
-            }
-        }
-    }
-    assert(src_fi);
 
-    auto source_path = src->get_path(*src_fi);
-    auto source_offset = src->get_block_offset(src_block_index);
+    auto source_path = src->get_path(*source.folder_info);
+    auto source_offset = source.offset;
     auto target_path = target->get_path(target_fi);
     auto target_offset = target->get_block_offset(target_block_index);
     auto target_sz = target->get_size();
-    auto block_sz = src->iterate_blocks(src_block_index).next()->get_size();
+    auto block_sz = block->get_size();
     auto context = fs::payload::extendended_context_prt_t{};
     context.reset(new block_ack_context_t(block, *target, target_fi, target_block_index));
     auto folder_id = std::string(target_fi.get_folder()->get_id());
@@ -686,9 +691,48 @@ void controller_actor_t::io_clone_block(const model::file_block_t &file_block, m
               target_block_index);
     auto payload = fs::payload::clone_block_t(std::move(context), std::move(folder_id), target_path, target_offset,
                                               target_sz, source_path, source_offset, block_sz);
+    payload.preallocate = target_fi.get_folder()->is_preallocated();
+    payload.uncached = target_fi.get_folder()->is_uncached();
+    payload.journal = {target->get_modified_s(), target_block_index, utils::bytes_t(block->get_hash())};
     ctx.push(std::move(payload));
 }
 
+bool controller_actor_t::io_clone_file(model::file_info_t *local_file, model::file_info_t &peer_file,
+                                       model::folder_info_t &peer_folder, model::advance_action_t action,
+                                       stack_context_t &ctx) {
+    using A = model::advance_action_t;
+    if (action != A::remote_copy && action != A::resolve_remote_win) {
+        return false;
+    }
+    auto source = cluster->find_file_source(peer_file);
+    if (!source) {
+        return false;
+    }
+
+    auto path = peer_file.get_path(peer_folder);
+    auto source_path = source.file->get_path(*source.folder_info);
+    auto conflict_path = bfs::path();
+    if (action == A::resolve_remote_win) {
+        assert(local_file);
+        conflict_path = peer_folder.get_folder()->get_path() / bfs::path(local_file->make_conflicting_name());
+    }
+    auto perms = peer_file.get_permissions();
+    bool no_permissions = !utils::platform_t::permissions_supported(path) ||
+                          peer_folder.get_folder()->are_permissions_ignored() || peer_file.has_no_permissions();
+
+    LOG_DEBUG(log, "file '{}' is identical to local '{}', cloning it as whole", peer_file, *source.file);
+    synchronizing_files.emplace(peer_file.get_full_id(), peer_file.guard(peer_folder));
+
+    auto context = fs::payload::extendended_context_prt_t{};
+    context.reset(new file_context_t(peer_file, peer_folder, action));
+    auto folder_id = std::string(peer_folder.get_folder()->get_id());
+    auto payload = fs::payload::clone_file_t(std::move(context), std::move(folder_id), std::move(path),
+                                             std::move(conflict_path), std::move(source_path), peer_file.get_size(),
+                                             peer_file.get_modified_s(), perms, no_permissions);
+    ctx.push(std::move(payload));
+    return true;
+}
+
 void controller_actor_t::io_finish_file(model::file_info_t *local_file, model::file_info_t &peer_file,
                                         model::folder_info_t &peer_folder, model::advance_action_t action,
                                         stack_context_t &ctx) {
@@ -734,6 +778,9 @@ auto controller_actor_t::io_make_request_block(model::file_info_t &source, model
     auto context = fs::payload::extendended_context_prt_t{};
     context.reset(new block_request_context_t(std::move(req)));
     auto payload = fs::payload::block_request_t(std::move(context), std::move(path), offset, block_size);
+    auto &folder = *source_fi.get_folder();
+    payload.folder_id = folder.get_id();
+    payload.uncached = folder.is_uncached();
     return payload;
 }
 
@@ -751,10 +798,20 @@ void controller_actor_t::preprocess_block(model::file_block_t &file_block, const
 
     auto hash = block->get_hash();
     auto last_index = file->iterate_blocks(0).get_total() - 1;
+    auto source = model::block_source_t{};
     if (file_block.is_locally_available()) {
+        source = cluster->find_block_source(*block);
+    }
+    if (block->is_zero()) {
+        LOG_TRACE(log, "block '{}' of '{}' (#{}) is all zeroes, no need to request it", hash, *file,
+                  file_block.block_index());
+        ctx.lock_block(*block);
+        auto &peer_folder = const_cast<model::folder_info_t &>(source_folder);
+        io_append_block(const_cast<model::file_info_t &>(*file), peer_folder, file_block.block_index(), {}, ctx);
+    } else if (source && is_readable(source)) {
         auto &folder_infos = source_folder.get_folder()->get_folder_infos();
         auto target_fi = folder_infos.by_uuid(file->get_folder_uuid());
-        io_clone_block(file_block, *target_fi, ctx);
+        io_clone_block(file_block, source, *target_fi, ctx);
     } else {
         ctx.lock_block(*block);
         auto request_id = block_requests_next;
@@ -792,7 +849,12 @@ void controller_actor_t::preprocess_block(model::file_block_t &file_block, const
         ctx.push(proto::serialize(req, peer->get_compression()));
 
         auto context = fs::payload::extendended_context_prt_t{};
-        context.reset(new peer_request_context_t(std::move(req), file->get_sequence(), file_block.block_index()));
+        auto request_context =
+            new peer_request_context_t(std::move(req), file->get_sequence(), file_block.block_index());
+        if (pull_tracer) {
+            request_context->trace.mark(utils::block_stage_t::requested);
+        }
+        context.reset(request_context);
         block_requests[request_id] = std::move(context);
         ++rx_blocks_requested;
         request_pool -= (int64_t)sz;
@@ -1153,6 +1215,9 @@ void controller_actor_t::on_message(proto::Response &message, stack_context_t &c
     }
     auto peer_context = static_cast<peer_request_context_t *>(request_context.get());
     block_requests_next = request_id;
+    if (pull_tracer) {
+        peer_context->trace.mark(utils::block_stage_t::received);
+    }
 
     auto block_hash = proto::get_hash(peer_context->request);
     auto folder_id = proto::get_folder(peer_context->request);
@@ -1260,6 +1325,11 @@ void controller_actor_t::postprocess_io(fs::payload::remote_copy_t &res, stack_c
 
 void controller_actor_t::postprocess_io(fs::payload::append_block_t &res, stack_context_t &ctx) noexcept {
     auto io_ctx = static_cast<block_ack_context_t *>(res.context.get());
+    if (pull_tracer && res.trace) {
+        io_ctx->trace.mark(utils::block_stage_t::acked);
+        auto name = io_ctx->target_file->get_name()->get_full_name();
+        pull_tracer->record(peer->device_id().get_uint(), name, io_ctx->block_index, io_ctx->trace);
+    }
     if (res.result) {
         ctx.ack_block(io_ctx, true);
     } else {
@@ -1280,6 +1350,20 @@ void controller_actor_t::postprocess_io(fs::payload::clone_block_t &res, stack_c
     }
 }
 
+void controller_actor_t::postprocess_io(fs::payload::clone_file_t &res, stack_context_t &ctx) noexcept {
+    using namespace model::diff;
+    auto io_ctx = static_cast<file_context_t *>(res.context.get());
+
+    if (res.result) {
+        auto diff = advance::advance_t::create(io_ctx->action, *io_ctx->peer_file, *io_ctx->peer_folder, *sequencer);
+        ctx.push_back(diff.get());
+    } else {
+        auto name = io_ctx->peer_file->get_name()->get_full_name();
+        auto folder_id = io_ctx->peer_folder->get_folder()->get_id();
+        ctx.mark_unreachable(name, folder_id);
+    }
+}
+
 void controller_actor_t::postprocess_io(fs::payload::finish_file_t &res, stack_context_t &ctx) noexcept {
     using namespace model::diff;
     auto io_ctx = static_cast<file_context_t *>(res.context.get());
@@ -1382,7 +1466,12 @@ void controller_actor_t::on_digest(hasher::message::digest_t &res) noexcept {
                 try_next = true;
                 do_release_block = true;
             } else {
-                io_append_block(*file, *peer_folder, index, std::move(data), stack_ctx);
+                auto trace = (const utils::block_trace_t *)(nullptr);
+                if (pull_tracer) {
+                    peer_context->trace.mark(utils::block_stage_t::hashed);
+                    trace = &peer_context->trace;
+                }
+                io_append_block(*file, *peer_folder, index, std::move(data), stack_ctx, trace);
             }
         }
     }
@@ -1460,6 +1549,12 @@ void controller_actor_t::cancel_sync(model::file_info_t *file) noexcept {
     }
 }
 
+bool controller_actor_t::is_readable(const model::block_source_t &source) noexcept {
+    // partially downloaded files are accessible only via opened (by this
+    // controller) temporal files
+    return source.complete || synchronizing_files.count(source.file->get_full_id());
+}
+
 bool controller_actor_t::is_unflushed(model::file_info_t *peer_file, model::folder_info_t &peer_folder) noexcept {
     if (peer_file->is_file()) {
         auto peer_blocks_it = peer_file->iterate_blocks(0);
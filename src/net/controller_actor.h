@@ -5,6 +5,7 @@
 
 #include "messages.h"
 #include "model_actor.hpp"
+#include "pull_tracer.h"
 #include "model/messages.h"
 #include "model/diff/cluster_visitor.h"
 #include "model/diff/diff_assembler.h"
@@ -43,6 +44,7 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
         uint32_t outgoing_buffer_max = 0;
         std::uint32_t advances_per_iteration = 10;
         bfs::path default_path;
+        pull_tracer_ptr_t pull_tracer;
     };
 
     template <typename Actor> struct config_builder_t : parent_t::template config_builder_t<Actor> {
@@ -99,6 +101,11 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
             base_t::config.default_path = value;
             return std::move(*static_cast<typename base_t::builder_t *>(this));
         }
+
+        builder_t &&pull_tracer(pull_tracer_ptr_t value) && noexcept {
+            base_t::config.pull_tracer = std::move(value);
+            return std::move(*static_cast<typename base_t::builder_t *>(this));
+        }
     };
 
     // clang-format off
@@ -163,6 +170,7 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
     void postprocess_io(fs::payload::append_block_t &, stack_context_t &) noexcept;
     void postprocess_io(fs::payload::finish_file_t &, stack_context_t &) noexcept;
     void postprocess_io(fs::payload::clone_block_t &, stack_context_t &) noexcept;
+    void postprocess_io(fs::payload::clone_file_t &, stack_context_t &) noexcept;
     void postprocess_io(fs::payload::update_meta_t &, stack_context_t &) noexcept;
 
     void request_block(const model::file_block_t &block) noexcept;
@@ -174,8 +182,11 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
     void io_advance(model::advance_action_t action, model::file_info_t &peer_file, model::folder_info_t &peer_folder,
                     model::file_info_t *local_file, stack_context_t &);
     void io_append_block(model::file_info_t &, model::folder_info_t &, uint32_t block_index, utils::bytes_t data,
-                         stack_context_t &);
-    void io_clone_block(const model::file_block_t &file_block, model::folder_info_t &target_fi, stack_context_t &);
+                         stack_context_t &, const utils::block_trace_t *trace = nullptr);
+    void io_clone_block(const model::file_block_t &file_block, const model::block_source_t &source,
+                        model::folder_info_t &target_fi, stack_context_t &);
+    bool io_clone_file(model::file_info_t *, model::file_info_t &, model::folder_info_t &, model::advance_action_t,
+                       stack_context_t &);
     void io_finish_file(model::file_info_t *, model::file_info_t &, model::folder_info_t &, model::advance_action_t,
                         stack_context_t &);
     void io_update_meta(model::file_info_t &, model::folder_info_t &, model::advance_action_t, stack_context_t &);
@@ -189,6 +200,7 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
     folder_synchronization_t &get_sync_info(model::folder_t *folder) noexcept;
     folder_synchronization_t &get_sync_info(std::string_view folder_id) noexcept;
     void cancel_sync(model::file_info_t *) noexcept;
+    bool is_readable(const model::block_source_t &source) noexcept;
     bool is_unflushed(model::file_info_t *peer_file, model::folder_info_t &peer_folder) noexcept;
     local_difference_t compare_with_local(model::file_info_t &peer_file, model::file_info_t *local_file) noexcept;
 
@@ -222,6 +234,7 @@ struct SYNCSPIRIT_API controller_actor_t final : public model_actor_t<r::actor_b
     uint32_t blocks_max_requested;
     uint32_t advances_per_iteration;
     bfs::path default_path;
+    pull_tracer_ptr_t pull_tracer;
     updates_streamer_ptr_t updates_streamer;
     model::file_iterator_ptr_t file_iterator;
     model::block_iterator_ptr_t block_iterator;
@@ -25,6 +25,7 @@
 #include "model/diff/load/pending_devices.h"
 #include "model/diff/load/pending_folders.h"
 #include "model/diff/load/remove_corrupted_files.h"
+#include "model/diff/local/stat_update.h"
 #include "model/diff/modify/add_blocks.h"
 #include "model/diff/modify/add_ignored_device.h"
 #include "model/diff/modify/add_pending_device.h"
@@ -986,6 +987,41 @@ auto db_actor_t::operator()(const model::diff::advance::advance_t &diff, void *c
     return force_commit();
 }
 
+auto db_actor_t::operator()(const model::diff::local::stat_update_t &diff, void *custom) noexcept
+    -> outcome::result<void> {
+    if (cluster->is_tainted()) {
+        return outcome::success();
+    }
+
+    auto folder = cluster->get_folders().by_id(diff.folder_id);
+    if (folder && !folder->is_suspended()) {
+        auto folder_info = folder->get_folder_infos().by_device(*cluster->get_device());
+        auto file = folder_info ? folder_info->get_file_infos().by_name(diff.name) : model::file_info_ptr_t();
+        if (file) {
+            auto txn_opt = get_txn();
+            if (!txn_opt) {
+                return txn_opt.assume_error();
+            }
+            auto &txn = *txn_opt.assume_value();
+            unsigned char key[model::file_info_t::data_length + 1];
+            key[0] = db::prefix::file_info;
+            auto id = file->get_full_id();
+            std::copy(id.begin(), id.end(), key + 1);
+            auto data = file->serialize();
+            auto r = db::save({key, data}, txn);
+            if (!r) {
+                return r.assume_error();
+            }
+        }
+    }
+
+    auto r = diff.visit_next(*this, custom);
+    if (!r) {
+        return r.assume_error();
+    }
+    return commit_on_demand();
+}
+
 auto db_actor_t::operator()(const model::diff::peer::update_folder_t &diff, void *custom) noexcept
     -> outcome::result<void> {
     if (cluster->is_tainted()) {
@@ -129,6 +129,7 @@ struct SYNCSPIRIT_API db_actor_t final : public model_actor_t<r::actor_base_t>,
     outcome::result<void> operator()(const model::diff::contact::ignored_connected_t &, void *) noexcept override;
     outcome::result<void> operator()(const model::diff::contact::unknown_connected_t &, void *) noexcept override;
     outcome::result<void> operator()(const model::diff::load::remove_corrupted_files_t &, void *) noexcept override;
+    outcome::result<void> operator()(const model::diff::local::stat_update_t &, void *) noexcept override;
     outcome::result<void> operator()(const model::diff::modify::add_blocks_t &, void *) noexcept override;
     outcome::result<void> operator()(const model::diff::modify::add_ignored_device_t &, void *) noexcept override;
     outcome::result<void> operator()(const model::diff::modify::add_pending_device_t &, void *) noexcept override;
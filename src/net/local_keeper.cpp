@@ -3,11 +3,13 @@
 
 #include "local_keeper.h"
 #include "constants.h"
+#include "fs/task/scan_dir.h"
 #include "fs/utils.h"
 #include "local_keeper/folder_context.h"
 #include "local_keeper/folder_slave.h"
 #include "local_keeper/hash_context.h"
 #include "model/diff/advance/local_update.h"
+#include "model/diff/local/ignores_update.h"
 #include "model/diff/local/scan_finish.h"
 #include "model/diff/local/scan_start.h"
 #include "model/diff/modify/remove_folder.h"
@@ -47,6 +49,9 @@ struct local_keeper_t::lc_context_t final : local_keeper::stack_context_t {
     lc_context_t(local_keeper_t *k, folder_slave_t *slave) noexcept
         : parent_t(*k->cluster, *k->sequencer, k->concurrent_hashes_left, k->concurrent_hashes_limit, k->watcher_impl),
           actor(k), name_2_file(allocator), file_2_name(allocator) {
+        prune_dirs = k->prune_dirs;
+        strict_pruning = k->strict_pruning;
+        racy_window = k->racy_window;
         if (slave && !actor->delayed.empty()) {
             slave->push(std::move(actor->delayed));
         }
@@ -90,7 +95,8 @@ struct local_keeper_t::lc_context_t final : local_keeper::stack_context_t {
 local_keeper_t::local_keeper_t(config_t &config)
     : parent_t(config), sequencer{std::move(config.sequencer)},
       concurrent_hashes_left{static_cast<std::int32_t>(config.concurrent_hashes)},
-      concurrent_hashes_limit{concurrent_hashes_left}, watcher_impl{config.watcher_impl} {
+      concurrent_hashes_limit{concurrent_hashes_left}, watcher_impl{config.watcher_impl},
+      prune_dirs{config.prune_dirs}, strict_pruning{config.strict_pruning}, racy_window{config.racy_window} {
     assert(sequencer);
     assert(concurrent_hashes_left);
 }
@@ -183,6 +189,26 @@ void local_keeper_t::on_thread_ready(model::message::thread_ready_t &message) no
     if (p.thread_id == std::this_thread::get_id()) {
         LOG_TRACE(log, "on_thread_ready");
         cluster = message.payload.cluster;
+        for (auto &[folder, _] : cluster->get_folders()) {
+            load_ignores(*folder);
+        }
+    }
+}
+
+// the patterns have to be known before pulling, i.e. they cannot wait for the first scan
+void local_keeper_t::load_ignores(model::folder_t &folder) noexcept {
+    auto ignores = fs::task::scan_dir_t::read_ignores(folder.get_path());
+    auto diff = model::diff::cluster_diff_ptr_t();
+    if (!ignores) {
+        auto &ec = ignores.assume_error();
+        LOG_WARN(log, "cannot load ignores of folder '{}': {}, suspending", folder.get_id(), ec.message());
+        diff = new model::diff::modify::suspend_folder_t(folder, true, ec);
+    } else if (auto &patterns = ignores.assume_value(); patterns) {
+        LOG_DEBUG(log, "folder '{}' uses {} ignore pattern(s)", folder.get_id(), patterns->size());
+        diff = new model::diff::local::ignores_update_t(folder.get_id(), patterns);
+    }
+    if (diff) {
+        send<model::payload::model_update_t>(coordinator, std::move(diff));
     }
 }
 
@@ -277,6 +303,7 @@ void local_keeper_t::on_create_dir(fs::message::create_dir_t &message) noexcept
             diff = new model::diff::modify::suspend_folder_t(*folder, true, ec);
             send<model::payload::model_update_t>(coordinator, std::move(diff));
         } else {
+            load_ignores(*folder);
             if (folder->is_watched() && watcher_impl != syncspirit_watcher_impl_t::none) {
                 route<fs::payload::watch_folder_t>(watcher_addr, address, folder->get_path(), p.folder_id);
             }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "constants.h"
 #include "fs/messages.h"
 #include "hasher/messages.h"
 #include "model_actor.hpp"
@@ -34,6 +35,9 @@ struct SYNCSPIRIT_API local_keeper_t final : public model_actor_t<r::actor_base_
         model::sequencer_ptr_t sequencer;
         uint32_t concurrent_hashes;
         syncspirit_watcher_impl_t watcher_impl = syncspirit_watcher_impl_t::none;
+        bool prune_dirs = false;
+        bool strict_pruning = false;
+        std::int64_t racy_window = constants::racy_ctime_window;
     };
 
     template <typename Actor> struct config_builder_t : parent_t::template config_builder_t<Actor> {
@@ -53,6 +57,18 @@ struct SYNCSPIRIT_API local_keeper_t final : public model_actor_t<r::actor_base_
             base_t::config.watcher_impl = value;
             return std::move(*static_cast<typename base_t::builder_t *>(this));
         }
+        builder_t &&prune_dirs(bool value) && noexcept {
+            base_t::config.prune_dirs = value;
+            return std::move(*static_cast<typename base_t::builder_t *>(this));
+        }
+        builder_t &&strict_pruning(bool value) && noexcept {
+            base_t::config.strict_pruning = value;
+            return std::move(*static_cast<typename base_t::builder_t *>(this));
+        }
+        builder_t &&racy_window(std::int64_t value) && noexcept {
+            base_t::config.racy_window = value;
+            return std::move(*static_cast<typename base_t::builder_t *>(this));
+        }
     };
 
     struct lc_context_t;
@@ -82,6 +98,7 @@ struct SYNCSPIRIT_API local_keeper_t final : public model_actor_t<r::actor_base_
                        lc_context_t &stack_ctx) noexcept;
 
     void try_start_watching() noexcept;
+    void load_ignores(model::folder_t &folder) noexcept;
 
     outcome::result<void> operator()(const model::diff::advance::local_update_t &, void *custom) noexcept override;
     outcome::result<void> operator()(const model::diff::local::scan_start_t &, void *custom) noexcept override;
@@ -96,6 +113,9 @@ struct SYNCSPIRIT_API local_keeper_t final : public model_actor_t<r::actor_base_
     std::int32_t concurrent_hashes_left;
     std::int32_t concurrent_hashes_limit;
     std::int32_t fs_tasks = 0;
+    bool prune_dirs;
+    bool strict_pruning;
+    std::int64_t racy_window;
     folder_contexts_t delayed;
     dirs_t just_created_dirs;
     bool started_watching = false;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #include "child_info.h"
 #include "fs/utils.h"
@@ -33,6 +33,12 @@ child_info_t::child_info_t(fs::task::scan_dir_t::child_info_t backend, presentat
     }();
     auto &status = backend.status;
     perms = static_cast<std::uint32_t>(status.permissions());
+    if (type != proto::FileInfoType::SYMLINK) {
+        stat.device = backend.device;
+        stat.inode = backend.inode;
+        stat.ctime_s = backend.ctime_s;
+        stat.ctime_ns = backend.ctime_ns;
+    }
     ec = backend.ec;
 }
 
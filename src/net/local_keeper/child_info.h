@@ -34,6 +34,7 @@ struct child_info_t {
     std::uintmax_t size;
     proto::FileInfoType type;
     std::uint32_t perms;
+    model::local_stat_t stat; // of files and dirs
     sys::error_code ec;
     presentation::presence_ptr_t self;
     presentation::presence_ptr_t parent;
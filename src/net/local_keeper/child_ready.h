@@ -8,9 +8,10 @@
 namespace syncspirit::net::local_keeper {
 
 struct child_ready_t : child_info_t {
-    inline child_ready_t(child_info_t info, blocks_t blocks_ = {})
-        : child_info_t{std::move(info)}, blocks{std::move(blocks_)} {}
+    inline child_ready_t(child_info_t info, blocks_t blocks_ = {}, bool relinked_ = false)
+        : child_info_t{std::move(info)}, blocks{std::move(blocks_)}, relinked{relinked_} {}
     blocks_t blocks;
+    bool relinked; // blocks are taken from a renamed file, i.e. without hashing
 };
 
 struct undo_child_ready_t {
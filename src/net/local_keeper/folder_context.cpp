@@ -9,7 +9,9 @@
 #include "model/diff/advance/local_update.h"
 #include "model/diff/local/blocks_availability.h"
 #include "model/diff/local/file_availability.h"
+#include "model/diff/local/ignores_update.h"
 #include "model/diff/local/scan_finish.h"
+#include "model/diff/local/stat_update.h"
 #include "model/diff/modify/mark_reachable.h"
 #include "model/diff/modify/suspend_folder.h"
 #include "presentation/folder_entity.h"
@@ -36,6 +38,28 @@ struct rename_context_t final : hasher::payload::extendended_context_t {
     rehashed_incomplete_t item;
 };
 
+struct journal_context_t final : hasher::payload::extendended_context_t {
+    journal_context_t(hash_incomplete_file_ptr_t hash_file_) : hash_file(std::move(hash_file_)) {}
+    hash_incomplete_file_ptr_t hash_file;
+};
+
+/* kqueue watches files of the directory as they are listed */
+static bool is_strict(const scan_dir_t &task, const stack_context_t &ctx) noexcept {
+    using I = syncspirit_watcher_impl_t;
+    return ctx.strict_pruning && !(task.notify && ctx.watcher_impl == I::kqueue);
+}
+
+static auto get_blocks(const model::file_info_t &file) noexcept -> child_info_t::blocks_t {
+    auto data = file.as_proto(true);
+    auto blocks = child_info_t::blocks_t();
+    auto blocks_count = proto::get_blocks_size(data);
+    blocks.reserve(blocks_count);
+    for (size_t i = 0; i < blocks_count; ++i) {
+        blocks.emplace_back(proto::get_blocks(data, i));
+    }
+    return blocks;
+}
+
 auto make_context(model::folder_info_ptr_t local_folder, std::string_view start_subdir, bool recurse) noexcept
     -> folder_context_ptr_t {
     auto folder = local_folder->get_folder();
@@ -103,6 +127,10 @@ folder_context_t::folder_context_t(model::folder_info_ptr_t local_folder_, local
     log = utils::get_logger(fmt::format("net.f/{}", local_folder->get_folder()->get_id()));
     auto folder = local_folder->get_folder();
     ignore_permissions = folder->are_permissions_ignored() || !utils::platform_t::permissions_supported(initial_path);
+    ignores = folder->get_ignores();
+    // the patterns might have been changed while the app was not running, so
+    // the entries of unchanged dirs have to be re-evaluated on the first scan
+    ignores_changed = ignores && folder->get_scan_finish().is_not_a_date_time();
 }
 
 bool folder_context_t::process_stack(stack_context_t &ctx) noexcept {
@@ -116,6 +144,13 @@ bool folder_context_t::process_stack(stack_context_t &ctx) noexcept {
                 stack.erase(it);
             }
         }
+        if (ready_scan) {
+            auto scanned = std::move(*ready_scan);
+            ready_scan.reset();
+            post_process(scanned.task, ctx);
+            // the directory content is as old as the scan is
+            scan_generation[scanned.task.path.generic_string()] = scanned.generation;
+        }
         try_next = r > 0;
         if (try_next) {
             if (ctx.is_overused() && !stack.empty() && has_no_tasks()) {
@@ -142,19 +177,53 @@ int folder_context_t::process(complete_scan_t &, stack_context_t &ctx) noexcept
 
 int folder_context_t::process(unscanned_dir_t &dir, stack_context_t &ctx) noexcept {
     using I = syncspirit_watcher_impl_t;
-    auto it = scan_generation.find(dir.path.generic_string());
+    auto dir_key = dir.path.generic_string();
+    auto it = scan_generation.find(dir_key);
     auto skip_scan = false;
     if (it != scan_generation.end()) {
         skip_scan = it->second > dir.generation;
     }
 
     auto dir_str = narrow(dir.path.generic_wstring());
+    auto it_ahead = scanned_ahead.find(dir_key);
+    if (it_ahead != scanned_ahead.end()) {
+        auto use = !skip_scan && dir.single_child.empty();
+        if (use) {
+            LOG_TRACE(log, "using scanned ahead '{}'", dir_str);
+            if (ctx.prune_dirs && dir.dir_info && dir.dir_info->stat) {
+                dir_stats[dir_key] = dir.dir_info->stat;
+            }
+            auto &task = it_ahead->second.task;
+            task.presence = std::move(dir.presence);
+            task.recurse = dir.recurse;
+            task.requires_refinement = dir.requires_refinement;
+            ready_scan.emplace(std::move(it_ahead->second));
+        }
+        scanned_ahead.erase(it_ahead);
+        if (use) {
+            return 1;
+        }
+    }
+
     if (!skip_scan) {
         auto notify_watcher = ((ctx.watcher_impl == I::inotify) || (ctx.watcher_impl == I::kqueue)) &&
                               local_folder->get_folder()->is_watched();
         LOG_TRACE(log, "scheduling scan of '{}' (notify: {})", dir_str, notify_watcher);
         auto sub_task = scan_dir_t(std::move(dir.path), std::move(dir.presence), std::move(dir.single_child),
                                    notify_watcher, dir.recurse, dir.requires_refinement);
+        assign_ignores(sub_task);
+        auto &root_path = local_folder->get_folder()->get_path();
+        sub_task.load_ignores = sub_task.path == root_path && sub_task.single_child.empty();
+        if (ctx.prune_dirs) {
+            auto pruned = !ignores_changed && prune(dir, sub_task, ctx);
+            if (!pruned && dir.dir_info && dir.dir_info->stat) {
+                dir_stats[dir_key] = dir.dir_info->stat;
+            }
+        }
+        auto prefetch = !sub_task.pruned && (!ctx.prune_dirs || !has_recorded_dirs(sub_task.presence.get()));
+        if (prefetch && dir.recurse && scanned_ahead.size() < constants::max_scanned_ahead) {
+            sub_task.prefetch = constants::max_scanned_ahead - static_cast<std::uint32_t>(scanned_ahead.size());
+        }
         push(std::move(sub_task));
         return 0;
     } else {
@@ -163,6 +232,28 @@ int folder_context_t::process(unscanned_dir_t &dir, stack_context_t &ctx) noexce
     }
 }
 
+int folder_context_t::process(dir_scanned_t &item, stack_context_t &ctx) noexcept {
+    auto hashing_pending = hashing > 0 || std::any_of(pending_io.begin(), pending_io.end(), [](auto &task) {
+                               return std::holds_alternative<fs::task::segment_iterator_t>(task);
+                           });
+    if (item.failures != failures || hashing_pending) {
+        return 1;
+    }
+    auto presence = item.presence.get();
+    auto features = presence->get_features();
+    if ((features & F::local) && (features & F::directory) && !(features & F::deleted)) {
+        auto dir_presence = static_cast<presentation::local_file_presence_t *>(presence);
+        auto &dir = dir_presence->get_file_info();
+        auto stat = dir.get_local_stat();
+        if (is_racy(item.stat, ctx)) {
+            LOG_TRACE(log, "'{}' has been changed recently, its stat is not recorded", dir.get_name()->get_full_name());
+        } else if (!stat || *stat != item.stat) {
+            ctx.push_back(new model::diff::local::stat_update_t(dir, *local_folder, item.stat));
+        }
+    }
+    return 1;
+}
+
 int folder_context_t::process(unexamined_t &child_info, stack_context_t &ctx) noexcept {
     auto file = child_info.fetch_model(*local_folder);
     auto &type = child_info.type;
@@ -197,6 +288,9 @@ int folder_context_t::process(unexamined_t &child_info, stack_context_t &ctx) no
                 LOG_DEBUG(log, "file '{}' is already scheduled for hashing", path_str);
             } else if (file) {
                 stack.emplace_front(child_ready_t(std::move(child_info)));
+            } else if (auto blocks = relink(child_info); !blocks.empty()) {
+                LOG_DEBUG(log, "file '{}' is a moved local file, no rehashing", path_str);
+                stack.emplace_front(child_ready_t(std::move(child_info), std::move(blocks), true));
             } else {
                 auto block_size = [&]() -> std::int32_t {
                     // for possible correct importing later at local-update.
@@ -288,6 +382,12 @@ int folder_context_t::process(child_ready_t &info, stack_context_t &ctx) noexcep
             if (!file->is_local()) {
                 ctx.push_back(new local::file_availability_t(*file, *local_folder));
             }
+            if (info.stat && type == FT::FILE) {
+                auto stat = file->get_local_stat();
+                if (!stat || *stat != info.stat) {
+                    ctx.push_back(new local::stat_update_t(*file, *local_folder, info.stat));
+                }
+            }
         } else {
             if (info.size && info.blocks.empty()) {
                 emit_hashing = true;
@@ -297,13 +397,19 @@ int folder_context_t::process(child_ready_t &info, stack_context_t &ctx) noexcep
         }
     }
     if (emit_hashing) {
-        auto ptr = hash_existing_file_ptr_t(new hash_existing_file_t(std::move(info)));
+        auto prev_block_size = file ? file->get_block_size() : 0;
+        auto ptr = hash_existing_file_ptr_t(new hash_existing_file_t(std::move(info), prev_block_size));
         stack.emplace_front(std::move(ptr));
     } else if (emit_update) {
         auto folder = local_folder->get_folder();
         auto folder_id = folder->get_id();
         auto data = info.serialize(*local_folder, std::move(info.blocks), ignore_permissions);
-        ctx.push_back(new advance::local_update_t(ctx.cluster, ctx.sequencer, std::move(data), folder_id));
+        auto diff = new advance::local_update_t(ctx.cluster, ctx.sequencer, std::move(data), folder_id, false,
+                                                info.relinked);
+        if (info.type == FT::FILE) {
+            diff->local_stat = info.stat;
+        }
+        ctx.push_back(diff);
     }
     return 1;
 }
@@ -336,7 +442,6 @@ int folder_context_t::process(hash_incomplete_file_ptr_t &item, stack_context_t
 int folder_context_t::process(removed_dir_t &item, stack_context_t &ctx) noexcept {
     using queue_t = std::pmr::list<presentation::presence_t *>;
     using processed_t = std::pmr::unordered_set<presentation::presence_t *>;
-    auto folder_id = local_folder->get_folder()->get_id();
 
     auto queue = queue_t(ctx.allocator);
     auto processed = processed_t(ctx.allocator);
@@ -372,9 +477,7 @@ int folder_context_t::process(removed_dir_t &item, stack_context_t &ctx) noexcep
             continue;
         } else {
             auto local = static_cast<presentation::local_file_presence_t *>(item);
-            auto data = local->get_file_info().as_proto(false);
-            proto::set_deleted(data, true);
-            ctx.push_back(new local_update_t(ctx.cluster, ctx.sequencer, std::move(data), folder_id));
+            push_removal(local->get_file_info(), ctx);
             queue.pop_front();
         }
     }
@@ -456,10 +559,13 @@ int folder_context_t::process(incomplete_t &item, stack_context_t &ctx) noexcept
             LOG_DEBUG(log, "scheduling(1) removal of '{}'", narrow(item.path.generic_wstring()));
             push(remove_file_t(std::move(item.path)));
         } else {
-            LOG_TRACE(log, "scheduling rehashing of '{}'", narrow(item.path.generic_wstring()));
+            // the file is rehashed only if there is no (valid) journal
+            LOG_TRACE(log, "scheduling journal loading of '{}'", narrow(item.path.generic_wstring()));
+            auto path = item.path;
             auto &child_info = static_cast<child_info_t &>(item);
             auto ptr = hash_incomplete_file_ptr_t(new hash_incomplete_file_t(std::move(child_info), presence, action));
-            stack.emplace_front(std::move(ptr));
+            auto journal_ctx = hasher::payload::extendended_context_prt_t(new journal_context_t(std::move(ptr)));
+            push(load_journal_t(std::move(path), std::move(journal_ctx)));
         }
     }
     return 1;
@@ -570,12 +676,13 @@ void folder_context_t::post_process(hash_base_t &hash_file, hasher::message::dig
         auto &ec = result.assume_error();
         LOG_WARN(log, "cannot hash '{}': {}", path_str, ec.message());
         ++hash_file.errored_blocks;
+        ++failures;
     } else {
         auto index = p.block_index;
         auto offset = index * hash_file.block_size;
         auto bi = proto::BlockInfo();
         proto::set_offset(bi, offset);
-        proto::set_size(bi, static_cast<std::int32_t>(p.data.size()));
+        proto::set_size(bi, static_cast<std::int32_t>(p.get_data().size()));
         proto::set_hash(bi, std::move(result).assume_value());
         hash_file.blocks[index] = std::move(bi);
     }
@@ -596,7 +703,13 @@ void folder_context_t::post_process(hash_base_t &hash_file, hasher::message::dig
 
 void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept {
     using checked_chidren_t = std::pmr::set<std::string_view>;
+    using paths_t = std::pmr::set<bfs::path>;
     scan_generation[task.path.generic_string()] = ++io_generation;
+    for (auto &ahead : task.prefetched) {
+        auto key = ahead.path.generic_string();
+        scanned_ahead.emplace(std::move(key), scanned_ahead_t{std::move(ahead), io_generation});
+    }
+    task.prefetched.clear();
     auto folder = local_folder->get_folder();
     auto &ec = task.ec;
     auto folder_id = folder->get_id();
@@ -612,6 +725,16 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
             }
         }
     }
+    if (task.load_ignores && !ec) {
+        auto &loaded = task.ignores;
+        auto same = (!ignores && !loaded) || (ignores && loaded && *ignores == *loaded);
+        if (!same) {
+            LOG_INFO(log, "using {} ignore pattern(s)", loaded ? loaded->size() : 0);
+            ignores = loaded;
+            ignores_changed = true;
+            ctx.push_back(new model::diff::local::ignores_update_t(folder_id, ignores));
+        }
+    }
     auto it_done = stack.begin();
     if (it_done != stack.end()) {
         if (auto ptr = std::get_if<child_ready_t>(&*it_done); !ptr) {
@@ -619,6 +742,14 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
         }
     }
 
+    auto dir_stat = std::optional<model::local_stat_t>();
+    if (auto it = dir_stats.find(task.path.generic_string()); it != dir_stats.end()) {
+        if (!task.ec) {
+            dir_stat = it->second;
+        }
+        dir_stats.erase(it);
+    }
+
     if (task.ec) {
         if (task.single_child.empty() || task.ec != std::errc::no_such_file_or_directory) {
             return handle_scan_error(task, ctx);
@@ -628,6 +759,7 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
             auto child = bfs::path(widen(p->get_file_info().get_name()->get_own_name()));
             auto sub_task = fs::task::scan_dir_t(std::move(path), std::move(p->get_parent()), std::move(child), false,
                                                  false, false);
+            assign_ignores(sub_task);
             push(std::move(sub_task));
             return;
         }
@@ -635,6 +767,24 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
 
     auto dir_presence = task.presence.get();
     auto checked_children = checked_chidren_t(ctx.allocator);
+    auto temporals = paths_t(ctx.allocator);
+    auto journals = paths_t(ctx.allocator);
+
+    if (task.pruned && dir_presence && is_strict(task, ctx)) {
+        // files have not been examined at all, i.e. they are not missing
+        for (auto child : dir_presence->get_children()) {
+            auto features = child->get_features();
+            if ((features & F::local) && !(features & (F::deleted | F::directory))) {
+                checked_children.emplace(child->get_entity()->get_path()->get_own_name());
+            }
+        }
+    }
+
+    auto it_scanned = stack.end();
+    if (dir_stat && dir_presence && task.single_child.empty()) {
+        // will be processed after all the children and their subdirectories
+        it_scanned = stack.insert(stack.begin(), dir_scanned_t{task.presence, *dir_stat, failures});
+    }
 
     auto &infos = task.child_infos;
     for (auto it_disk = infos.begin(); it_disk != infos.end(); ++it_disk) {
@@ -654,8 +804,12 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
         }
         if (info.ec) {
             log->warn("scannig of  {} failed: {}", name, info.ec.message());
+            ++failures;
         } else {
-            if (fs::is_temporal(info.path)) {
+            if (fs::is_journal(info.path)) {
+                journals.emplace(std::move(info.path));
+            } else if (fs::is_temporal(info.path)) {
+                temporals.emplace(info.path);
                 auto child = incomplete_t(std::move(info), presence, task.presence, io_generation);
                 stack.push_front(std::move(child));
             } else {
@@ -668,11 +822,28 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
         }
     }
 
+    if (it_scanned != stack.end() && (!temporals.empty() || !journals.empty())) {
+        // pending downloads are resumed via listing only, so such dirs are not recorded
+        stack.erase(it_scanned);
+    }
+
+    if (task.single_child.empty()) {
+        for (auto &journal : journals) {
+            auto target = journal;
+            target.replace_extension();
+            target.replace_extension();
+            if (!temporals.count(fs::make_temporal(target))) {
+                LOG_DEBUG(log, "scheduling removal of orphan journal '{}'", narrow(journal.generic_wstring()));
+                push(remove_file_t(journal));
+            }
+        }
+    }
+
     if (dir_presence) {
         auto dirs_stack = dirs_stack_t(stack);
         for (auto child : dir_presence->get_children()) {
             auto features = child->get_features();
-            if (features & F::local) {
+            if ((features & F::local) && !is_ignored(*child->get_entity())) {
                 auto filename = child->get_entity()->get_path()->get_own_name();
                 if (!checked_children.count(filename)) {
                     checked_children.emplace(filename);
@@ -688,10 +859,7 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
                             dirs_stack.push_front(removed_dir_t(child));
                         } else {
                             auto file = static_cast<presentation::local_file_presence_t *>(child);
-                            auto file_data = file->get_file_info().as_proto(false);
-                            proto::set_deleted(file_data, true);
-                            ctx.push_back(
-                                new local_update_t(ctx.cluster, ctx.sequencer, std::move(file_data), folder_id));
+                            push_removal(file->get_file_info(), ctx);
                         }
                     } else {
                         auto &target_stack = is_dir ? dirs_stack : stack;
@@ -705,7 +873,7 @@ void folder_context_t::post_process(fs::task::scan_dir_t &task, stack_context_t
         auto queue = queue_t(ctx.allocator);
         for (auto child_entity : dir_presence->get_entity()->get_children()) {
             auto filename = child_entity->get_path()->get_own_name();
-            if (!checked_children.count(filename)) {
+            if (!checked_children.count(filename) && !is_ignored(*child_entity)) {
                 auto best = child_entity->get_best();
                 if (best->get_features() & F::deleted) {
                     queue.emplace_back(child_entity);
@@ -741,6 +909,7 @@ void folder_context_t::post_process(fs::task::segment_iterator_t &task, stack_co
     ++io_generation;
     auto &ec = task.ec;
     if (ec) {
+        ++failures;
         hashing -= task.block_count;
         auto hash_ctx = static_cast<hash_context_t *>(task.context.get());
         auto delta = task.block_count - task.current_block;
@@ -796,6 +965,41 @@ void folder_context_t::post_process(fs::task::rename_file_t &task, stack_context
     }
 }
 
+void folder_context_t::post_process(fs::task::load_journal_t &task, stack_context_t &ctx) noexcept {
+    auto journal_ctx = static_cast<journal_context_t *>(task.context.get());
+    auto &hash_file = journal_ctx->hash_file;
+    auto &ec = task.ec;
+    auto &content = task.content;
+    auto path_str = narrow(task.path.generic_wstring());
+    if (ec) {
+        if (ec != std::errc::no_such_file_or_directory) {
+            LOG_WARN(log, "journal of '{}' is discarded: {}", path_str, ec.message());
+        }
+    } else {
+        auto cp = static_cast<const presentation::cluster_file_presence_t *>(hash_file->self.get());
+        auto &peer_file = cp->get_file_info();
+        auto same_version =
+            content.file_size == peer_file.get_size() && content.modification_s == peer_file.get_modified_s();
+        if (same_version && !content.blocks.empty()) {
+            LOG_DEBUG(log, "'{}' has {} journaled block(s), no rehashing", path_str, content.blocks.size());
+            auto blocks = std::move(hash_file->blocks);
+            for (std::size_t i = 0; i < blocks.size(); ++i) {
+                auto &block = blocks[i];
+                proto::set_offset(block, i * hash_file->block_size);
+                // unrecorded blocks are left without hash, i.e. they will be downloaded again
+                if (auto it = content.blocks.find(static_cast<std::uint32_t>(i)); it != content.blocks.end()) {
+                    proto::set_hash(block, std::move(it->second));
+                }
+            }
+            auto copy = static_cast<child_info_t &>(*hash_file);
+            stack.push_front(rehashed_incomplete_t(std::move(copy), std::move(blocks), hash_file->action));
+            return;
+        }
+        LOG_DEBUG(log, "journal of '{}' is outdated, rehashing", path_str);
+    }
+    stack.emplace_front(std::move(hash_file));
+}
+
 void folder_context_t::post_process(fs::task::noop_t &, stack_context_t &) noexcept {}
 
 void folder_context_t::push(fs::task_t task) noexcept { pending_io.emplace_back(std::move(task)); }
@@ -837,6 +1041,7 @@ int folder_context_t::schedule_hash(hash_base_t *item, stack_context_t &ctx) noe
     auto hash_context = hash_context_ptr_t(new hash_context_t(ctx.slave, this, item));
     auto sub_task = segment_iterator_t(ctx.get_back_address(), hash_context, item->path, offset, first_block,
                                        max_blocks, block_size, last_block_sz, item->last_write_time);
+    sub_task.uncached = folder->is_uncached();
     push(std::move(sub_task));
     blocks_limit -= max_blocks;
     auto blocks_left = item->unprocessed_blocks -= max_blocks;
@@ -849,6 +1054,7 @@ int folder_context_t::schedule_hash(hash_base_t *item, stack_context_t &ctx) noe
 
 void folder_context_t::handle_scan_error(fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept {
     auto &ec = task.ec;
+    ++failures;
     log->warn("cannot scan '{}': {}", narrow(task.path.wstring()), ec.message());
     auto dir_presence = task.presence.get();
     if (dir_presence && dir_presence->get_features() & F::local) {
@@ -877,6 +1083,128 @@ void folder_context_t::handle_scan_error(fs::task::scan_dir_t &task, stack_conte
     stack.push_front(undo_child_ready_t(task.path));
 }
 
+void folder_context_t::push_removal(const model::file_info_t &file, stack_context_t &ctx) noexcept {
+    auto folder_id = local_folder->get_folder()->get_id();
+    auto keep_blocks = false;
+    auto stat = file.get_local_stat();
+    if (stat && file.is_file() && file.get_size() && file.is_locally_available()) {
+        auto source = model::file_info_ptr_t(const_cast<model::file_info_t *>(&file));
+        if (relinked_files.count(source)) {
+            // the blocks are re-used by the new (not yet applied) location of the file
+            keep_blocks = true;
+        } else {
+            auto key = inode_t{stat->device, stat->inode};
+            auto vanished = vanished_file_t{file.get_modified_s(), file.get_size(), get_blocks(file)};
+            vanished_files.insert_or_assign(key, std::move(vanished));
+        }
+    }
+    auto data = file.as_proto(false);
+    proto::set_deleted(data, true);
+    ctx.push_back(new local_update_t(ctx.cluster, ctx.sequencer, std::move(data), folder_id, keep_blocks));
+}
+
+auto folder_context_t::relink(const child_info_t &info) noexcept -> child_info_t::blocks_t {
+    if (!info.stat) {
+        return {};
+    }
+    auto key = inode_t{info.stat.device, info.stat.inode};
+    auto size = static_cast<std::int64_t>(info.size);
+    if (auto it = vanished_files.find(key); it != vanished_files.end()) {
+        auto vanished = std::move(it->second);
+        vanished_files.erase(it);
+        if (vanished.modified_s == info.last_write_time && vanished.size == size) {
+            return std::move(vanished.blocks);
+        }
+        return {};
+    }
+
+    if (!local_inodes) {
+        local_inodes.emplace();
+        for (auto &file : local_folder->get_file_infos()) {
+            if (auto stat = file->get_local_stat(); stat && file->is_file() && !file->is_deleted()) {
+                local_inodes->emplace(inode_t{stat->device, stat->inode}, file);
+            }
+        }
+    }
+    // the old location might be not scanned yet, i.e. the file is still alive in the model
+    auto it = local_inodes->find(key);
+    if (it == local_inodes->end()) {
+        return {};
+    }
+    auto &file = *it->second;
+    auto stat = file.get_local_stat();
+    auto valid = stat && stat->device == info.stat.device && stat->inode == info.stat.inode && file.is_file() &&
+                 file.is_local() && !file.is_deleted() && file.get_size() == size &&
+                 file.get_modified_s() == info.last_write_time && file.is_locally_available();
+    if (!valid) {
+        return {};
+    }
+    relinked_files.emplace(it->second);
+    return get_blocks(file);
+}
+
+bool folder_context_t::prune(unscanned_dir_t &dir, fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept {
+    auto presence = task.presence.get();
+    if (!presence || !dir.dir_info || !task.single_child.empty() || task.requires_refinement) {
+        return false;
+    }
+    auto features = presence->get_features();
+    if (!(features & F::local) || !(features & F::directory) || (features & F::deleted)) {
+        return false;
+    }
+    // any entry addition, removal or rename updates directory ctime
+    auto &stat = dir.dir_info->stat;
+    auto dir_presence = static_cast<presentation::local_file_presence_t *>(presence);
+    auto recorded = dir_presence->get_file_info().get_local_stat();
+    if (!stat || !recorded || *recorded != stat || is_racy(stat, ctx)) {
+        return false;
+    }
+    auto strict = is_strict(task, ctx);
+    for (auto child : presence->get_children()) {
+        auto features = child->get_features();
+        auto known = (features & F::local) && !(features & F::deleted);
+        if (known && (!strict || (features & F::directory))) {
+            auto name = child->get_entity()->get_path()->get_own_name();
+            task.known_children.emplace_back(widen(name));
+        }
+    }
+    LOG_TRACE(log, "'{}' is unchanged, listing is skipped", narrow(task.path.generic_wstring()));
+    task.pruned = true;
+    return true;
+}
+
+// the ctime granularity is coarse, i.e. the entries might be added within the same
+// tick after the listing, so the ctime of recently changed dirs is not trusted
+bool folder_context_t::is_racy(const model::local_stat_t &stat, stack_context_t &ctx) const noexcept {
+    return stat.ctime_s > ctx.get_now() - ctx.racy_window;
+}
+
+bool folder_context_t::has_recorded_dirs(presentation::presence_t *dir) const noexcept {
+    if (dir) {
+        for (auto child : dir->get_children()) {
+            auto features = child->get_features();
+            if ((features & F::local) && (features & F::directory) && !(features & F::deleted)) {
+                auto dir_presence = static_cast<presentation::local_file_presence_t *>(child);
+                if (dir_presence->get_file_info().get_local_stat()) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void folder_context_t::assign_ignores(fs::task::scan_dir_t &task) const noexcept {
+    task.ignores = ignores;
+    auto &root_path = local_folder->get_folder()->get_path();
+    task.relative_path = narrow(fs::relativize(task.path, root_path).generic_wstring());
+}
+
+// ignored entries are kept as they are, i.e. they are neither removed nor restored
+bool folder_context_t::is_ignored(const presentation::entity_t &entity) const noexcept {
+    return ignores && ignores->is_ignored(entity.get_path()->get_full_name());
+}
+
 bool folder_context_t::is_done() const noexcept {
     return in_progress == 0 && hashing == 0 && stack.empty() && pending_io.empty();
 }
@@ -901,6 +1229,8 @@ void folder_context_t::consume(folder_context_t &previous) noexcept {
 
 auto folder_context_t::get_generation() const noexcept -> generation_t { return io_generation; }
 
+std::string_view folder_context_t::get_folder_id() const noexcept { return local_folder->get_folder()->get_id(); }
+
 void folder_context_t::adjust_generation(generation_t generation) noexcept {
     for (auto &item : stack) {
         std::visit(
@@ -921,6 +1251,7 @@ bool folder_context_t::ensure_folder_existance(stack_context_t &ctx) noexcept {
         LOG_WARN(log, "the folder does not exist in the model");
         stack.clear();
         pending_io.clear();
+        scanned_ahead.clear();
         return false;
     }
     return true;
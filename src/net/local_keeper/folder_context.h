@@ -11,6 +11,8 @@
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
 #include <boost/outcome.hpp>
+#include <map>
+#include <optional>
 #include <unordered_map>
 #include <cstdint>
 
@@ -33,11 +35,28 @@ struct folder_context_t : boost::intrusive_ref_counter<folder_context_t, boost::
     fs::task_t pop_task() noexcept;
     void consume(folder_context_t &) noexcept;
     generation_t get_generation() const noexcept;
+    std::string_view get_folder_id() const noexcept;
     void adjust_generation(generation_t generation) noexcept;
 
   private:
     using scan_generation_t = std::unordered_map<std::string, generation_t>;
     using hasing_files_t = std::unordered_map<std::string, int>;
+    using dir_stats_t = std::unordered_map<std::string, model::local_stat_t>;
+
+    struct scanned_ahead_t {
+        fs::task::scan_dir_t task;
+        generation_t generation; // when the scan results arrived
+    };
+    using scanned_ahead_map_t = std::unordered_map<std::string, scanned_ahead_t>;
+
+    struct vanished_file_t {
+        std::int64_t modified_s;
+        std::int64_t size;
+        child_info_t::blocks_t blocks;
+    };
+    using inode_t = std::pair<std::uint64_t, std::uint64_t>; // device, inode
+    using vanished_files_t = std::map<inode_t, vanished_file_t>;
+    using local_inodes_t = std::map<inode_t, model::file_info_ptr_t>;
 
     int process(complete_scan_t &, stack_context_t &ctx) noexcept;
     int process(unscanned_dir_t &dir, stack_context_t &ctx) noexcept;
@@ -54,11 +73,13 @@ struct folder_context_t : boost::intrusive_ref_counter<folder_context_t, boost::
     int process(incomplete_t &item, stack_context_t &ctx) noexcept;
     int process(rehashed_incomplete_t &item, stack_context_t &ctx) noexcept;
     int process(abort_hashing_t &item, stack_context_t &ctx) noexcept;
+    int process(dir_scanned_t &item, stack_context_t &ctx) noexcept;
 
     void post_process(fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept;
     void post_process(fs::task::segment_iterator_t &task, stack_context_t &ctx);
     void post_process(fs::task::remove_file_t &task, stack_context_t &ctx) noexcept;
     void post_process(fs::task::rename_file_t &task, stack_context_t &ctx) noexcept;
+    void post_process(fs::task::load_journal_t &task, stack_context_t &ctx) noexcept;
     void post_process(fs::task::noop_t &, stack_context_t &) noexcept;
 
     void push(fs::task_t task) noexcept;
@@ -66,6 +87,13 @@ struct folder_context_t : boost::intrusive_ref_counter<folder_context_t, boost::
     bool ensure_folder_existance(stack_context_t &ctx) noexcept;
     int schedule_hash(hash_base_t *item, stack_context_t &ctx) noexcept;
     void handle_scan_error(fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept;
+    void push_removal(const model::file_info_t &file, stack_context_t &ctx) noexcept;
+    child_info_t::blocks_t relink(const child_info_t &info) noexcept;
+    bool prune(unscanned_dir_t &dir, fs::task::scan_dir_t &task, stack_context_t &ctx) noexcept;
+    bool is_racy(const model::local_stat_t &stat, stack_context_t &ctx) const noexcept;
+    bool has_recorded_dirs(presentation::presence_t *dir) const noexcept;
+    void assign_ignores(fs::task::scan_dir_t &task) const noexcept;
+    bool is_ignored(const presentation::entity_t &entity) const noexcept;
 
     model::folder_info_ptr_t local_folder;
     local_keeper::stack_t stack;
@@ -77,6 +105,15 @@ struct folder_context_t : boost::intrusive_ref_counter<folder_context_t, boost::
     child_info_t::generation_t io_generation = 0;
     scan_generation_t scan_generation;
     hasing_files_t hashing_files;
+    scanned_ahead_map_t scanned_ahead;
+    std::optional<scanned_ahead_t> ready_scan;
+    vanished_files_t vanished_files;
+    std::optional<local_inodes_t> local_inodes;
+    model::file_infos_set_t relinked_files;
+    dir_stats_t dir_stats;        // of the dirs being scanned, recorded when they are done
+    std::uint32_t failures = 0;   // to do not record dirs, if something went wrong
+    model::ignores_ptr_t ignores; // as of the last root dir scan
+    bool ignores_changed = false; // all entries have to be re-evaluated, i.e. no pruning
 };
 
 using folder_context_ptr_t = boost::intrusive_ptr<folder_context_t>;
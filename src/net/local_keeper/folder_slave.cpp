@@ -23,6 +23,7 @@ void folder_slave_t::push(folder_contexts_t contexts_) noexcept {
 void folder_slave_t::prepare_task() noexcept {
     assert(folder_contexts.size());
     auto folder_ctx = folder_contexts.front().get();
+    folder_id = folder_ctx->get_folder_id();
     tasks_in.emplace_back(folder_ctx->pop_task());
 }
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #include "hash_base.h"
 #include "fs/utils.h"
@@ -14,7 +14,7 @@ hash_base_t::hash_base_t(child_info_t &&info_, std::int32_t block_size_) : child
     } else {
         block_size = block_size_;
         auto count = size / static_cast<decltype(size)>(block_size_);
-        if (size % count) {
+        if (size % block_size_) {
             ++count;
         }
         unprocessed_blocks = unhashed_blocks = total_blocks = count;
@@ -1,14 +1,17 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #pragma once
 
 #include "hash_base.h"
+#include "fs/utils.h"
 
 namespace syncspirit::net::local_keeper {
 
 struct hash_existing_file_t : hash_base_t {
-    using hash_base_t::hash_base_t;
+    // the previous block size is kept, unless the file size is changed a lot
+    inline hash_existing_file_t(child_info_t info_, std::int32_t prev_block_size)
+        : hash_base_t(std::move(info_), fs::get_block_size(info_.size, prev_block_size).size) {}
 };
 
 } // namespace syncspirit::net::local_keeper
@@ -36,10 +36,17 @@ struct abort_hashing_t {
     bfs::path path;
 };
 
+/* the directory and everything below it has been processed */
+struct dir_scanned_t {
+    presentation::presence_ptr_t presence;
+    model::local_stat_t stat;
+    std::uint32_t failures;
+};
+
 using stack_item_t =
     std::variant<unscanned_dir_t, unexamined_t, incomplete_t, complete_scan_t, child_ready_t, undo_child_ready_t,
                  hash_new_file_ptr_t, hash_existing_file_ptr_t, hash_incomplete_file_ptr_t, rehashed_incomplete_t,
-                 abort_hashing_t, removed_dir_t, confirmed_deleted_t, suspend_scan_t, unsuspend_scan_t>;
+                 abort_hashing_t, removed_dir_t, confirmed_deleted_t, suspend_scan_t, unsuspend_scan_t, dir_scanned_t>;
 using stack_t = std::list<stack_item_t>;
 
 struct dirs_stack_t : stack_t {
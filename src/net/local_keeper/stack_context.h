@@ -33,6 +33,9 @@ struct stack_context_t : model::diff::diff_assember_t {
     std::int32_t hashes_pool;
     const std::int32_t hashes_pool_max;
     syncspirit_watcher_impl_t watcher_impl;
+    bool prune_dirs = false;     // unchanged directories are not listed, only known entries are examined
+    bool strict_pruning = false; // files of unchanged directories are not examined at all
+    std::int64_t racy_window = 0; // seconds, the dirs changed within them are not considered unchanged
 
     folder_slave_t *slave;
     std::int64_t now;
@@ -146,6 +146,8 @@ void net_supervisor_t::launch_early() noexcept {
     create_actor<local_keeper_t>()
         .concurrent_hashes(app_config.hasher_threads)
         .watcher_impl(syncspirit_watcher_impl)
+        .prune_dirs(app_config.fs_config.prune_dirs)
+        .strict_pruning(app_config.fs_config.strict_pruning)
         .sequencer(sequencer)
         .escalate_failure()
         .timeout(timeout)
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "pull_tracer.h"
+#include <boost/nowide/convert.hpp>
+#include <nlohmann/json.hpp>
+#include <bit>
+
+using namespace syncspirit::net;
+using json = nlohmann::json;
+
+static constexpr std::int64_t pid = 1;
+
+pull_tracer_t::pull_tracer_t(const bfs::path &path) noexcept : log{utils::get_logger("net.pull_tracer")} {
+    out.open(path, std::ios_base::out | std::ios_base::trunc);
+    if (!out) {
+        auto path_str = boost::nowide::narrow(path.generic_wstring());
+        LOG_WARN(log, "cannot open '{}' for writing block traces", path_str);
+    } else {
+        out << "[\n";
+    }
+}
+
+pull_tracer_t::~pull_tracer_t() {
+    if (out) {
+        // the trailing comma is allowed by the format, closing bracket is optional
+        out << "{}]\n";
+    }
+}
+
+bool pull_tracer_t::is_open() const noexcept { return static_cast<bool>(out); }
+
+auto pull_tracer_t::get_histograms() const noexcept -> const histograms_t & { return histograms; }
+
+std::string_view pull_tracer_t::get_name(stage_t stage) noexcept {
+    using S = stage_t;
+    switch (stage) {
+    case S::requested:
+        return "requested";
+    case S::received:
+        return "network";
+    case S::hashed:
+        return "hashing";
+    case S::write_queued:
+        return "write-enqueue";
+    case S::write_started:
+        return "write-wait";
+    case S::written:
+        return "write";
+    case S::acked:
+        return "ack";
+    default:
+        return "unknown";
+    }
+}
+
+void pull_tracer_t::write_event(std::string_view event) noexcept {
+    if (out) {
+        out << event << ",\n";
+    }
+}
+
+void pull_tracer_t::add_peer(std::uint64_t peer_id, std::string_view peer_name) noexcept {
+    auto event = json{
+        {"name", "thread_name"},
+        {"ph", "M"},
+        {"pid", pid},
+        {"tid", peer_id},
+        {"args", {{"name", peer_name}}},
+    };
+    write_event(event.dump(-1, ' ', false, json::error_handler_t::replace));
+}
+
+void pull_tracer_t::record(std::uint64_t peer_id, std::string_view file_name, std::uint32_t block_index,
+                           const utils::block_trace_t &trace) noexcept {
+    auto prev = trace.get(stage_t::requested);
+    for (std::size_t i = 1; i < trace.stamps.size(); ++i) {
+        auto stamp = trace.stamps[i];
+        if (!stamp) {
+            continue;
+        }
+        auto stage = static_cast<stage_t>(i);
+        auto duration = prev ? std::max(stamp - prev, std::int64_t{0}) : std::int64_t{0};
+        auto bucket = std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(duration)), buckets_count - 1);
+        ++histograms[i][bucket];
+        if (prev) {
+            auto event = json{
+                {"name", get_name(stage)},
+                {"cat", "block"},
+                {"ph", "X"},
+                {"ts", prev},
+                {"dur", duration},
+                {"pid", pid},
+                {"tid", peer_id},
+                {"args", {{"file", file_name}, {"block", block_index}}},
+            };
+            write_event(event.dump(-1, ' ', false, json::error_handler_t::replace));
+        }
+        prev = stamp;
+    }
+}
+
+void pull_tracer_t::log_summary() const noexcept {
+    for (std::size_t i = 1; i < histograms.size(); ++i) {
+        auto &h = histograms[i];
+        auto total = std::uint64_t{0};
+        for (auto v : h) {
+            total += v;
+        }
+        if (!total) {
+            continue;
+        }
+        auto percentile = [&](std::uint64_t p) -> std::uint64_t {
+            auto threshold = (total * p + 99) / 100;
+            auto acc = std::uint64_t{0};
+            for (std::size_t b = 0; b < h.size(); ++b) {
+                acc += h[b];
+                if (acc >= threshold) {
+                    return b ? (std::uint64_t{1} << b) : 0;
+                }
+            }
+            return std::uint64_t{1} << (h.size() - 1);
+        };
+        LOG_INFO(log, "stage '{}': {} blocks, p50 < {}us, p90 < {}us, p99 < {}us", get_name(static_cast<stage_t>(i)),
+                 total, percentile(50), percentile(90), percentile(99));
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "model/misc/arc.hpp"
+#include "utils/block_trace.h"
+#include "utils/io.h"
+#include "utils/log.h"
+#include "syncspirit-export.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace syncspirit::net {
+
+namespace bfs = std::filesystem;
+
+/* Collects lifecycle traces of pulled blocks and writes them as chrome trace events
+ * (JSON array format, can be opened by chrome://tracing or https://ui.perfetto.dev),
+ * one row per peer. Durations of the stages are aggregated into log2-histograms.
+ *
+ * Not thread-safe: it is shared between controllers, which all live on the net thread.
+ */
+struct SYNCSPIRIT_API pull_tracer_t : model::arc_base_t<pull_tracer_t> {
+    static constexpr std::size_t buckets_count = 32;
+    using stage_t = utils::block_stage_t;
+    using histogram_t = std::array<std::uint64_t, buckets_count>;
+    using histograms_t = std::array<histogram_t, utils::block_trace_t::stages_count>;
+
+    pull_tracer_t(const bfs::path &path) noexcept;
+    ~pull_tracer_t();
+
+    bool is_open() const noexcept;
+    void add_peer(std::uint64_t peer_id, std::string_view peer_name) noexcept;
+    void record(std::uint64_t peer_id, std::string_view file_name, std::uint32_t block_index,
+                const utils::block_trace_t &trace) noexcept;
+    void log_summary() const noexcept;
+
+    const histograms_t &get_histograms() const noexcept;
+    static std::string_view get_name(stage_t stage) noexcept;
+
+  private:
+    void write_event(std::string_view event) noexcept;
+
+    utils::ofstream_t out;
+    utils::logger_t log;
+    histograms_t histograms = {};
+};
+
+using pull_tracer_ptr_t = model::intrusive_ptr_t<pull_tracer_t>;
+
+} // namespace syncspirit::net
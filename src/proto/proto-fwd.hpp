@@ -231,7 +231,11 @@ using Folder = pp::message<
     pp::enum_field      <"folder_type",          10, FolderType >,
     pp::enum_field      <"pull_order",           11, PullOrder  >,
     pp::uint32_field    <"rescan_interval",      12             >,
-    pp::bool_field      <"watched",              13             >
+    pp::bool_field      <"watched",              13             >,
+    pp::int32_field     <"pull_priority",        14             >,
+    pp::uint32_field    <"pull_weight",          15             >,
+    pp::bool_field      <"preallocate",          16             >,
+    pp::bool_field      <"uncached",             17             >
 >;
 
 using FolderInfo = pp::message<
@@ -260,7 +264,11 @@ using FileInfo = pp::message<
     pp::int64_field     <"sequence",        10                                           >,
     pp::int32_field     <"block_size",      13                                           >,
     pp::string_field    <"symlink_target",  16                                           >,
-    pp::bytes_field     <"blocks",          17, pp::repeated, proto::bytes_backend_t     >
+    pp::bytes_field     <"blocks",          17, pp::repeated, proto::bytes_backend_t     >,
+    pp::uint64_field    <"device",          18                                           >,
+    pp::uint64_field    <"inode",           19                                           >,
+    pp::int64_field     <"ctime_s",         20                                           >,
+    pp::int32_field     <"ctime_ns",        21                                           >
 >;
 
 using BlockInfo = pp::message<
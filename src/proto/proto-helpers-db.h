@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #pragma once
 
@@ -295,6 +295,38 @@ inline void set_symlink_target(FileInfo &msg, std::string value) {
     using namespace pp;
     msg["symlink_target"_f] = std::move(value);
 }
+inline std::uint64_t get_device(const FileInfo &msg) {
+    using namespace pp;
+    return msg["device"_f].value_or(0);
+}
+inline void set_device(FileInfo &msg, std::uint64_t value) {
+    using namespace pp;
+    msg["device"_f] = value;
+}
+inline std::uint64_t get_inode(const FileInfo &msg) {
+    using namespace pp;
+    return msg["inode"_f].value_or(0);
+}
+inline void set_inode(FileInfo &msg, std::uint64_t value) {
+    using namespace pp;
+    msg["inode"_f] = value;
+}
+inline std::int64_t get_ctime_s(const FileInfo &msg) {
+    using namespace pp;
+    return msg["ctime_s"_f].value_or(0);
+}
+inline void set_ctime_s(FileInfo &msg, std::int64_t value) {
+    using namespace pp;
+    msg["ctime_s"_f] = value;
+}
+inline std::int32_t get_ctime_ns(const FileInfo &msg) {
+    using namespace pp;
+    return msg["ctime_ns"_f].value_or(0);
+}
+inline void set_ctime_ns(FileInfo &msg, std::int32_t value) {
+    using namespace pp;
+    msg["ctime_ns"_f] = value;
+}
 
 /**************/
 /*** Folder ***/
@@ -409,6 +441,38 @@ inline void set_rescan_interval(Folder &msg, std::uint32_t value) {
     using namespace pp;
     msg["rescan_interval"_f] = value;
 }
+inline std::int32_t get_pull_priority(const Folder &msg) {
+    using namespace pp;
+    return msg["pull_priority"_f].value_or(0);
+}
+inline void set_pull_priority(Folder &msg, std::int32_t value) {
+    using namespace pp;
+    msg["pull_priority"_f] = value;
+}
+inline std::uint32_t get_pull_weight(const Folder &msg) {
+    using namespace pp;
+    return msg["pull_weight"_f].value_or(0);
+}
+inline void set_pull_weight(Folder &msg, std::uint32_t value) {
+    using namespace pp;
+    msg["pull_weight"_f] = value;
+}
+inline bool get_preallocate(const Folder &msg) {
+    using namespace pp;
+    return msg["preallocate"_f].value_or(false);
+}
+inline void set_preallocate(Folder &msg, bool value) {
+    using namespace pp;
+    msg["preallocate"_f] = value;
+}
+inline bool get_uncached(const Folder &msg) {
+    using namespace pp;
+    return msg["uncached"_f].value_or(false);
+}
+inline void set_uncached(Folder &msg, bool value) {
+    using namespace pp;
+    msg["uncached"_f] = value;
+}
 
 /******************/
 /*** FolderInfo ***/
@@ -30,6 +30,7 @@ auto reflect(const main_cfg_t &config, const main_cfg_t &default_config) -> cate
             property_ptr_t(new bep::rx_buff_size_t(bep.rx_buff_size, bep_def.rx_buff_size)),
             property_ptr_t(new bep::tx_buff_limit_t(bep.tx_buff_limit, bep_def.tx_buff_limit)),
             property_ptr_t(new bep::stats_interval_t(bep.stats_interval, bep_def.stats_interval)),
+            property_ptr_t(new bep::trace_file_t(bep.trace_file, bep_def.trace_file)),
             // clang-format on
         };
         return new category_t("bep", "BEP protocol/network settings", std::move(props));
@@ -69,6 +70,14 @@ auto reflect(const main_cfg_t &config, const main_cfg_t &default_config) -> cate
             property_ptr_t(new fs::temporally_timeout_t(f.temporally_timeout, f_def.temporally_timeout)),
             property_ptr_t(new fs::poll_timeout_t(f.poll_timeout, f_def.poll_timeout)),
             property_ptr_t(new fs::retension_timeout_t(f.retension_timeout, f_def.retension_timeout)),
+            property_ptr_t(new fs::io_threads_t(f.io_threads, f_def.io_threads)),
+            property_ptr_t(new fs::scan_threads_t(f.scan_threads, f_def.scan_threads)),
+            property_ptr_t(new fs::prune_dirs_t(f.prune_dirs, f_def.prune_dirs)),
+            property_ptr_t(new fs::strict_pruning_t(f.strict_pruning, f_def.strict_pruning)),
+            property_ptr_t(new fs::ro_cache_size_t(f.ro_cache_size, f_def.ro_cache_size)),
+            property_ptr_t(new fs::write_buffer_t(f.write_buffer, f_def.write_buffer)),
+            property_ptr_t(new fs::durable_t(f.durable, f_def.durable)),
+            property_ptr_t(new fs::stats_interval_t(f.stats_interval, f_def.stats_interval)),
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
             property_ptr_t(new fs::win32_watcher_buff_t(f.win32_watcher_buff, f_def.win32_watcher_buff)),
 #endif
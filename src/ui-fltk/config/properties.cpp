@@ -201,6 +201,13 @@ void stats_interval_t::reflect_to(syncspirit::config::main_t &main) { main.bep_c
 
 const char *stats_interval_t::explanation_ = "min delay before gathering I/O stats, milliseconds";
 
+trace_file_t::trace_file_t(std::string value, std::string default_value)
+    : parent_t("trace_file", explanation_, std::move(value), std::move(default_value)) {}
+
+void trace_file_t::reflect_to(syncspirit::config::main_t &main) { main.bep_config.trace_file = value; }
+
+const char *trace_file_t::explanation_ = "where to write blocks pulling trace (chrome/perfetto json), empty to disable";
+
 } // namespace bep
 
 namespace db {
@@ -275,6 +282,58 @@ void poll_timeout_t::reflect_to(syncspirit::config::main_t &main) { main.fs_conf
 
 const char *poll_timeout_t::explanation_ = "amount of microseconds to do micro-sleeps when there is nothing to do";
 
+io_threads_t::io_threads_t(std::uint64_t value, std::uint64_t default_value)
+    : parent_t("io_threads", explanation_, value, default_value) {}
+
+void io_threads_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.io_threads = native_value; }
+
+const char *io_threads_t::explanation_ = "amount of threads doing block I/O (disks are spread between them), "
+                                         "unused if io_uring is available";
+
+scan_threads_t::scan_threads_t(std::uint64_t value, std::uint64_t default_value)
+    : parent_t("scan_threads", explanation_, value, default_value) {}
+
+void scan_threads_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.scan_threads = native_value; }
+
+const char *scan_threads_t::explanation_ = "amount of threads scanning directories ahead of the folder traversal, "
+                                           "1 means scanning in fs thread only";
+
+prune_dirs_t::prune_dirs_t(bool value, bool default_value) : parent_t(value, default_value, "prune_dirs") {}
+
+void prune_dirs_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.prune_dirs = native_value; }
+
+strict_pruning_t::strict_pruning_t(bool value, bool default_value)
+    : parent_t(value, default_value, "strict_pruning") {}
+
+void strict_pruning_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.strict_pruning = native_value; }
+
+ro_cache_size_t::ro_cache_size_t(std::uint64_t value, std::uint64_t default_value)
+    : parent_t("ro_cache_size", explanation_, value, default_value) {}
+
+void ro_cache_size_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.ro_cache_size = native_value; }
+
+const char *ro_cache_size_t::explanation_ = "maximum amount of files kept open for serving peers block requests";
+
+write_buffer_t::write_buffer_t(std::uint64_t value, std::uint64_t default_value)
+    : parent_t("write_buffer", explanation_, value, default_value) {}
+
+void write_buffer_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.write_buffer = native_value; }
+
+const char *write_buffer_t::explanation_ = "amount of bytes of received blocks of one I/O batch to gather, "
+                                           "before writing them in large contiguous chunks";
+
+durable_t::durable_t(bool value, bool default_value) : parent_t(value, default_value, "durable") {}
+
+void durable_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.durable = native_value; }
+
+stats_interval_t::stats_interval_t(std::int64_t value, std::int64_t default_value)
+    : parent_t("stats_interval", explanation_, value, default_value) {}
+
+void stats_interval_t::reflect_to(syncspirit::config::main_t &main) { main.fs_config.stats_interval = native_value; }
+
+const char *stats_interval_t::explanation_ = "how often per-folder disk I/O stats are reported, milliseconds "
+                                             "(zero disables them)";
+
 temporally_timeout_t::temporally_timeout_t(std::uint64_t value, std::uint64_t default_value)
     : parent_t("temporally_timeout", explanation_, value, default_value) {}
 
@@ -145,6 +145,15 @@ struct stats_interval_t final : impl::integer_t {
     void reflect_to(syncspirit::config::main_t &main) override;
 };
 
+struct trace_file_t final : impl::string_t {
+    using parent_t = impl::string_t;
+
+    static const char *explanation_;
+
+    trace_file_t(std::string value, std::string default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
 } // namespace bep
 
 namespace db {
@@ -227,6 +236,72 @@ struct retension_timeout_t final : impl::positive_integer_t {
     void reflect_to(syncspirit::config::main_t &main) override;
 };
 
+struct io_threads_t final : impl::positive_integer_t {
+    using parent_t = impl::positive_integer_t;
+
+    static const char *explanation_;
+
+    io_threads_t(std::uint64_t value, std::uint64_t default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct scan_threads_t final : impl::positive_integer_t {
+    using parent_t = impl::positive_integer_t;
+
+    static const char *explanation_;
+
+    scan_threads_t(std::uint64_t value, std::uint64_t default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct prune_dirs_t final : impl::bool_t {
+    using parent_t = impl::bool_t;
+
+    prune_dirs_t(bool value, bool default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct strict_pruning_t final : impl::bool_t {
+    using parent_t = impl::bool_t;
+
+    strict_pruning_t(bool value, bool default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct ro_cache_size_t final : impl::positive_integer_t {
+    using parent_t = impl::positive_integer_t;
+
+    static const char *explanation_;
+
+    ro_cache_size_t(std::uint64_t value, std::uint64_t default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct write_buffer_t final : impl::positive_integer_t {
+    using parent_t = impl::positive_integer_t;
+
+    static const char *explanation_;
+
+    write_buffer_t(std::uint64_t value, std::uint64_t default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct durable_t final : impl::bool_t {
+    using parent_t = impl::bool_t;
+
+    durable_t(bool value, bool default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
+struct stats_interval_t final : impl::integer_t {
+    using parent_t = impl::integer_t;
+
+    static const char *explanation_;
+
+    stats_interval_t(std::int64_t value, std::int64_t default_value);
+    void reflect_to(syncspirit::config::main_t &main) override;
+};
+
 struct temporally_timeout_t final : impl::positive_integer_t {
     using parent_t = impl::positive_integer_t;
 
@@ -446,6 +446,88 @@ auto folder_table_t::make_rescan_interval(folder_table_t &container, bool disabl
     return new widget_t(container, disabled);
 }
 
+auto folder_table_t::make_pull_priority(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
+    struct widget_t final : table_widget::int_input_t {
+        using parent_t = table_widget::int_input_t;
+        widget_t(Fl_Widget &container, bool disabled_) : parent_t{container}, disabled{disabled_} {}
+
+        Fl_Widget *create_widget(int x, int y, int w, int h) override {
+            auto r = parent_t::create_widget(x, y, w, h);
+            input->callback([](auto, void *data) { reinterpret_cast<folder_table_t *>(data)->refresh(); }, &container);
+            input->when(input->when() | FL_WHEN_CHANGED);
+            if (disabled) {
+                widget->deactivate();
+            }
+            return r;
+        }
+
+        void reset() override {
+            auto &container = static_cast<folder_table_t &>(this->container);
+            auto value = container.description.get_folder()->get_pull_priority();
+            auto value_str = std::to_string(value);
+            input->value(value_str.data());
+        }
+
+        bool store(void *data) override {
+            auto ctx = reinterpret_cast<ctx_t *>(data);
+            auto value_str = std::string_view(input->value());
+            std::int32_t value = 0;
+            auto result = std::from_chars(value_str.begin(), value_str.end(), value);
+            if (result.ec != std::errc()) {
+                auto &container = static_cast<folder_table_t &>(this->container);
+                container.error = "invalid pull priority";
+                return false;
+            }
+
+            db::set_pull_priority(ctx->folder, value);
+            return true;
+        }
+        bool disabled;
+    };
+    return new widget_t(container, disabled);
+}
+
+auto folder_table_t::make_pull_weight(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
+    struct widget_t final : table_widget::int_input_t {
+        using parent_t = table_widget::int_input_t;
+        widget_t(Fl_Widget &container, bool disabled_) : parent_t{container}, disabled{disabled_} {}
+
+        Fl_Widget *create_widget(int x, int y, int w, int h) override {
+            auto r = parent_t::create_widget(x, y, w, h);
+            input->callback([](auto, void *data) { reinterpret_cast<folder_table_t *>(data)->refresh(); }, &container);
+            input->when(input->when() | FL_WHEN_CHANGED);
+            if (disabled) {
+                widget->deactivate();
+            }
+            return r;
+        }
+
+        void reset() override {
+            auto &container = static_cast<folder_table_t &>(this->container);
+            auto value = container.description.get_folder()->get_pull_weight();
+            auto value_str = std::to_string(value);
+            input->value(value_str.data());
+        }
+
+        bool store(void *data) override {
+            auto ctx = reinterpret_cast<ctx_t *>(data);
+            auto value_str = std::string_view(input->value());
+            int value = 0;
+            auto result = std::from_chars(value_str.begin(), value_str.end(), value);
+            if (result.ec != std::errc() || value <= 0) {
+                auto &container = static_cast<folder_table_t &>(this->container);
+                container.error = "invalid pull weight";
+                return false;
+            }
+
+            db::set_pull_weight(ctx->folder, static_cast<std::uint32_t>(value));
+            return true;
+        }
+        bool disabled;
+    };
+    return new widget_t(container, disabled);
+}
+
 auto folder_table_t::make_ignore_permissions(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
     struct widget_t final : checkbox_widget_t {
         using parent_t = checkbox_widget_t;
@@ -577,6 +659,58 @@ auto folder_table_t::make_watched(folder_table_t &container, bool disabled) -> w
     return new widget_t(container, disabled);
 }
 
+auto folder_table_t::make_preallocate(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
+    struct widget_t final : checkbox_widget_t {
+        using parent_t = checkbox_widget_t;
+        widget_t(Fl_Widget &container, bool disabled_) : parent_t{container}, disabled{disabled_} {}
+
+        Fl_Widget *create_widget(int x, int y, int w, int h) override {
+            auto r = parent_t::create_widget(x, y, w, h);
+            if (disabled) {
+                widget->deactivate();
+            }
+            return r;
+        }
+        void reset() override {
+            auto &container = static_cast<folder_table_t &>(this->container);
+            input->value(container.description.get_folder()->is_preallocated());
+        }
+        bool store(void *data) override {
+            auto ctx = reinterpret_cast<ctx_t *>(data);
+            db::set_preallocate(ctx->folder, input->value());
+            return true;
+        }
+        bool disabled;
+    };
+    return new widget_t(container, disabled);
+}
+
+auto folder_table_t::make_uncached(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
+    struct widget_t final : checkbox_widget_t {
+        using parent_t = checkbox_widget_t;
+        widget_t(Fl_Widget &container, bool disabled_) : parent_t{container}, disabled{disabled_} {}
+
+        Fl_Widget *create_widget(int x, int y, int w, int h) override {
+            auto r = parent_t::create_widget(x, y, w, h);
+            if (disabled) {
+                widget->deactivate();
+            }
+            return r;
+        }
+        void reset() override {
+            auto &container = static_cast<folder_table_t &>(this->container);
+            input->value(container.description.get_folder()->is_uncached());
+        }
+        bool store(void *data) override {
+            auto ctx = reinterpret_cast<ctx_t *>(data);
+            db::set_uncached(ctx->folder, input->value());
+            return true;
+        }
+        bool disabled;
+    };
+    return new widget_t(container, disabled);
+}
+
 auto folder_table_t::make_scheduled(folder_table_t &container, bool disabled) -> widgetable_ptr_t {
     struct widget_t final : checkbox_widget_t {
         using parent_t = checkbox_widget_t;
@@ -29,12 +29,16 @@ struct folder_table_t : static_table_t {
     static widgetable_ptr_t make_pull_order(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_index(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_rescan_interval(folder_table_t &container, bool disabled);
+    static widgetable_ptr_t make_pull_priority(folder_table_t &container, bool disabled);
+    static widgetable_ptr_t make_pull_weight(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_ignore_permissions(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_ignore_delete(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_disable_tmp(folder_table_t &container);
     static widgetable_ptr_t make_scheduled(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_paused(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_watched(folder_table_t &container, bool disabled);
+    static widgetable_ptr_t make_preallocate(folder_table_t &container, bool disabled);
+    static widgetable_ptr_t make_uncached(folder_table_t &container, bool disabled);
     static widgetable_ptr_t make_shared_with(folder_table_t &container, model::device_ptr_t device, bool disabled);
     static widgetable_ptr_t make_notice(folder_table_t &container);
 
@@ -66,6 +70,8 @@ struct folder_table_t : static_table_t {
     static_string_provider_ptr_t max_sequence_cell;
     static_string_provider_ptr_t scan_start_cell;
     static_string_provider_ptr_t scan_finish_cell;
+    static_string_provider_ptr_t io_bytes_cell;
+    static_string_provider_ptr_t io_latency_cell;
     Fl_Widget *apply_button;
     Fl_Widget *share_button;
     Fl_Widget *reset_button;
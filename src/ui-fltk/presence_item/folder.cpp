@@ -24,6 +24,28 @@ namespace {
 
 using folder_table_t = content::folder_table_t;
 
+static auto format_io_bytes(const model::folder_t::io_counters_t &counters) -> std::string {
+    auto get_bytes = [&](std::string_view operation) -> std::int64_t {
+        auto it = counters.find(operation);
+        return it != counters.end() ? static_cast<std::int64_t>(it->second.bytes) : 0;
+    };
+    return fmt::format("{} / {}", get_file_size(get_bytes("read")), get_file_size(get_bytes("write")));
+}
+
+static auto format_io_latency(const model::folder_t::io_counters_t &counters) -> std::string {
+    auto r = std::string();
+    for (auto operation : {"read", "write", "sync"}) {
+        auto it = counters.find(std::string_view(operation));
+        if (it == counters.end() || !it->second.count) {
+            continue;
+        }
+        auto &c = it->second;
+        auto avg = c.total_us / c.count;
+        r += fmt::format("{}{}: {}/{}us", r.empty() ? "" : ", ", operation, avg, c.p99_us);
+    }
+    return r.empty() ? "-" : r;
+}
+
 static auto make_actions(folder_table_t &container) -> widgetable_ptr_t {
     struct widget_t final : widgetable_t {
         using parent_t = widgetable_t;
@@ -88,6 +110,8 @@ struct table_t : content::folder_table_t {
         max_sequence_cell = new static_string_provider_t();
         scan_start_cell = new static_string_provider_t();
         scan_finish_cell = new static_string_provider_t();
+        io_bytes_cell = new static_string_provider_t();
+        io_latency_cell = new static_string_provider_t();
 
         auto data = table_rows_t();
         data.push_back({"", make_title(*this, "edit existing folder")});
@@ -97,6 +121,8 @@ struct table_t : content::folder_table_t {
         if (is_local) {
             data.push_back({"type", make_folder_type(*this, false)});
             data.push_back({"pull order", make_pull_order(*this, false)});
+            data.push_back({"pull priority", make_pull_priority(*this, false)});
+            data.push_back({"pull weight", make_pull_weight(*this, false)});
         }
         data.push_back({"cluster/local entries", entries_cell});
         data.push_back({"entries size", entries_size_cell});
@@ -105,6 +131,8 @@ struct table_t : content::folder_table_t {
         if (is_local) {
             data.push_back({"scan start", scan_start_cell});
             data.push_back({"scan finish", scan_finish_cell});
+            data.push_back({"disk read/written", io_bytes_cell});
+            data.push_back({"disk latency (avg/p99)", io_latency_cell});
             data.push_back({"rescan interval", make_rescan_interval(*this, false)});
             data.push_back({"ignore permissions", make_ignore_permissions(*this, false)});
             data.push_back({"ignore delete", make_ignore_delete(*this, false)});
@@ -112,6 +140,8 @@ struct table_t : content::folder_table_t {
             data.push_back({"scheduled", make_scheduled(*this, false)});
             data.push_back({"paused", make_paused(*this, false)});
             data.push_back({"watched", make_watched(*this, false)});
+            data.push_back({"preallocate", make_preallocate(*this, false)});
+            data.push_back({"uncached", make_uncached(*this, false)});
         }
 
         if (is_local) {
@@ -179,6 +209,10 @@ struct table_t : content::folder_table_t {
             auto scan_finish = date_finish.is_not_a_date_time() ? "-" : model::pt::to_simple_string(date_finish);
             scan_start_cell->update(scan_start);
             scan_finish_cell->update(scan_finish);
+
+            auto &io_counters = folder->get_io_counters();
+            io_bytes_cell->update(format_io_bytes(io_counters));
+            io_latency_cell->update(format_io_latency(io_counters));
         }
 
         auto max_sequence = description.get_max_sequence();
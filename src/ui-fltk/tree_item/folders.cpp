@@ -78,6 +78,8 @@ struct table_t : content::folder_table_t {
         data.push_back({"label", make_label(*this, false)});
         data.push_back({"type", make_folder_type(*this, false)});
         data.push_back({"pull order", make_pull_order(*this, false)});
+        data.push_back({"pull priority", make_pull_priority(*this, false)});
+        data.push_back({"pull weight", make_pull_weight(*this, false)});
         data.push_back({"index", make_index(*this, false)});
         data.push_back({"rescan interval", make_rescan_interval(*this, false)});
         data.push_back({"ignore permissions", make_ignore_permissions(*this, false)});
@@ -86,6 +88,8 @@ struct table_t : content::folder_table_t {
         data.push_back({"scheduled", make_scheduled(*this, false)});
         data.push_back({"paused", make_paused(*this, false)});
         data.push_back({"watched", make_watched(*this, false)});
+        data.push_back({"preallocate", make_preallocate(*this, false)});
+        data.push_back({"uncached", make_uncached(*this, false)});
         data.push_back({"shared_with", make_shared_with(*this, {}, false)});
         data.push_back({"", notice = make_notice(*this)});
         data.push_back({"actions", make_actions(*this)});
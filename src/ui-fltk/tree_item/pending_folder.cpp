@@ -80,6 +80,8 @@ struct table_t : content::folder_table_t {
         data.push_back({"label", make_label(*this, existing)});
         data.push_back({"type", make_folder_type(*this, existing)});
         data.push_back({"pull order", make_pull_order(*this, existing)});
+        data.push_back({"pull priority", make_pull_priority(*this, existing)});
+        data.push_back({"pull weight", make_pull_weight(*this, existing)});
         data.push_back({"index", make_index(*this, true)});
         data.push_back({"rescan interval", make_rescan_interval(*this, existing)});
         data.push_back({"ignore permissions", make_ignore_permissions(*this, existing)});
@@ -88,6 +90,8 @@ struct table_t : content::folder_table_t {
         data.push_back({"scheduled", make_scheduled(*this, existing)});
         data.push_back({"paused", make_paused(*this, existing)});
         data.push_back({"watched", make_watched(*this, existing)});
+        data.push_back({"preallocate", make_preallocate(*this, existing)});
+        data.push_back({"uncached", make_uncached(*this, existing)});
         data.push_back({"shared_with", make_shared_with(*this, fi->get_device(), true)});
         data.push_back({"", notice = make_notice(*this)});
         data.push_back({"actions", make_actions(*this)});
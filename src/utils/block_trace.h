@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace syncspirit::utils {
+
+/* lifecycle of a pulled block, in order of occurrence */
+enum class block_stage_t : std::uint8_t {
+    requested = 0,
+    received,
+    hashed,
+    write_queued,
+    write_started,
+    written,
+    acked,
+    count,
+};
+
+/* per-block stage timestamps (microseconds of the steady clock), zero means the stage
+   has not been reached; the stamps are taken from different threads, but never concurrently */
+struct block_trace_t {
+    static constexpr auto stages_count = static_cast<std::size_t>(block_stage_t::count);
+    using stamps_t = std::array<std::int64_t, stages_count>;
+
+    inline static std::int64_t now() noexcept {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    inline void mark(block_stage_t stage) noexcept { stamps[static_cast<std::size_t>(stage)] = now(); }
+    inline std::int64_t get(block_stage_t stage) const noexcept { return stamps[static_cast<std::size_t>(stage)]; }
+
+    stamps_t stamps = {};
+};
+
+} // namespace syncspirit::utils
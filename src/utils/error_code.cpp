@@ -129,6 +129,9 @@ std::string error_code_category::message(int c) const {
     case error_code_t::concurrent_file_modification:
         r = "concurrent file modification";
         break;
+    case error_code_t::invalid_journal:
+        r = "invalid journal of temporal file";
+        break;
     default:
         r = "unknown";
     }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2022 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #pragma once
 
@@ -78,6 +78,7 @@ enum class error_code_t {
     peer_has_been_removed,
     flush_non_opened,
     concurrent_file_modification,
+    invalid_journal,
 };
 
 enum class bep_error_code_t {
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "mapped_region.h"
+#include <cassert>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+#define SS_NO_MMAP 1
+#else
+#include <csetjmp>
+#include <csignal>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace syncspirit::utils;
+
+#ifndef SS_NO_MMAP
+namespace {
+
+// the handler is process-wide, while the guard is per thread
+thread_local sigjmp_buf *guard = nullptr;
+struct sigaction prev_action;
+std::once_flag handler_flag;
+
+void on_sigbus(int signal, siginfo_t *info, void *context) {
+    if (guard) {
+        siglongjmp(*guard, 1);
+    }
+    // not ours, let the previous handler deal with it
+    if (prev_action.sa_flags & SA_SIGINFO) {
+        prev_action.sa_sigaction(signal, info, context);
+    } else if (prev_action.sa_handler != SIG_IGN && prev_action.sa_handler != SIG_DFL) {
+        prev_action.sa_handler(signal);
+    } else {
+        ::sigaction(SIGBUS, &prev_action, nullptr);
+        ::raise(SIGBUS);
+    }
+}
+
+void install_handler() noexcept {
+    struct sigaction action = {};
+    action.sa_sigaction = &on_sigbus;
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGBUS, &action, &prev_action);
+}
+
+} // namespace
+#endif
+
+mapped_region_t::mapped_region_t(void *address_, std::uint64_t length_, std::uint64_t offset_) noexcept
+    : address{address_}, length{length_}, offset{offset_} {}
+
+mapped_region_t::~mapped_region_t() {
+#ifndef SS_NO_MMAP
+    ::munmap(address, static_cast<std::size_t>(length));
+#endif
+}
+
+auto mapped_region_t::map(const std::filesystem::path &path, std::uint64_t offset, std::uint64_t size) noexcept
+    -> mapped_region_ptr_t {
+#ifdef SS_NO_MMAP
+    (void)path;
+    (void)offset;
+    (void)size;
+    return {};
+#else
+    if (!size) {
+        return {};
+    }
+    std::call_once(handler_flag, install_handler);
+
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return {};
+    }
+    struct stat stat_info;
+    auto ok = ::fstat(fd, &stat_info) == 0 && static_cast<std::uint64_t>(stat_info.st_size) >= offset + size;
+
+    auto r = mapped_region_ptr_t();
+    if (ok) {
+        static const auto page_size = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+        auto aligned_offset = offset - offset % page_size;
+        auto length = size + (offset - aligned_offset);
+        auto address = ::mmap(nullptr, static_cast<std::size_t>(length), PROT_READ, MAP_SHARED, fd,
+                              static_cast<off_t>(aligned_offset));
+        if (address != MAP_FAILED) {
+            ::madvise(address, static_cast<std::size_t>(length), MADV_SEQUENTIAL);
+            ::madvise(address, static_cast<std::size_t>(length), MADV_WILLNEED);
+            r.reset(new mapped_region_t(address, length, aligned_offset));
+        }
+    }
+    // the mapping keeps the file referenced
+    ::close(fd);
+    return r;
+#endif
+}
+
+bytes_view_t mapped_region_t::view(std::uint64_t offset_, std::uint64_t size) const noexcept {
+    assert(offset_ >= offset && offset_ + size <= offset + length);
+    auto ptr = reinterpret_cast<const unsigned char *>(address) + (offset_ - offset);
+    return bytes_view_t(ptr, static_cast<std::size_t>(size));
+}
+
+bool mapped_region_t::access(const callback_t &callback) noexcept {
+#ifdef SS_NO_MMAP
+    callback();
+    return true;
+#else
+    sigjmp_buf buff;
+    auto prev_guard = guard;
+    if (sigsetjmp(buff, 1)) {
+        guard = prev_guard;
+        return false;
+    }
+    guard = &buff;
+    callback();
+    guard = prev_guard;
+    return true;
+#endif
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#pragma once
+
+#include "bytes.h"
+#include "syncspirit-export.h"
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+namespace syncspirit::utils {
+
+struct mapped_region_t;
+using mapped_region_ptr_t = boost::intrusive_ptr<mapped_region_t>;
+
+/* read-only memory mapping of a file region, i.e. the file pages are accessed
+   directly without copying them into user buffers. It is shared between threads,
+   the region is unmapped when the last reference goes away.
+
+   If the file is truncated in the meanwhile, an access to the pages beyond the
+   new end raises SIGBUS, so the pages should be accessed only via access() */
+struct SYNCSPIRIT_API mapped_region_t : boost::intrusive_ref_counter<mapped_region_t, boost::thread_safe_counter> {
+    using callback_t = std::function<void()>;
+
+    mapped_region_t(const mapped_region_t &) = delete;
+    ~mapped_region_t();
+
+    /* returns null when the file cannot be mapped (including the platforms without
+       mmap support), and the caller should fallback to the ordinary reads */
+    static mapped_region_ptr_t map(const std::filesystem::path &path, std::uint64_t offset,
+                                   std::uint64_t size) noexcept;
+
+    /* file offsets, which should be within the mapped region */
+    bytes_view_t view(std::uint64_t offset, std::uint64_t size) const noexcept;
+
+    /* invokes the callback, which reads the mapped pages; returns false if the pages
+       are gone (i.e. the file has been truncated). In the latter case the callback is
+       abandoned midway, so it must not allocate, lock or own anything */
+    static bool access(const callback_t &callback) noexcept;
+
+  private:
+    mapped_region_t(void *address, std::uint64_t length, std::uint64_t offset) noexcept;
+
+    void *address;
+    std::uint64_t length;
+    std::uint64_t offset; // file offset of the address
+};
+
+} // namespace syncspirit::utils
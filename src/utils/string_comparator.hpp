@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstring>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 
@@ -349,4 +349,16 @@ outcome::result<std::string> get_common_name(X509 *cert) noexcept {
 
 void digest(const unsigned char *src, size_t length, unsigned char *storage) noexcept { SHA256(src, length, storage); }
 
+sha256_t::sha256_t() noexcept : ctx{EVP_MD_CTX_new()} {}
+
+sha256_t::~sha256_t() { EVP_MD_CTX_free(ctx); }
+
+bool sha256_t::init() noexcept { return ctx && EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) == 1; }
+
+bool sha256_t::update(const unsigned char *src, size_t length) noexcept {
+    return EVP_DigestUpdate(ctx, src, length) == 1;
+}
+
+bool sha256_t::final(unsigned char *storage) noexcept { return EVP_DigestFinal_ex(ctx, storage, nullptr) == 1; }
+
 } // namespace syncspirit::utils
@@ -64,5 +64,21 @@ SYNCSPIRIT_API outcome::result<std::string> get_common_name(X509 *cert) noexcept
 
 SYNCSPIRIT_API void digest(const unsigned char *src, size_t length, unsigned char *storage) noexcept;
 
+/* incremental sha256 with the caller-owned context: update() neither allocates
+   nor locks, so it might be abandoned midway (i.e. by siglongjmp) without leaks;
+   the context is reused after the next init() */
+struct SYNCSPIRIT_API sha256_t {
+    sha256_t() noexcept;
+    sha256_t(const sha256_t &) = delete;
+    ~sha256_t();
+
+    bool init() noexcept;
+    bool update(const unsigned char *src, size_t length) noexcept;
+    bool final(unsigned char *storage) noexcept;
+
+  private:
+    EVP_MD_CTX *ctx;
+};
+
 } // namespace utils
 } // namespace syncspirit
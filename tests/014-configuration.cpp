@@ -14,7 +14,7 @@ bool operator==(const bep_config_t &lhs, const bep_config_t &rhs) noexcept {
     return lhs.rx_buff_size == rhs.rx_buff_size && lhs.tx_buff_limit == rhs.tx_buff_limit &&
            lhs.connect_timeout == rhs.connect_timeout && lhs.ping_timeout == rhs.ping_timeout &&
            lhs.blocks_max_requested == rhs.blocks_max_requested &&
-           lhs.blocks_simultaneous_write == rhs.blocks_simultaneous_write;
+           lhs.blocks_simultaneous_write == rhs.blocks_simultaneous_write && lhs.trace_file == rhs.trace_file;
 }
 
 bool operator==(const dialer_config_t &lhs, const dialer_config_t &rhs) noexcept {
@@ -24,7 +24,10 @@ bool operator==(const dialer_config_t &lhs, const dialer_config_t &rhs) noexcept
 
 bool operator==(const fs_config_t &lhs, const fs_config_t &rhs) noexcept {
     return lhs.temporally_timeout == rhs.temporally_timeout && lhs.poll_timeout == rhs.poll_timeout &&
-           lhs.retension_timeout == rhs.retension_timeout
+           lhs.retension_timeout == rhs.retension_timeout && lhs.io_threads == rhs.io_threads &&
+           lhs.scan_threads == rhs.scan_threads && lhs.prune_dirs == rhs.prune_dirs &&
+           lhs.strict_pruning == rhs.strict_pruning && lhs.ro_cache_size == rhs.ro_cache_size &&
+           lhs.write_buffer == rhs.write_buffer && lhs.durable == rhs.durable && lhs.stats_interval == rhs.stats_interval
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
            && lhs.win32_watcher_buff == rhs.win32_watcher_buff
 #endif
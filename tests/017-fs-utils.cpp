@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2023 Ivan Baidakou
+// SPDX-FileCopyrightText: 2023-2026 Ivan Baidakou
 
 #include "test-utils.h"
 #include "fs/utils.h"
@@ -36,8 +36,35 @@ TEST_CASE("get_block_size", "[fs]") {
         }
     }
 
+    SECTION("1000..2000 blocks") {
+        for (auto sz : {257 * mb, 300 * mb, 1 * gb, 3 * gb + 1, 10 * gb, 31 * gb}) {
+            auto d = get_block_size(sz, 0);
+            CHECK(d.count > 1000);
+            CHECK(d.count <= 2000);
+        }
+        CHECK(get_block_size(64 * gb, 0) == D{4096, 16 * mb});
+    }
+
     SECTION("with prev_size") {
         CHECK(get_block_size(1, 256 * kb) == D{1, 1});
-        CHECK(get_block_size(1 * gb, 256 * kb) == D{4096, 256 * kb});
+        CHECK(get_block_size(1 * gb, 512 * kb) == D{2048, 512 * kb});
+        CHECK(get_block_size(1 * gb, 2 * mb) == D{512, 2 * mb});
+        CHECK(get_block_size(1 * gb, 5) == D{1024, 1 * mb});
+
+        SECTION("too distinct prev_size is not retained") {
+            CHECK(get_block_size(1 * gb, 256 * kb) == D{1024, 1 * mb});
+            CHECK(get_block_size(1 * gb, 4 * mb) == D{1024, 1 * mb});
+        }
+
+        SECTION("growing file does not flip block size") {
+            auto d = get_block_size(250 * mb, 0);
+            CHECK(d == D{2000, 128 * kb});
+            d = get_block_size(260 * mb, d.size);
+            CHECK(d == D{2080, 128 * kb});
+            d = get_block_size(250 * mb, d.size);
+            CHECK(d == D{2000, 128 * kb});
+            d = get_block_size(600 * mb, d.size);
+            CHECK(d == D{1200, 512 * kb});
+        }
     };
 }
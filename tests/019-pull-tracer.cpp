@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "test-utils.h"
+#include "net/pull_tracer.h"
+#include <nlohmann/json.hpp>
+#include <bit>
+
+using namespace syncspirit;
+using namespace syncspirit::net;
+using namespace syncspirit::test;
+
+using S = utils::block_stage_t;
+using json = nlohmann::json;
+
+TEST_CASE("pull tracer", "[net]") {
+    test::init_logging();
+    auto root_path = unique_path();
+    bfs::create_directories(root_path);
+    auto path_guard = test::path_guard_t(root_path);
+    auto path = root_path / "trace.json";
+
+    auto trace = utils::block_trace_t{};
+    auto set = [&](S stage, std::int64_t value) { trace.stamps[static_cast<std::size_t>(stage)] = value; };
+    set(S::requested, 1000);
+    set(S::received, 1500);
+    set(S::hashed, 1600);
+    set(S::write_queued, 1600);
+    set(S::write_started, 1700);
+    set(S::written, 2700);
+    set(S::acked, 2750);
+
+    {
+        auto tracer = pull_tracer_ptr_t(new pull_tracer_t(path));
+        REQUIRE(tracer->is_open());
+        tracer->add_peer(5, "KHQNO2S");
+        tracer->record(5, "a.txt", 3, trace);
+
+        auto &histograms = tracer->get_histograms();
+        auto &network = histograms[static_cast<std::size_t>(S::received)];
+        CHECK(network[std::bit_width(500u)] == 1);
+        auto &write = histograms[static_cast<std::size_t>(S::written)];
+        CHECK(write[std::bit_width(1000u)] == 1);
+        auto &enqueue = histograms[static_cast<std::size_t>(S::write_queued)];
+        CHECK(enqueue[0] == 1);
+    }
+
+    auto data = json::parse(read_file(path), nullptr, false);
+    REQUIRE(data.is_array());
+    // thread name + 6 stages + trailing terminator
+    REQUIRE(data.size() == 8);
+    CHECK(data[0]["ph"] == "M");
+    CHECK(data[0]["args"]["name"] == "KHQNO2S");
+    auto &network = data[1];
+    CHECK(network["ph"] == "X");
+    CHECK(network["name"] == "network");
+    CHECK(network["ts"] == 1000);
+    CHECK(network["dur"] == 500);
+    CHECK(network["tid"] == 5);
+    CHECK(network["args"]["file"] == "a.txt");
+    CHECK(network["args"]["block"] == 3);
+    CHECK(data[5]["name"] == "write");
+    CHECK(data[5]["dur"] == 1000);
+}
@@ -7,6 +7,7 @@
 #include "model/file_info.h"
 #include "model/misc/sequencer.h"
 #include "diff-builder.h"
+#include "utils/tls.h"
 
 #include <boost/nowide/convert.hpp>
 
@@ -367,3 +368,18 @@ TEST_CASE("file_info_t::make_conflicting_name for wstrings", "[model]") {
     auto cn = local_file->make_conflicting_name();
     REQUIRE_THAT(cn, Matches(boost::nowide::narrow(L"папка/файл.sync-conflict-(\\d){8}-(\\d){6}-KHQNO2S.1ц")));
 }
+
+TEST_CASE("block_info_t::is_zero", "[model]") {
+    auto make_block = [](std::size_t size, unsigned char filler) {
+        auto data = utils::bytes_t(size, filler);
+        auto b = proto::BlockInfo();
+        proto::set_hash(b, utils::sha256_digest(data).value());
+        proto::set_size(b, static_cast<std::int32_t>(size));
+        return block_info_t::create(b).value();
+    };
+
+    CHECK(make_block(128 * 1024, 0)->is_zero());
+    CHECK(make_block(1024 * 1024, 0)->is_zero());
+    CHECK(!make_block(128 * 1024, 1)->is_zero());
+    CHECK(!make_block(5, 0)->is_zero());
+}
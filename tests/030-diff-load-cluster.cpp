@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "test-utils.h"
 #include "model/cluster.h"
@@ -327,6 +327,8 @@ TEST_CASE("loading cluster (file info + block)", "[model]") {
     for (size_t i = 0; i < 11; ++i) {
         fi->assign_block(block.get(), i);
     }
+    auto stat = local_stat_t{5, 7, 1700000000, 123};
+    fi->set_local_stat(stat);
 
     auto target = file_info_ptr_t();
 
@@ -371,4 +373,6 @@ TEST_CASE("loading cluster (file info + block)", "[model]") {
 
     CHECK(target->get_uuid() == fi->get_uuid());
     CHECK(target->get_name() == fi->get_name());
+    REQUIRE(target->get_local_stat());
+    CHECK(*target->get_local_stat() == stat);
 }
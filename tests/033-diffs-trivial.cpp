@@ -6,6 +6,7 @@
 #include "diff-builder.h"
 #include "model/cluster.h"
 #include "model/diff/local/file_availability.h"
+#include "model/diff/local/io_stats.h"
 #include "model/diff/contact/update_contact.h"
 
 using namespace syncspirit;
@@ -105,3 +106,36 @@ TEST_CASE("update_contact_t", "[model]") {
         CHECK(*uris[1] == *url_2);
     };
 }
+
+TEST_CASE("io stats", "[model]") {
+    auto my_id = device_id_t::from_string("KHQNO2S-5QSILRK-YX4JZZ4-7L77APM-QNVGZJT-EKU7IFI-PNEPBMY-4MXFMQD").value();
+    auto my_device = device_t::create(my_id, "my-device").value();
+    auto cluster = cluster_ptr_t(new cluster_t(my_device, 1));
+    auto controller = make_apply_controller(cluster);
+    cluster->get_devices().put(my_device);
+
+    auto builder = diff_builder_t(*cluster);
+    REQUIRE(builder.upsert_folder("1234-5678", "some/path", "my-label").apply());
+    auto folder = cluster->get_folders().by_id("1234-5678");
+    CHECK(folder->get_io_counters().empty());
+
+    auto make_diff = [](std::uint64_t p99_us) {
+        auto counters = folder_t::io_counters_t();
+        counters["read"] = folder_t::io_counter_t{2, 10, 30, p99_us, 20};
+        auto folders = diff::local::folders_io_t();
+        folders.emplace_back(diff::local::folder_io_t{"1234-5678", std::move(counters)});
+        folders.emplace_back(diff::local::folder_io_t{"non-existing", {}});
+        return diff::cluster_diff_ptr_t(new diff::local::io_stats_t(std::move(folders)));
+    };
+    REQUIRE(make_diff(16)->apply(*controller, {}));
+    REQUIRE(make_diff(8)->apply(*controller, {}));
+
+    auto &counters = folder->get_io_counters();
+    REQUIRE(counters.size() == 1);
+    auto &read = counters.at("read");
+    CHECK(read.count == 4);
+    CHECK(read.bytes == 20);
+    CHECK(read.total_us == 60);
+    CHECK(read.p99_us == 8);
+    CHECK(read.max_us == 20);
+}
@@ -7,7 +7,9 @@
 #include "model/misc/file_iterator.h"
 #include "model/misc/sequencer.h"
 #include "diff-builder.h"
+#include <algorithm>
 #include <set>
+#include <fmt/format.h>
 
 using namespace syncspirit;
 using namespace syncspirit::test;
@@ -749,6 +751,39 @@ TEST_CASE("file pull order", "[model]") {
         auto expected = names_t{"0.txt", "1/a.txt", "1/e.txt", "1/d.txt", "1/c.txt"};
         CHECK(names == expected);
     }
+    SECTION("updated file is re-ordered") {
+        auto &pull_order = ((model::folder_data_t *)folder.get())->access<test::to::pull_order>();
+        pull_order = db::PullOrder::smallest;
+        auto file_iterator = peer_device->create_iterator(*cluster);
+
+        auto pr = proto::FileInfo();
+        proto::set_name(pr, "1/e.txt");
+        proto::set_size(pr, 1);
+        proto::set_modified_s(pr, 7000);
+        proto::set_sequence(pr, sequence++);
+        auto &v = proto::get_version(pr);
+        proto::add_counters(v, proto::Counter(peer_device->device_id().get_uint(), 2));
+        auto bytes_view = utils::bytes_view_t((unsigned char *)&file_metas, 1);
+        auto block = proto::BlockInfo();
+        proto::set_hash(block, utils::sha256_digest(bytes_view).value());
+        proto::set_size(block, 1);
+        proto::add_blocks(pr, std::move(block));
+        auto peer_fi = folder_infos->by_device(*peer_device);
+        auto prev_file = peer_fi->get_file_infos().by_name("1/e.txt");
+        REQUIRE(builder.make_index(peer_sha, "1234-5678").add(pr, peer_device, false).finish().apply());
+        CHECK(peer_fi->get_file_infos().by_name("1/e.txt") == prev_file);
+
+        auto names = names_t();
+        while (true) {
+            auto [f, fi, lf, action] = file_iterator->next();
+            if (!f) {
+                break;
+            };
+            names.emplace_back(std::string(f->get_name()->get_full_name()));
+        }
+        auto expected = names_t{"0.txt", "1/e.txt", "1/a.txt", "1/d.txt", "1/c.txt"};
+        CHECK(names == expected);
+    }
 }
 
 TEST_CASE("no file iteration for send-only folder", "[model]") {
@@ -809,6 +844,93 @@ TEST_CASE("no file iteration for send-only folder", "[model]") {
     }
 }
 
+TEST_CASE("file iterator, folder priorities & weights", "[model]") {
+    auto my_id = device_id_t::from_string("KHQNO2S-5QSILRK-YX4JZZ4-7L77APM-QNVGZJT-EKU7IFI-PNEPBMY-4MXFMQD").value();
+    auto my_device = device_t::create(my_id, "my-device").value();
+    auto peer_id = device_id_t::from_string("VUV42CZ-IQD5A37-RPEBPM4-VVQK6E4-6WSKC7B-PVJQHHD-4PZD44V-ENC6WAZ").value();
+
+    auto peer_device = device_t::create(peer_id, "peer-device").value();
+    auto cluster = cluster_ptr_t(new cluster_t(my_device, 1));
+    auto sequencer = make_sequencer(4);
+    cluster->get_devices().put(my_device);
+    cluster->get_devices().put(peer_device);
+
+    auto builder = diff_builder_t(*cluster);
+    auto &folders = cluster->get_folders();
+    auto peer_sha = peer_id.get_sha256();
+    auto local_sha = my_id.get_sha256();
+
+    auto make_folder = [&](std::string_view id) -> db::Folder {
+        db::Folder db_folder;
+        db::set_id(db_folder, id);
+        db::set_label(db_folder, id);
+        db::set_path(db_folder, std::string_view("/"));
+        db::set_folder_type(db_folder, db::FolderType::send_and_receive);
+        return db_folder;
+    };
+    auto db_folder_1 = make_folder("1234");
+    auto db_folder_2 = make_folder("5678");
+
+    auto setup = [&]() {
+        REQUIRE(builder.upsert_folder(db_folder_1).upsert_folder(db_folder_2).apply());
+        REQUIRE(builder.share_folder(peer_sha, "1234").share_folder(peer_sha, "5678").apply());
+        auto local_fi_1 = folders.by_id("1234")->get_folder_infos().by_device(*my_device);
+        auto local_fi_2 = folders.by_id("5678")->get_folder_infos().by_device(*my_device);
+        REQUIRE(builder.configure_cluster(peer_sha)
+                    .add(peer_sha, "1234", 123, 4)
+                    .add(local_sha, "1234", local_fi_1->get_index(), -1)
+                    .add(peer_sha, "5678", 1234, 4)
+                    .add(local_sha, "5678", local_fi_2->get_index(), -1)
+                    .finish()
+                    .apply());
+        for (auto folder_id : {std::string_view("1234"), std::string_view("5678")}) {
+            auto index = builder.make_index(peer_sha, folder_id);
+            for (std::int64_t i = 1; i <= 4; ++i) {
+                auto pr_fi = proto::FileInfo();
+                proto::set_name(pr_fi, fmt::format("{}-{}.txt", folder_id, i));
+                proto::set_sequence(pr_fi, i);
+                index.add(pr_fi, peer_device);
+            }
+            REQUIRE(index.finish().apply());
+        }
+    };
+
+    auto iterate = [&](std::size_t count) -> std::vector<std::string_view> {
+        auto file_iterator = peer_device->create_iterator(*cluster);
+        auto folder_ids = std::vector<std::string_view>();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto [f, fi, lf, action] = file_iterator->next();
+            REQUIRE(f);
+            CHECK(action == A::remote_copy);
+            folder_ids.emplace_back(fi->get_folder()->get_id());
+        }
+        return folder_ids;
+    };
+
+    SECTION("higher priority folder goes first") {
+        db::set_pull_priority(db_folder_2, 1);
+        setup();
+        auto ids = iterate(8);
+        auto expected = std::vector<std::string_view>{"5678", "5678", "5678", "5678", "1234", "1234", "1234", "1234"};
+        CHECK(ids == expected);
+    }
+    SECTION("same priority, folders are weighted") {
+        db::set_pull_weight(db_folder_1, 1);
+        db::set_pull_weight(db_folder_2, 3);
+        setup();
+        auto ids = iterate(4);
+        CHECK(std::count(ids.begin(), ids.end(), "1234") == 1);
+        CHECK(std::count(ids.begin(), ids.end(), "5678") == 3);
+    }
+    SECTION("same priority & weights, folders are interleaved") {
+        setup();
+        auto ids = iterate(4);
+        CHECK(std::count(ids.begin(), ids.end(), "1234") == 2);
+        CHECK(std::count(ids.begin(), ids.end(), "5678") == 2);
+        CHECK(ids[0] != ids[1]);
+    }
+}
+
 int _init() {
     test::init_logging();
     return 1;
@@ -7,6 +7,7 @@
 #include "fs/fs_proxy.h"
 #include "fs/utils.h"
 #include <boost/nowide/convert.hpp>
+#include <array>
 
 using namespace syncspirit;
 using namespace syncspirit::test;
@@ -71,6 +72,13 @@ TEST_CASE("block iterator", "[model]") {
             REQUIRE(bfs::exists(path));
             CHECK(bfs::file_size(path) == 10);
         }
+        SECTION("preallocated file") {
+            auto f = proxy.open_write(path, 100000, true);
+            REQUIRE(f);
+            CHECK(proxy.mediator_updates == 2);
+            REQUIRE(bfs::exists(path));
+            CHECK(bfs::file_size(path) == 100000);
+        }
     }
 
     SECTION("remove_file") {
@@ -187,8 +195,53 @@ TEST_CASE("block iterator", "[model]") {
         auto &f = opt.assume_value();
         mediator.clean_expired();
         CHECK(mediator.is_masked(path_str) == 0);
-        proxy.write(path, f, as_bytes("12345"));
-        CHECK(mediator.is_masked(path_str) == 2);
+        SECTION("single chunk") {
+            auto ec = proxy.write(path, f, 0, as_bytes("12345"));
+            REQUIRE(!ec);
+            CHECK(mediator.is_masked(path_str) == 1);
+            CHECK(read_file(path) == "12345");
+        }
+        SECTION("many chunks") {
+            auto chunks = std::array<utils::bytes_view_t, 3>{as_bytes("34"), as_bytes(""), as_bytes("5")};
+            auto ec = proxy.write(path, f, 2, chunks);
+            REQUIRE(!ec);
+            CHECK(mediator.is_masked(path_str) == 1);
+            CHECK(read_file(path) == std::string("\0\0345", 5));
+        }
+    }
+    SECTION("copy_range") {
+        auto source = root_path / L"источник.bin";
+        auto target = root_path / L"цель.bin";
+        auto target_str = narrow(target.generic_wstring());
+        write_file(source, "1234567890");
+        write_file(target, "abcdefghij");
+        auto ec = proxy.copy_range(target, 5, source, 0, 5);
+#if defined(SYNCSPIRIT_COPY_FILE_RANGE) || defined(SYNCSPIRIT_FICLONERANGE)
+        REQUIRE(!ec);
+        CHECK(read_file(target) == "abcde12345");
+        CHECK(mediator.is_masked(target_str) == 1);
+        CHECK(proxy.mediator_updates == 1);
+#else
+        CHECK(ec == sys::errc::operation_not_supported);
+        CHECK(read_file(target) == "abcdefghij");
+#endif
+    }
+    SECTION("punch_hole") {
+        auto path = root_path / L"дыра.bin";
+        auto path_str = narrow(path.generic_wstring());
+        write_file(path, "1234567890");
+        auto ec = proxy.punch_hole(path, 2, 6);
+#ifdef SYNCSPIRIT_PUNCH_HOLE
+        if (ec != sys::errc::operation_not_supported) {
+            REQUIRE(!ec);
+            CHECK(read_file(path) == std::string("12\0\0\0\0\0\090", 10));
+            CHECK(mediator.is_masked(path_str) == 1);
+            CHECK(proxy.mediator_updates == 1);
+        }
+#else
+        CHECK(ec == sys::errc::operation_not_supported);
+        CHECK(read_file(path) == "1234567890");
+#endif
     }
 }
 
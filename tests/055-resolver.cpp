@@ -74,6 +74,18 @@ TEST_CASE("resolver", "[model]") {
         CHECK(action == A::ignore);
     }
 
+    SECTION("ignored name -> ignore") {
+        auto file_remote = file_info_t::create(sequencer->next_uuid(), pr_remote, folder_peer).value();
+        folder_peer->add_strict(file_remote);
+        folder->set_ignores(ignores_t::parse("*.txt\n").value());
+        auto action = resolve(*file_remote, folder_my->get_file_infos().by_name("a.txt").get(), *folder_my);
+        CHECK(action == A::ignore);
+
+        folder->set_ignores(ignores_t::parse("b.txt\n").value());
+        action = resolve(*file_remote, folder_my->get_file_infos().by_name("a.txt").get(), *folder_my);
+        CHECK(action == A::remote_copy);
+    }
+
     SECTION("3rd party has global version -> ignore") {
         auto pr_remote_2 = pr_remote;
         auto &c2 = proto::add_counters(proto::get_version(pr_remote_2));
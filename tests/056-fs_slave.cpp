@@ -6,11 +6,16 @@
 #include "fs/utils.h"
 #include "fs/updates_mediator.h"
 #include "fs/fs_proxy.h"
+#include "fs/scan_pool.h"
 #include "test-utils.h"
 #include "test_supervisor.h"
 #include "syncspirit-config.h"
 #include <boost/nowide/convert.hpp>
 
+#ifndef SYNCSPIRIT_WIN
+#include <sys/stat.h>
+#endif
+
 using namespace syncspirit;
 using namespace syncspirit::test;
 using namespace syncspirit::utils;
@@ -154,7 +159,81 @@ TEST_CASE("fs_slave, scan_dir", "[fs]") {
                 CHECK(to_unix(c.last_write_time) == modified);
             }
         }
+        SECTION("special files are skipped") {
+            write_file(root_path / "file", "");
+            REQUIRE(::mkfifo((root_path / "fifo").c_str(), 0600) == 0);
+
+            slave.push(task::scan_dir_t(root_path, {}, {}, false, true, false));
+            slave.exec(context);
+            REQUIRE(slave.tasks_out.size() == 1);
+            auto &t = std::get<task::scan_dir_t>(slave.tasks_out.front());
+            CHECK(!t.ec);
+            REQUIRE(t.child_infos.size() == 1);
+            CHECK(t.child_infos[0].path.filename() == "file");
+            CHECK(t.child_infos[0].status.permissions() == bfs::status(root_path / "file").permissions());
+        }
 #endif
+        SECTION("scan ahead") {
+            auto pool = scan_pool_t(2);
+            bfs::create_directories(root_path / "a" / "b" / "c");
+            bfs::create_directories(root_path / "d");
+            write_file(root_path / "a" / "b" / "file", "");
+            write_file(root_path / "file", "");
+
+            auto task = task::scan_dir_t(root_path, {}, {}, false, true, false);
+            SECTION("no pool") {
+                task.prefetch = 10;
+                slave.push(std::move(task));
+                slave.exec(context);
+                auto &t = std::get<task::scan_dir_t>(slave.tasks_out.front());
+                CHECK(!t.ec);
+                CHECK(t.child_infos.size() == 3);
+                CHECK(t.prefetched.empty());
+            }
+            SECTION("whole tree") {
+                context.scan_pool = &pool;
+                task.prefetch = 10;
+                slave.push(std::move(task));
+                slave.exec(context);
+                auto &t = std::get<task::scan_dir_t>(slave.tasks_out.front());
+                CHECK(!t.ec);
+                CHECK(t.child_infos.size() == 3);
+                REQUIRE(t.prefetched.size() == 4);
+                // level by level, in the scanning order
+                CHECK(t.prefetched[0].path == root_path / "d");
+                CHECK(t.prefetched[1].path == root_path / "a");
+                CHECK(t.prefetched[2].path == root_path / "a" / "b");
+                CHECK(t.prefetched[3].path == root_path / "a" / "b" / "c");
+                CHECK(t.prefetched[0].child_infos.size() == 0);
+                CHECK(t.prefetched[1].child_infos.size() == 1);
+                CHECK(t.prefetched[2].child_infos.size() == 2);
+                CHECK(t.prefetched[3].child_infos.size() == 0);
+                for (auto &p : t.prefetched) {
+                    CHECK(!p.ec);
+                    CHECK(!p.presence);
+                    CHECK(p.recurse);
+                    CHECK(p.prefetched.empty());
+                }
+            }
+            SECTION("bounded frontier") {
+                context.scan_pool = &pool;
+                task.prefetch = 3;
+                slave.push(std::move(task));
+                slave.exec(context);
+                auto &t = std::get<task::scan_dir_t>(slave.tasks_out.front());
+                REQUIRE(t.prefetched.size() == 3);
+                CHECK(t.prefetched[2].path == root_path / "a" / "b");
+            }
+            SECTION("non-recursive") {
+                context.scan_pool = &pool;
+                task.prefetch = 10;
+                task.recurse = false;
+                slave.push(std::move(task));
+                slave.exec(context);
+                auto &t = std::get<task::scan_dir_t>(slave.tasks_out.front());
+                CHECK(t.prefetched.empty());
+            }
+        }
     }
 
 #if 0
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "test-utils.h"
+#include "fs/file_handle.h"
+#include "utils/io.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace syncspirit;
+using namespace syncspirit::test;
+using namespace syncspirit::fs;
+
+TEST_CASE("file_handle_t", "[fs]") {
+    auto root_path = unique_path();
+    bfs::create_directories(root_path);
+    auto path_guard = test::path_guard_t(root_path);
+    auto path = root_path / L"файл.bin";
+
+    SECTION("missing file cannot be read") {
+        auto opt = file_handle_t::open(path, file_handle_t::mode_t::read);
+        REQUIRE(!opt);
+        CHECK(opt.assume_error() == sys::errc::no_such_file_or_directory);
+    }
+
+    SECTION("read_write creates file") {
+        auto opt = file_handle_t::open(path, file_handle_t::mode_t::read_write);
+        REQUIRE(opt);
+        auto &f = opt.assume_value();
+        CHECK(f);
+        CHECK(bfs::exists(path));
+
+        REQUIRE(!f.write(2, as_bytes("abc")));
+        auto chunks = std::array<utils::bytes_view_t, 2>{as_bytes("12"), as_bytes("de")};
+        REQUIRE(!f.write(5, chunks));
+        CHECK(read_file(path) == std::string("\0\0abc12de", 9));
+
+        auto buff = utils::bytes_t(4);
+        REQUIRE(!f.read(4, buff));
+        CHECK(buff == as_bytes("c12d"));
+
+        SECTION("reading past the end is an error") { CHECK(f.read(6, buff)); }
+
+        SECTION("close") {
+            CHECK(!f.close());
+            CHECK(!f);
+            CHECK(!f.close());
+        }
+
+        SECTION("allocate keeps the file size") {
+            auto ec = f.allocate(1024 * 1024);
+            CHECK((!ec || ec == sys::errc::operation_not_supported));
+            CHECK(bfs::file_size(path) == 9);
+            CHECK(read_file(path) == std::string("\0\0abc12de", 9));
+        }
+    }
+}
+
+TEST_CASE("file I/O throughput", "[.][benchmark]") {
+    static constexpr std::size_t block_size = 128 * 1024;
+    static constexpr std::size_t blocks = 256;
+
+    auto root_path = unique_path();
+    bfs::create_directories(root_path);
+    auto path_guard = test::path_guard_t(root_path);
+    auto path = root_path / "data.bin";
+
+    auto block = utils::bytes_t(block_size);
+    std::fill(block.begin(), block.end(), 'x');
+    {
+        auto out = utils::ofstream_t(path, utils::ofstream_t::binary);
+        for (std::size_t i = 0; i < blocks; ++i) {
+            out.write(reinterpret_cast<const char *>(block.data()), block.size());
+        }
+    }
+
+    auto sequential = std::vector<std::size_t>(blocks);
+    for (std::size_t i = 0; i < blocks; ++i) {
+        sequential[i] = i;
+    }
+    auto random = sequential;
+    std::shuffle(random.begin(), random.end(), std::mt19937{5});
+
+    auto stream = utils::fstream_t(path, utils::fstream_t::binary | utils::fstream_t::in | utils::fstream_t::out);
+    auto handle = file_handle_t::open(path, file_handle_t::mode_t::read_write).value();
+
+    auto stream_read = [&](const std::vector<std::size_t> &order) {
+        auto r = std::size_t{0};
+        for (auto i : order) {
+            stream.seekg(static_cast<long>(i * block_size));
+            stream.read(reinterpret_cast<char *>(block.data()), block.size());
+            r += static_cast<std::size_t>(stream.gcount());
+        }
+        return r;
+    };
+    auto stream_write = [&](const std::vector<std::size_t> &order) {
+        for (auto i : order) {
+            stream.seekp(static_cast<long>(i * block_size));
+            stream.write(reinterpret_cast<const char *>(block.data()), block.size());
+            stream.flush();
+        }
+        return stream.good();
+    };
+    auto handle_read = [&](const std::vector<std::size_t> &order) {
+        auto r = std::size_t{0};
+        for (auto i : order) {
+            r += handle.read(i * block_size, block) ? 0 : block.size();
+        }
+        return r;
+    };
+    auto handle_write = [&](const std::vector<std::size_t> &order) {
+        auto ok = true;
+        for (auto i : order) {
+            ok = ok && !handle.write(i * block_size, utils::bytes_view_t(block));
+        }
+        return ok;
+    };
+
+    BENCHMARK("fstream, sequential read") { return stream_read(sequential); };
+    BENCHMARK("file_handle, sequential read") { return handle_read(sequential); };
+    BENCHMARK("fstream, random read") { return stream_read(random); };
+    BENCHMARK("file_handle, random read") { return handle_read(random); };
+    BENCHMARK("fstream, sequential write") { return stream_write(sequential); };
+    BENCHMARK("file_handle, sequential write") { return handle_write(sequential); };
+    BENCHMARK("fstream, random write") { return stream_write(random); };
+    BENCHMARK("file_handle, random write") { return handle_write(random); };
+}
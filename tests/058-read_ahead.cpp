@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "test-utils.h"
+#include "fs/read_ahead.h"
+
+using namespace syncspirit;
+using namespace syncspirit::fs;
+
+TEST_CASE("read_ahead_t", "[fs]") {
+    auto ra = read_ahead_t();
+    auto peer_1 = (const void *)(&ra);
+    auto peer_2 = (const void *)(&peer_1);
+
+    SECTION("random access") {
+        CHECK(ra.read(peer_1, 50, 10).size == 0);
+        CHECK(ra.read(peer_1, 10, 10).size == 0);
+        CHECK(ra.read(peer_1, 90, 10).size == 0);
+    }
+
+    SECTION("sequential access") {
+        CHECK(ra.read(peer_1, 0, 10).size == 0);
+
+        auto r = ra.read(peer_1, 10, 10);
+        CHECK(r.offset == 20);
+        CHECK(r.size == 20);
+
+        r = ra.read(peer_1, 20, 10);
+        CHECK(r.offset == 40);
+        CHECK(r.size == 30);
+
+        r = ra.read(peer_1, 30, 10);
+        CHECK(r.offset == 70);
+        CHECK(r.size == 50);
+
+        SECTION("the window is capped") {
+            for (std::uint64_t offset = 40; offset < 500; offset += 10) {
+                r = ra.read(peer_1, offset, 10);
+                CHECK(r.offset + r.size <= offset + 10 + read_ahead_t::max_blocks * 10);
+            }
+        }
+
+        SECTION("no re-advising, while half of the window is ahead") {
+            ra.read(peer_1, 40, 10);
+            ra.read(peer_1, 50, 10);
+            CHECK(ra.read(peer_1, 60, 10).size == 0);
+        }
+
+        SECTION("seek resets") {
+            CHECK(ra.read(peer_1, 1000, 10).size == 0);
+            CHECK(ra.read(peer_1, 1010, 10).size == 20);
+        }
+    }
+
+    SECTION("readers are independent") {
+        CHECK(ra.read(peer_1, 0, 10).size == 0);
+        CHECK(ra.read(peer_2, 100, 10).size == 0);
+        CHECK(ra.read(peer_1, 10, 10).size == 20);
+        CHECK(ra.read(peer_2, 110, 10).size == 20);
+    }
+}
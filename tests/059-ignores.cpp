@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Ivan Baidakou
+
+#include "test-utils.h"
+#include "model/misc/ignores.h"
+#include "model/misc/error_code.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <random>
+
+using namespace syncspirit;
+using namespace syncspirit::model;
+using namespace syncspirit::test;
+
+using M = ignores_t::match_t;
+
+static ignores_ptr_t parse(std::string_view content) {
+    auto r = ignores_t::parse(content);
+    REQUIRE(r);
+    return std::move(r.assume_value());
+}
+
+TEST_CASE("ignores", "[model]") {
+    SECTION("literals") {
+        auto ignores = parse("// comment\n"
+                             "node_modules\n"
+                             "/build\n"
+                             "/deep/path/literal\n"
+                             "(?i)Thumbs.db\n"
+                             "#other comment\n");
+        CHECK(ignores->size() == 4);
+        CHECK(ignores->is_ignored(".stignore"));
+        CHECK(!ignores->is_ignored("a/.stignore"));
+        CHECK(ignores->is_ignored("node_modules"));
+        CHECK(ignores->is_ignored("a/node_modules/x/y"));
+        CHECK(!ignores->is_ignored("node_modules_2"));
+        CHECK(ignores->is_ignored("build"));
+        CHECK(ignores->is_ignored("build/x"));
+        CHECK(!ignores->is_ignored("a/build"));
+        CHECK(ignores->is_ignored("deep/path/literal/x"));
+        CHECK(!ignores->is_ignored("deep/path"));
+        CHECK(ignores->is_ignored("d/thumbs.DB"));
+        CHECK(!ignores->is_ignored("d/thumbs.dbx"));
+    }
+
+    SECTION("affixes") {
+        auto ignores = parse("*.o\n~*\n(?i)*.JPG\n");
+        CHECK(ignores->is_ignored("x.o"));
+        CHECK(ignores->is_ignored("d/x.o"));
+        CHECK(ignores->is_ignored("x.o/y"));
+        CHECK(!ignores->is_ignored("x.ox"));
+        CHECK(ignores->is_ignored("d/~tmp"));
+        CHECK(!ignores->is_ignored("d/x~tmp"));
+        CHECK(ignores->is_ignored("P.jpg"));
+        CHECK(ignores->is_ignored("P.Jpg"));
+    }
+
+    SECTION("globs") {
+        auto ignores = parse("src/**/gen\n"
+                             "a/**/b\n"
+                             "**/cache/*.tmp\n"
+                             "file?.txt\n"
+                             "[abc]x\n"
+                             "{foo,bar}.bak\n"
+                             "/a/*.c\n"
+                             "/x?z\n"
+                             "**/ü?.txt\n"
+                             "[!a-c]y\n");
+        CHECK(ignores->is_ignored("src/gen"));
+        CHECK(ignores->is_ignored("src/x/y/gen/z"));
+        CHECK(ignores->is_ignored("a/b"));
+        CHECK(ignores->is_ignored("a/x/y/b"));
+        CHECK(ignores->is_ignored("cache/z.tmp"));
+        CHECK(ignores->is_ignored("q/cache/z.tmp"));
+        CHECK(!ignores->is_ignored("q/cache/z.txt"));
+        CHECK(ignores->is_ignored("file1.txt"));
+        CHECK(!ignores->is_ignored("file12.txt"));
+        CHECK(ignores->is_ignored("ax"));
+        CHECK(ignores->is_ignored("k/bx"));
+        CHECK(!ignores->is_ignored("dx"));
+        CHECK(ignores->is_ignored("foo.bak"));
+        CHECK(ignores->is_ignored("bar.bak"));
+        CHECK(!ignores->is_ignored("baz.bak"));
+        CHECK(ignores->is_ignored("a/f.c"));
+        CHECK(!ignores->is_ignored("a/c/f.c"));
+        CHECK(!ignores->is_ignored("b/a/f.c"));
+        CHECK(ignores->is_ignored("xyz"));
+        CHECK(ignores->is_ignored("xяz"));
+        CHECK(!ignores->is_ignored("x/z"));
+        CHECK(ignores->is_ignored("d/üя.txt"));
+        CHECK(ignores->is_ignored("dy"));
+        CHECK(!ignores->is_ignored("ay"));
+    }
+
+    SECTION("first matching pattern wins") {
+        auto ignores = parse("!important.log\n*.log\n/build\n!build/keep\n*\n");
+        CHECK(!ignores->is_ignored("important.log"));
+        CHECK(ignores->is_ignored("other.log"));
+        CHECK(ignores->is_ignored("build"));
+        CHECK(ignores->is_ignored("build/keep"));
+        CHECK(ignores->is_ignored("anything"));
+    }
+
+    SECTION("negated patterns") {
+        auto ignores = parse("!keep\n*.tmp\nsub\n");
+        CHECK(ignores->match("sub") == M::ignored_self);
+        CHECK(ignores->match("sub/keep") == M::included);
+        CHECK(ignores->match("sub/x") == M::ignored_self);
+        CHECK(ignores->match("a.tmp") == M::ignored_self);
+
+        ignores = parse("sub\n!keep\n");
+        CHECK(ignores->match("sub") == M::ignored);
+        CHECK(ignores->match("sub/keep") == M::ignored);
+        CHECK(!ignores->is_ignored("keep"));
+        CHECK(!ignores->is_ignored("subx"));
+        CHECK(!ignores->is_ignored("a/xsub"));
+    }
+
+    SECTION("deletable") {
+        auto ignores = parse("(?d)del\ndy\n");
+        CHECK(ignores->is_deletable("del"));
+        CHECK(ignores->is_deletable("a/del"));
+        CHECK(!ignores->is_deletable("dy"));
+    }
+
+    SECTION("includes") {
+        auto loader = [](std::string_view path) -> outcome::result<std::string> {
+            if (path == "sub/more") {
+                return std::string("#include other\nfoo\n");
+            } else if (path == "sub/other") {
+                return std::string("bar\n");
+            } else if (path == "loop") {
+                return std::string("#include loop\n");
+            }
+            return sys::errc::make_error_code(sys::errc::no_such_file_or_directory);
+        };
+        auto r = ignores_t::parse("#include sub/more\n", loader);
+        REQUIRE(r);
+        CHECK(r.value()->is_ignored("foo"));
+        CHECK(r.value()->is_ignored("bar"));
+
+        r = ignores_t::parse("#include loop\n", loader);
+        REQUIRE(!r);
+        CHECK(r.assume_error() == model::make_error_code(model::error_code_t::too_deep_ignores_include));
+
+        r = ignores_t::parse("#include missing\n", loader);
+        REQUIRE(!r);
+        CHECK(r.assume_error() == sys::errc::no_such_file_or_directory);
+        CHECK(!ignores_t::parse("#include missing\n"));
+    }
+
+    SECTION("invalid patterns") {
+        auto r = ignores_t::parse("!\n");
+        REQUIRE(!r);
+        CHECK(r.assume_error() == model::make_error_code(model::error_code_t::invalid_ignore_pattern));
+        CHECK(!ignores_t::parse("/\n"));
+    }
+
+    SECTION("comparison") {
+        CHECK(*parse("a\nb") == *parse("a\r\nb\n"));
+        CHECK(!(*parse("a\nb") == *parse("a\n")));
+    }
+}
+
+TEST_CASE("ignores matching throughput", "[.][benchmark]") {
+    auto content = std::string();
+    for (int i = 0; i < 500; ++i) {
+        auto n = std::to_string(i);
+        switch (i % 5) {
+        case 0:
+            content += "dir" + n + "\n";
+            break;
+        case 1:
+            content += "*.ext" + n + "\n";
+            break;
+        case 2:
+            content += "/top" + n + "/sub\n";
+            break;
+        case 3:
+            content += "**/gen" + n + "/*.tmp\n";
+            break;
+        default:
+            content += "(?i)file[0-9]" + n + "?.bin\n";
+        }
+    }
+    auto ignores = parse(content);
+
+    auto generator = std::mt19937(5);
+    auto paths = std::vector<std::string>();
+    paths.reserve(1'000'000);
+    for (std::size_t i = 0; i < 1'000'000; ++i) {
+        auto path = std::string();
+        auto depth = generator() % 6 + 1;
+        for (std::uint32_t j = 0; j < depth; ++j) {
+            path += j ? "/component" : "component";
+            path += std::to_string(generator() % 1000);
+        }
+        path += ".ext" + std::to_string(generator() % 1000);
+        paths.emplace_back(std::move(path));
+    }
+
+    BENCHMARK("1M paths, 500 patterns") {
+        auto ignored = std::size_t{0};
+        for (auto &path : paths) {
+            ignored += ignores->is_ignored(path) ? 1 : 0;
+        }
+        return ignored;
+    };
+}
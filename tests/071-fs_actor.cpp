@@ -5,9 +5,16 @@
 #include "fs/file_actor.h"
 #include "fs/utils.h"
 #include "fs/platform/context_base.h"
+#include "fs/platform/linux/uring.h"
+#include "fs/io_pool.h"
+#include "fs/fs_proxy.h"
+#include "fs/journal.h"
 #include "net/names.h"
 #include "test_supervisor.h"
 #include "access.h"
+#include "diff-builder.h"
+#include "model/cluster.h"
+#include "model/diff/local/io_stats.h"
 #include "utils/error_code.h"
 #include "syncspirit-config.h"
 #include <filesystem>
@@ -36,7 +43,7 @@ using io_commands_t_ptr_t = r::intrusive_ptr_t<io_commands_t>;
 
 struct my_context_t final : platform::context_base_t {
     using parent_t = platform::context_base_t;
-    my_context_t() : parent_t(pt::milliseconds{1}) {};
+    my_context_t(fs::io_engine_t *io_engine_ = nullptr) : parent_t(pt::milliseconds{1}) { io_engine = io_engine_; };
     void poll_events() noexcept override {};
 };
 
@@ -101,11 +108,15 @@ struct fixture_t {
                          .change_retension(retension)
                          .updates_mediator(updates_mediator)
                          .watched_folders(watched_folders)
+                         .write_buffer(write_buffer)
+                         .durable(durable)
+                         .stats_interval(stats_interval)
                          .finish();
     }
 
     virtual void run() noexcept {
-        auto ctx = my_context_t();
+        auto ctx = my_context_t(io_engine);
+        ctx.io_events = io_events;
         sup = ctx.create_supervisor<supervisor_t>()
                   .auto_finish(false)
                   .auto_ack_io(false)
@@ -171,6 +182,20 @@ struct fixture_t {
         return chain_builder_t(this, reply, std::in_place_type_t<decltype(payload)>());
     }
 
+    chain_builder_t clone_file(const bfs::path &target, const bfs::path &source, std::uint64_t file_size,
+                               std::int64_t modification_s, std::uint32_t permissions, bool no_permissions,
+                               const bfs::path &conflict_path = {}) noexcept {
+        auto context = fs::payload::extendended_context_prt_t{};
+        auto payload = fs::payload::clone_file_t(std::move(context), folder_id, target, conflict_path, source,
+                                                 file_size, modification_s, permissions, no_permissions);
+        auto cmd = fs::payload::io_command_t(std::move(payload));
+        auto cmds = fs::payload::io_commands_t{nullptr};
+        cmds.commands.emplace_back(std::move(cmd));
+        sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+        sup->do_process();
+        return chain_builder_t(this, reply, std::in_place_type_t<decltype(payload)>());
+    }
+
     chain_builder_t finish_file(const bfs::path &path, std::uint64_t file_size, std::int64_t modification_s,
                                 std::uint32_t permissions, bool no_permissions,
                                 const bfs::path &conflict_path = {}) noexcept {
@@ -232,6 +257,11 @@ struct fixture_t {
     r::system_context_t ctx;
     io_commands_t_ptr_t reply;
     std::string folder_id = "1234-5678";
+    fs::io_engine_t *io_engine = nullptr;
+    bool io_events = false;
+    std::uint32_t write_buffer = 0;
+    bool durable = false;
+    r::pt::time_duration stats_interval = {};
 };
 } // namespace
 
@@ -644,6 +674,51 @@ void test_clone_block() {
     F().run();
 }
 
+void test_clone_file() {
+    struct F : fixture_t {
+        void main() noexcept override {
+            std::int64_t modified = 1641828421;
+            auto perms = std::uint32_t(0444);
+#ifndef SYNCSPIRIT_WIN
+            auto no_perms = false;
+#else
+            auto no_perms = true;
+#endif
+            auto source_path = root_path / L"ать.txt";
+            auto target_path = root_path / L"п" / L"ять.txt";
+            auto tmp_path_str = narrow(make_temporal(target_path).generic_wstring());
+
+            SECTION("successful clone") {
+                write_file(source_path, "1234567890");
+                clone_file(target_path, source_path, 10, modified, perms, no_perms).check_success();
+
+                REQUIRE(bfs::exists(target_path));
+                REQUIRE(bfs::file_size(target_path) == 10);
+                CHECK(read_file(target_path) == "1234567890");
+                CHECK(read_file(source_path) == "1234567890");
+                CHECK(to_unix(bfs::last_write_time(target_path)) == modified);
+                CHECK(!bfs::exists(make_temporal(target_path)));
+                CHECK(updates_mediator->is_masked(tmp_path_str) == 0);
+            }
+            SECTION("with conflict") {
+                auto conflict_path = root_path / L"п" / L"ять.conflict.txt";
+                write_file(source_path, "1234567890");
+                bfs::create_directories(target_path.parent_path());
+                write_file(target_path, "abc");
+                clone_file(target_path, source_path, 10, modified, perms, no_perms, conflict_path).check_success();
+
+                CHECK(read_file(target_path) == "1234567890");
+                CHECK(read_file(conflict_path) == "abc");
+            }
+            SECTION("missing source") {
+                clone_file(target_path, source_path, 10, modified, perms, no_perms).check_fail();
+                CHECK(!bfs::exists(target_path));
+            }
+        }
+    };
+    F().run();
+}
+
 void test_update_meta() {
     struct F : fixture_t {
         void main() noexcept override {
@@ -755,13 +830,661 @@ void test_requesting_block() {
     F().run();
 }
 
+void test_batched_io() {
+    struct F : fixture_t {
+        void main() noexcept override {
+            auto path = root_path / L"файл.bin";
+            auto source = root_path / "source.bin";
+            write_file(source, "abcdefghij");
+
+            auto block_1 = as_owned_bytes("12345");
+            auto block_2 = as_owned_bytes("67890");
+            auto cmds = fs::payload::io_commands_t{nullptr};
+            cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, block_2, 5, 10));
+            cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, block_1, 0, 10));
+            cmds.commands.emplace_back(fs::payload::block_request_t({}, source, 0, 5));
+            cmds.commands.emplace_back(fs::payload::block_request_t({}, source, 5, 5));
+            cmds.commands.emplace_back(fs::payload::block_request_t({}, source, 8, 5));
+            cmds.commands.emplace_back(
+                fs::payload::finish_file_t({}, folder_id, path, {}, 10, 1641828421, 0666, true));
+            for (auto &cmd : cmds.commands) {
+                if (auto append = std::get_if<fs::payload::append_block_t>(&cmd); append) {
+                    append->uncached = uncached;
+                } else if (auto request = std::get_if<fs::payload::block_request_t>(&cmd); request) {
+                    request->uncached = uncached;
+                }
+            }
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+            sup->do_process();
+
+            REQUIRE(reply);
+            auto &commands = reply->payload.commands;
+            REQUIRE(commands.size() == 6);
+            CHECK(std::get<fs::payload::append_block_t>(commands[0]).result);
+            CHECK(std::get<fs::payload::append_block_t>(commands[1]).result);
+            auto &read_1 = std::get<fs::payload::block_request_t>(commands[2]).result;
+            REQUIRE(read_1);
+            CHECK(read_1.value() == as_bytes("abcde"));
+            auto &read_2 = std::get<fs::payload::block_request_t>(commands[3]).result;
+            REQUIRE(read_2);
+            CHECK(read_2.value() == as_bytes("fghij"));
+            CHECK(std::get<fs::payload::block_request_t>(commands[4]).result.has_error());
+            CHECK(std::get<fs::payload::finish_file_t>(commands[5]).result);
+
+            REQUIRE(bfs::exists(path));
+            CHECK(read_file(path) == "1234567890");
+        }
+
+        bool uncached = false;
+    };
+    SECTION("synchronous") { F().run(); }
+    SECTION("write-behind") {
+        auto f = F();
+        f.write_buffer = 1024;
+        f.run();
+    }
+    SECTION("durable") {
+        auto f = F();
+        f.durable = true;
+        f.run();
+    }
+    SECTION("uncached") {
+        auto f = F();
+        f.uncached = true;
+        f.run();
+    }
+    SECTION("uncached write-behind") {
+        auto f = F();
+        f.uncached = true;
+        f.write_buffer = 1024;
+        f.run();
+    }
+    SECTION("thread pool") {
+        auto engine = fs::io_pool_t(2);
+        auto f = F();
+        f.io_engine = &engine;
+        f.run();
+    }
+    SECTION("uncached thread pool") {
+        auto engine = fs::io_pool_t(2);
+        auto f = F();
+        f.uncached = true;
+        f.io_engine = &engine;
+        f.run();
+    }
+#if SYNCSPIRIT_IO_URING
+    SECTION("io_uring") {
+        auto engine = fs::platform::linux::uring_engine_t(4);
+        if (engine.ready()) {
+            auto f = F();
+            f.io_engine = &engine;
+            f.run();
+        }
+    }
+#endif
+}
+
+void test_async_io() {
+    /* the requests are performed on run(), as if they were finished in background */
+    struct deferred_engine_t final : fs::io_engine_t {
+        bool submit(fs::io_request_t &request) noexcept override {
+            submitted.emplace_back(&request);
+            return true;
+        }
+        void poll() noexcept override {
+            notified = false;
+            for (auto request : performed) {
+                request->finished = true;
+            }
+            performed.clear();
+        }
+        void complete() noexcept override {
+            run();
+            poll();
+        }
+        void run() noexcept {
+            for (auto request : submitted) {
+                auto ec = sys::error_code();
+                if (request->write) {
+                    auto data = utils::bytes_view_t(request->data, request->size);
+                    ec = fs::file_handle_t::write_at(request->fd, request->offset, data);
+                } else {
+                    auto data = std::span<unsigned char>(request->data, request->size);
+                    ec = fs::file_handle_t::read_at(request->fd, request->offset, data);
+                }
+                if (ec) {
+                    request->error = ec.value();
+                } else {
+                    request->done = request->size;
+                }
+                performed.emplace_back(request);
+            }
+            submitted.clear();
+            notify();
+        }
+
+        std::vector<fs::io_request_t *> submitted;
+        std::vector<fs::io_request_t *> performed;
+    };
+
+    struct F : fixture_t {
+        configure_callback_t configure() noexcept override {
+            return [&](r::plugin::plugin_base_t &plugin) {
+                fixture_t::configure()(plugin);
+                plugin.template with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
+                    auto on_reply = [&](io_commands_t &msg) { replies.emplace_back(&msg); };
+                    p.subscribe_actor(r::lambda<io_commands_t>(std::move(on_reply)));
+                });
+            };
+        }
+
+        void main() noexcept override {
+            auto source = root_path / "source.bin";
+            write_file(source, "abcdefghij");
+
+            auto block_1 = as_owned_bytes("12345");
+            auto block_2 = as_owned_bytes("67890");
+            auto cmds_1 = fs::payload::io_commands_t{nullptr};
+            cmds_1.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, block_1, 0, 10));
+            cmds_1.commands.emplace_back(fs::payload::block_request_t({}, source, 0, 5));
+            cmds_1.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, block_2, 5, 10));
+            auto cmds_2 = fs::payload::io_commands_t{nullptr};
+            cmds_2.commands.emplace_back(
+                fs::payload::finish_file_t({}, folder_id, path, {}, 10, 1641828421, 0666, true));
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds_1));
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds_2));
+            sup->do_process();
+
+            // the block I/O is in flight, the second batch waits for the first one
+            CHECK(replies.empty());
+            CHECK(engine.submitted.size() == 3);
+
+            if (shutdown) {
+                file_actor->do_shutdown();
+                sup->do_process();
+            } else {
+                engine.run();
+                sup->do_process();
+            }
+
+            REQUIRE(replies.size() == 2);
+            auto &commands_1 = replies[0]->payload.commands;
+            REQUIRE(commands_1.size() == 3);
+            CHECK(std::get<fs::payload::append_block_t>(commands_1[0]).result);
+            auto &read = std::get<fs::payload::block_request_t>(commands_1[1]).result;
+            REQUIRE(read);
+            CHECK(read.value() == as_bytes("abcde"));
+            CHECK(std::get<fs::payload::append_block_t>(commands_1[2]).result);
+
+            auto &commands_2 = replies[1]->payload.commands;
+            REQUIRE(commands_2.size() == 1);
+            CHECK(std::get<fs::payload::finish_file_t>(commands_2[0]).result);
+            CHECK(read_file(path) == "1234567890");
+        }
+
+        bfs::path path = root_path / L"файл.bin";
+        deferred_engine_t engine;
+        std::vector<io_commands_t_ptr_t> replies;
+        bool shutdown = false;
+    };
+    SECTION("finished in background") {
+        auto f = F();
+        f.io_engine = &f.engine;
+        f.io_events = true;
+        f.run();
+    }
+    SECTION("finished on shutdown") {
+        auto f = F();
+        f.io_engine = &f.engine;
+        f.io_events = true;
+        f.shutdown = true;
+        f.run();
+    }
+}
+
+void test_ro_cache() {
+    struct F : fixture_t {
+        void create_file_actor() noexcept override {
+            ro_cache = new fs::file_cache_t(2);
+            file_actor = sup->create_actor<fs::file_actor_t>()
+                             .timeout(timeout)
+                             .change_retension(retension)
+                             .updates_mediator(updates_mediator)
+                             .watched_folders(watched_folders)
+                             .ro_cache(ro_cache)
+                             .finish();
+        }
+
+        utils::bytes_t read(const bfs::path &path) noexcept {
+            auto cmds = fs::payload::io_commands_t{nullptr};
+            cmds.commands.emplace_back(fs::payload::block_request_t({}, path, 0, 5));
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+            sup->do_process();
+            REQUIRE(reply);
+            auto &result = std::get<fs::payload::block_request_t>(reply->payload.commands.front()).result;
+            REQUIRE(result);
+            return result.value();
+        }
+
+        void main() noexcept override {
+            auto path = bfs::absolute(root_path / L"файл.bin");
+            write_file(path, "1234567890");
+
+            CHECK(read(path) == as_bytes("12345"));
+            auto file = ro_cache->get(path);
+            REQUIRE(file);
+            CHECK(read(path) == as_bytes("12345"));
+            CHECK(ro_cache->get(path) == file);
+            file.reset();
+
+            SECTION("local modification") {
+                auto cmds = fs::payload::io_commands_t{nullptr};
+                auto data = as_owned_bytes("abcde");
+                cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, data, 0, 5));
+                cmds.commands.emplace_back(
+                    fs::payload::finish_file_t({}, folder_id, path, {}, 5, 1641828421, 0666, true));
+                sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+                sup->do_process();
+                CHECK(!ro_cache->get(path));
+                CHECK(read(path) == as_bytes("abcde"));
+            }
+            SECTION("lru eviction") {
+                auto path_2 = bfs::absolute(root_path / "b.bin");
+                auto path_3 = bfs::absolute(root_path / "c.bin");
+                write_file(path_2, "bbbbb");
+                write_file(path_3, "ccccc");
+                CHECK(read(path_2) == as_bytes("bbbbb"));
+                CHECK(read(path_3) == as_bytes("ccccc"));
+                CHECK(!ro_cache->get(path));
+                CHECK(ro_cache->get(path_2));
+                CHECK(ro_cache->get(path_3));
+            }
+            SECTION("removal") {
+                auto proxy = fs::fs_proxy_t(*updates_mediator, r::pt::microsec_clock::local_time());
+                proxy.ro_cache = ro_cache.get();
+                REQUIRE(!proxy.remove(bfs::absolute(root_path)));
+                CHECK(!ro_cache->get(path));
+            }
+            ro_cache->clear();
+        }
+
+        fs::file_cache_ptr_t ro_cache;
+    };
+    F().run();
+}
+
+void test_durable_finish() {
+    struct F : fixture_t {
+        void main() noexcept override {
+            auto paths = std::vector<bfs::path>();
+            for (auto i = 0; i < 5; ++i) {
+                auto dir = root_path / (i % 2 ? L"папка" : L"каталог");
+                paths.emplace_back(bfs::absolute(dir / (std::to_string(i) + ".bin")));
+            }
+            auto conflict_path = paths[0].parent_path() / L"экс.bin";
+            bfs::create_directories(paths[0].parent_path());
+            write_file(paths[0], "old");
+
+            auto data = as_owned_bytes("12345");
+            auto cmds = fs::payload::io_commands_t{nullptr};
+            for (auto &path : paths) {
+                cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, data, 0, 5));
+            }
+            for (auto &path : paths) {
+                auto conflict = &path == &paths[0] ? conflict_path : bfs::path{};
+                cmds.commands.emplace_back(
+                    fs::payload::finish_file_t({}, folder_id, path, conflict, 5, 1641828421, 0666, true));
+            }
+            // the metadata update is a barrier, i.e. it sees the files finished
+            cmds.commands.emplace_back(fs::payload::update_meta_t({}, folder_id, paths[1], 1641828422, 0666, true));
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+            sup->do_process();
+
+            REQUIRE(reply);
+            auto &commands = reply->payload.commands;
+            REQUIRE(commands.size() == 11);
+            for (std::size_t i = 0; i < paths.size(); ++i) {
+                CHECK(std::get<fs::payload::append_block_t>(commands[i]).result);
+                CHECK(std::get<fs::payload::finish_file_t>(commands[paths.size() + i]).result);
+                REQUIRE(bfs::exists(paths[i]));
+                CHECK(!bfs::exists(make_temporal(paths[i])));
+                CHECK(read_file(paths[i]) == "12345");
+            }
+            CHECK(std::get<fs::payload::update_meta_t>(commands.back()).result);
+            CHECK(to_unix(bfs::last_write_time(paths[1])) == 1641828422);
+            CHECK(read_file(conflict_path) == "old");
+        }
+    };
+    struct F2 : fixture_t {
+        void main() noexcept override {
+            auto path = bfs::absolute(root_path / L"файл.bin");
+            auto data = as_owned_bytes("12345");
+            auto cmds = fs::payload::io_commands_t{nullptr};
+            cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, data, 0, 5));
+            for (auto i = 0; i < 2; ++i) {
+                cmds.commands.emplace_back(
+                    fs::payload::finish_file_t({}, folder_id, path, {}, 5, 1641828421, 0666, true));
+            }
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+            sup->do_process();
+
+            REQUIRE(reply);
+            auto &commands = reply->payload.commands;
+            REQUIRE(commands.size() == 3);
+            CHECK(std::get<fs::payload::append_block_t>(commands[0]).result);
+            CHECK(std::get<fs::payload::finish_file_t>(commands[1]).result);
+            auto &r = std::get<fs::payload::finish_file_t>(commands[2]).result;
+            REQUIRE(!r);
+            CHECK(r.assume_error() == utils::make_error_code(utils::error_code_t::flush_non_opened));
+            CHECK(read_file(path) == "12345");
+        }
+    };
+    struct F3 : fixture_t {
+        void main() noexcept override {
+            auto path = root_path / L"файл.bin";
+            auto path_str = narrow(path.generic_wstring());
+            auto other = root_path / L"другой.bin";
+            auto data = as_owned_bytes("12345");
+            auto cmds = fs::payload::io_commands_t{nullptr};
+            cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, data, 0, 5));
+            cmds.commands.emplace_back(
+                fs::payload::finish_file_t({}, folder_id, path, {}, 5, 1641828421, 0666, true));
+            // the last command belongs to an unwatched folder
+            cmds.commands.emplace_back(fs::payload::append_block_t({}, "other-folder", other, data, 0, 5));
+            sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+            sup->do_process();
+
+            REQUIRE(reply);
+            auto &commands = reply->payload.commands;
+            REQUIRE(commands.size() == 3);
+            CHECK(std::get<fs::payload::append_block_t>(commands[0]).result);
+            CHECK(std::get<fs::payload::finish_file_t>(commands[1]).result);
+            CHECK(std::get<fs::payload::append_block_t>(commands[2]).result);
+            CHECK(read_file(path) == "12345");
+            CHECK(updates_mediator->is_masked(path_str) >= 1);
+        }
+    };
+    SECTION("group of files") {
+        auto f = F();
+        f.durable = true;
+        f.run();
+    }
+    SECTION("the same file is finished twice") {
+        auto f = F2();
+        f.durable = true;
+        f.run();
+    }
+    SECTION("finished file is masked with the settings of its folder") {
+        auto f = F3();
+        f.durable = true;
+        f.write_buffer = 1024;
+        f.run();
+    }
+}
+
+void test_io_stats() {
+    using op_t = fs::io_stats_t::op_t;
+    using update_msg_t = model::message::model_update_t;
+
+    SECTION("counters") {
+        auto stats = fs::io_stats_t();
+        CHECK(stats.empty());
+        stats.record(op_t::read, 10, std::uint64_t{1});
+        stats.record(op_t::read, 20, std::uint64_t{3});
+        stats.record(op_t::read, 30, std::uint64_t{100});
+        CHECK(!stats.empty());
+        auto &c = stats.get(op_t::read);
+        CHECK(c.count == 3);
+        CHECK(c.bytes == 60);
+        CHECK(c.max_us == 100);
+        CHECK(c.percentile(0.3) == 2);
+        CHECK(c.percentile(0.5) == 4);
+        CHECK(c.percentile(1.0) == 100);
+        CHECK(stats.get(op_t::write).count == 0);
+
+        auto other = fs::io_stats_t();
+        other.record(op_t::read, 5, std::uint64_t{1'000'000'000});
+        stats.merge(other);
+        CHECK(c.count == 4);
+        CHECK(c.bytes == 65);
+        CHECK(c.histogram.back() == 1);
+        CHECK(c.percentile(1.0) == 1'000'000'000);
+    }
+
+    SECTION("reporting") {
+        struct F : fixture_t {
+            configure_callback_t configure() noexcept override {
+                auto parent = fixture_t::configure();
+                return [this, parent](r::plugin::plugin_base_t &plugin) {
+                    parent(plugin);
+                    plugin.template with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
+                        p.subscribe_actor(r::lambda<update_msg_t>([&](update_msg_t &msg) { update = &msg; }));
+                    });
+                };
+            }
+
+            // fires the stats timer as well as the changes expiration one, which is harmless
+            void trigger() noexcept {
+                auto owner = static_cast<r::actor_base_t *>(file_actor.get());
+                auto timer_ids = std::vector<r::request_id_t>();
+                for (auto handler : sup->timers) {
+                    if (handler->owner == owner) {
+                        timer_ids.emplace_back(handler->request_id);
+                    }
+                }
+                REQUIRE(!timer_ids.empty());
+                for (auto id : timer_ids) {
+                    sup->do_invoke_timer(id);
+                }
+                sup->do_process();
+            }
+
+            void main() noexcept override {
+                auto my_id = model::device_id_t::from_string(
+                                 "KHQNO2S-5QSILRK-YX4JZZ4-7L77APM-QNVGZJT-EKU7IFI-PNEPBMY-4MXFMQD")
+                                 .value();
+                auto my_device = model::device_t::create(my_id, "my-device").value();
+                auto cluster = model::cluster_ptr_t(new model::cluster_t(my_device, 1));
+                cluster->get_devices().put(my_device);
+                REQUIRE(diff_builder_t(*cluster).upsert_folder(folder_id, root_path).apply());
+                auto folder = cluster->get_folders().by_id(folder_id);
+                sup->cluster = cluster;
+
+                auto path = root_path / L"файл.bin";
+                auto data = as_owned_bytes("12345");
+                auto cmds = fs::payload::io_commands_t{nullptr};
+                cmds.commands.emplace_back(fs::payload::append_block_t({}, folder_id, path, data, 0, 5));
+                cmds.commands.emplace_back(
+                    fs::payload::finish_file_t({}, folder_id, path, {}, 5, 1641828421, 0666, true));
+                auto request = fs::payload::block_request_t({}, path, 1, 3);
+                request.folder_id = folder_id;
+                cmds.commands.emplace_back(std::move(request));
+                sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+                sup->do_process();
+                REQUIRE(reply);
+                CHECK(std::get<fs::payload::block_request_t>(reply->payload.commands.back()).result);
+
+                trigger();
+                REQUIRE(update);
+                auto diff = dynamic_cast<model::diff::local::io_stats_t *>(update->payload.diff.get());
+                REQUIRE(diff);
+                REQUIRE(diff->folders.size() == 1);
+                CHECK(diff->folders[0].folder_id == folder_id);
+
+                // the report is accumulated by the folder
+                auto name = [](op_t op) { return std::string(fs::io_stats_t::get_name(op)); };
+                auto &counters = folder->get_io_counters();
+                CHECK(counters.at(name(op_t::open)).count == 2);
+                CHECK(counters.at(name(op_t::write)).count == 1);
+                CHECK(counters.at(name(op_t::write)).bytes == 5);
+                CHECK(counters.at(name(op_t::rename)).count == 1);
+                CHECK(counters.at(name(op_t::read)).count == 1);
+                CHECK(counters.at(name(op_t::read)).bytes == 3);
+                CHECK(!counters.contains(name(op_t::sync)));
+
+                // nothing new happened, no report
+                update.reset();
+                trigger();
+                CHECK(!update);
+
+                auto request = fs::payload::block_request_t({}, path, 0, 2);
+                request.folder_id = folder_id;
+                cmds = fs::payload::io_commands_t{nullptr};
+                cmds.commands.emplace_back(std::move(request));
+                sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+                sup->do_process();
+                trigger();
+                REQUIRE(update);
+                CHECK(counters.at(name(op_t::read)).count == 2);
+                CHECK(counters.at(name(op_t::read)).bytes == 5);
+                CHECK(counters.at(name(op_t::write)).count == 1);
+            }
+
+            r::intrusive_ptr_t<update_msg_t> update;
+        };
+        auto f = F();
+        f.stats_interval = r::pt::seconds{1};
+        f.run();
+    }
+}
+
+void test_journal() {
+    auto root_path = unique_path();
+    auto path_guard = test::path_guard_t(root_path);
+    bfs::create_directory(root_path);
+    auto target = root_path / L"файл.bin";
+    auto hash_1 = as_owned_bytes("hash-1");
+    auto hash_2 = as_owned_bytes("hash-2");
+
+    SECTION("records") {
+        auto missing = journal_t::load(target);
+        REQUIRE(!missing);
+        CHECK(missing.assume_error() == sys::errc::no_such_file_or_directory);
+        {
+            auto journal = journal_t(target, 10, 1641828421);
+            CHECK(!journal.flush());
+            CHECK(!bfs::exists(make_journal(target)));
+
+            journal.add(0, hash_1, 5);
+            CHECK(journal.get_pending() == 5);
+            REQUIRE(!journal.flush());
+            CHECK(journal.get_pending() == 0);
+            journal.add(1, hash_1, 5);
+            journal.add(1, hash_2, 5);
+            REQUIRE(!journal.flush());
+        }
+        CHECK(is_journal(make_journal(target)));
+        CHECK(is_temporal(make_journal(target)));
+
+        auto content = journal_t::load(target).value();
+        CHECK(content.file_size == 10);
+        CHECK(content.modification_s == 1641828421);
+        REQUIRE(content.blocks.size() == 2);
+        CHECK(content.blocks.at(0) == hash_1);
+        CHECK(content.blocks.at(1) == hash_2);
+        CHECK(content.size == bfs::file_size(make_journal(target)));
+
+        SECTION("partially written record is ignored") {
+            auto data = read_file(make_journal(target));
+            write_file(make_journal(target), data + std::string("\x02\x00\x00\x00\x06has", 8));
+            auto content = journal_t::load(target).value();
+            CHECK(content.blocks.size() == 2);
+            CHECK(content.size == data.size());
+
+            SECTION("and dropped on appending") {
+                auto journal = journal_t(target, 10, 1641828421);
+                journal.add(2, hash_1, 5);
+                REQUIRE(!journal.flush());
+                auto content = journal_t::load(target).value();
+                CHECK(content.blocks.size() == 3);
+                CHECK(content.blocks.at(2) == hash_1);
+            }
+        }
+        SECTION("another version of the file starts over") {
+            auto journal = journal_t(target, 10, 1641828422);
+            journal.add(1, hash_1, 5);
+            REQUIRE(!journal.flush());
+            auto content = journal_t::load(target).value();
+            CHECK(content.modification_s == 1641828422);
+            REQUIRE(content.blocks.size() == 1);
+            CHECK(content.blocks.at(1) == hash_1);
+        }
+        SECTION("garbage") {
+            write_file(make_journal(target), "garbage-garbage-garbage");
+            auto r = journal_t::load(target);
+            REQUIRE(!r);
+            CHECK(r.assume_error() == utils::make_error_code(utils::error_code_t::invalid_journal));
+        }
+        SECTION("removal") {
+            CHECK(!journal_t::remove(target));
+            CHECK(!bfs::exists(make_journal(target)));
+        }
+    }
+
+    SECTION("fs actor") {
+        struct F : fixture_t {
+            void main() noexcept override {
+                // written during the previous session
+                auto journal = journal_t(target, 10, 1641828421);
+                journal.add(0, hash_1, 5);
+                REQUIRE(!journal.flush());
+
+                auto cmd = fs::payload::append_block_t({}, folder_id, target, as_owned_bytes("67890"), 5, 10);
+                cmd.journal = {1641828421, 1, hash_2};
+                auto cmds = fs::payload::io_commands_t{nullptr};
+                cmds.commands.emplace_back(std::move(cmd));
+                sup->route<fs::payload::io_commands_t>(file_addr, sup->get_address(), std::move(cmds));
+                sup->do_process();
+                REQUIRE(reply);
+                CHECK(std::get<fs::payload::append_block_t>(reply->payload.commands.front()).result);
+
+                // too few bytes to be synced yet
+                CHECK(journal_t::load(target).value().blocks.size() == 1);
+                if (finish) {
+                    finish_file(target, 10, 1641828421, 0666, true).check_success();
+                    CHECK(!bfs::exists(make_journal(target)));
+                }
+            }
+            bfs::path target;
+            utils::bytes_t hash_1;
+            utils::bytes_t hash_2;
+            bool finish = false;
+        };
+        auto f = F();
+        f.target = f.root_path / L"файл.bin";
+        f.hash_1 = hash_1;
+        f.hash_2 = hash_2;
+        SECTION("records are flushed on shutdown") {
+            f.run();
+            auto content = journal_t::load(f.target).value();
+            REQUIRE(content.blocks.size() == 2);
+            CHECK(content.blocks.at(0) == hash_1);
+            CHECK(content.blocks.at(1) == hash_2);
+            CHECK(bfs::file_size(make_temporal(f.target)) == 10);
+        }
+        SECTION("journal is removed on finish") {
+            f.finish = true;
+            f.run();
+            CHECK(!bfs::exists(make_journal(f.target)));
+            CHECK(read_file(f.target).substr(5) == "67890");
+        }
+    }
+}
+
 int _init() {
     test::init_logging();
     REGISTER_TEST_CASE(test_remote_copy, "test_remote_copy", "[fs]");
     REGISTER_TEST_CASE(test_append_block, "test_append_block", "[fs]");
     REGISTER_TEST_CASE(test_clone_block, "test_clone_block", "[fs]");
+    REGISTER_TEST_CASE(test_clone_file, "test_clone_file", "[fs]");
     REGISTER_TEST_CASE(test_update_meta, "test_update_meta", "[fs]");
     REGISTER_TEST_CASE(test_requesting_block, "test_requesting_block", "[fs]");
+    REGISTER_TEST_CASE(test_batched_io, "test_batched_io", "[fs]");
+    REGISTER_TEST_CASE(test_async_io, "test_async_io", "[fs]");
+    REGISTER_TEST_CASE(test_ro_cache, "test_ro_cache", "[fs]");
+    REGISTER_TEST_CASE(test_durable_finish, "test_durable_finish", "[fs]");
+    REGISTER_TEST_CASE(test_io_stats, "test_io_stats", "[fs]");
+    REGISTER_TEST_CASE(test_journal, "test_journal", "[fs]");
     return 1;
 }
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2019-2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2019-2026 Ivan Baidakou
 
 #include "test-utils.h"
 #include "test_supervisor.h"
@@ -7,6 +7,7 @@
 #include "hasher/hasher_plugin.h"
 #include "managed_hasher.h"
 #include "utils/bytes.h"
+#include "utils/mapped_region.h"
 #include <net/names.h>
 
 namespace r = rotor;
@@ -34,6 +35,10 @@ struct hash_consumer_t : r::actor_base_t {
         supervisor->route<payload::digest_t>(hasher, address, std::move(data), 0);
     }
 
+    void request_digest(utils::mapped_region_ptr_t region, utils::bytes_view_t data) {
+        supervisor->route<payload::digest_t>(hasher, address, std::move(region), data, 0);
+    }
+
     void on_digest(message::digest_t &res) noexcept { digest_res = &res; }
 };
 
@@ -53,6 +58,52 @@ TEST_CASE("hasher-actor", "[hasher]") {
     auto &digest = consumer->digest_res->payload.result.value();
     CHECK(digest[2] == 126);
 
+    SECTION("mapped file") {
+        auto root_path = test::unique_path();
+        bfs::create_directories(root_path);
+        auto path_guard = test::path_guard_t(root_path);
+        auto path = root_path / L"файл.bin";
+        test::write_file(path, "0123abcdef");
+
+        auto region = utils::mapped_region_t::map(path, 4, 6);
+#ifndef SYNCSPIRIT_WIN
+        REQUIRE(region);
+        auto view = region->view(4, 6);
+        CHECK(view == test::as_bytes("abcdef"));
+        auto expected = digest;
+        consumer->digest_res.reset();
+        consumer->request_digest(region, view);
+        sup->do_process();
+        REQUIRE(consumer->digest_res);
+        CHECK(consumer->digest_res->payload.get_data().size() == 6);
+        CHECK(consumer->digest_res->payload.result.value() == expected);
+
+        SECTION("truncated file") {
+            bfs::resize_file(path, 0);
+            consumer->digest_res.reset();
+            consumer->request_digest(region, view);
+            sup->do_process();
+            REQUIRE(consumer->digest_res);
+            auto &result = consumer->digest_res->payload.result;
+            REQUIRE(result.has_error());
+            CHECK(result.assume_error() == utils::make_error_code(utils::error_code_t::concurrent_file_modification));
+
+            // the interrupted hashing does not spoil the next ones
+            test::write_file(path, "0123abcdef");
+            region = utils::mapped_region_t::map(path, 4, 6);
+            REQUIRE(region);
+            view = region->view(4, 6);
+            consumer->digest_res.reset();
+            consumer->request_digest(region, view);
+            sup->do_process();
+            REQUIRE(consumer->digest_res);
+            CHECK(consumer->digest_res->payload.result.value() == expected);
+        }
+#else
+        CHECK(!region);
+#endif
+    }
+
     sup->shutdown();
     sup->do_process();
 }
@@ -39,6 +39,7 @@ struct mock_supervisor_t : supervisor_t {
     using io_messages_t = std::list<io_message_ptr>;
     using appended_blocks_t = std::list<fs::payload::append_block_t>;
     using file_finishes_t = std::list<fs::payload::finish_file_t>;
+    using file_clones_t = std::list<fs::payload::clone_file_t>;
 
     using supervisor_t::process_io;
     using supervisor_t::supervisor_t;
@@ -67,6 +68,13 @@ struct mock_supervisor_t : supervisor_t {
         supervisor_t::process_io(req);
     }
 
+    void process_io(fs::payload::clone_file_t &req) noexcept override {
+        auto copy = fs::payload::clone_file_t({}, req.folder_id, req.path, req.conflict_path, req.source,
+                                              req.file_size, req.modification_s, req.permissions, req.no_permissions);
+        file_clones.emplace_back(std::move(copy));
+        supervisor_t::process_io(req);
+    }
+
     void process_io(fs::payload::block_request_t &req) noexcept override {
         supervisor_t::process_io(req);
         if (!block_responces.empty()) {
@@ -96,6 +104,7 @@ struct mock_supervisor_t : supervisor_t {
     block_requests_t block_requests;
     appended_blocks_t appended_blocks;
     file_finishes_t file_finishes;
+    file_clones_t file_clones;
     int bypass_io_messages = -1;
     io_messages_t io_messages;
 };
@@ -1014,6 +1023,157 @@ void test_downloading() {
                 CHECK(f->iterate_blocks().get_total() == 2);
                 CHECK(f->is_locally_available());
             }
+            SECTION("download a file, which is identical to the local one") {
+                peer_actor->forward(cc);
+                sup->do_process();
+
+                auto index = proto::Index{};
+                proto::set_folder(index, folder_1->get_id());
+
+                auto file_name_1 = std::string_view("file-1");
+                auto &file_1 = proto::add_files(index);
+                proto::set_name(file_1, file_name_1);
+                proto::set_type(file_1, proto::FileInfoType::FILE);
+                proto::set_sequence(file_1, 10);
+                proto::set_block_size(file_1, 5);
+                proto::set_size(file_1, 10);
+
+                auto &v_1 = proto::get_version(file_1);
+                proto::add_counters(v_1, proto::Counter(1, 1));
+
+                auto data_1 = as_owned_bytes("12345");
+                auto b1 = proto::BlockInfo();
+                proto::set_hash(b1, utils::sha256_digest(data_1).value());
+                proto::set_size(b1, 5);
+                proto::add_blocks(file_1, b1);
+                auto bi_1 = model::block_info_t::create(b1).value();
+
+                auto data_2 = as_owned_bytes("67890");
+                auto b2 = proto::BlockInfo();
+                proto::set_hash(b2, utils::sha256_digest(data_2).value());
+                proto::set_size(b2, 5);
+                proto::set_offset(b2, 5);
+                proto::add_blocks(file_1, b2);
+                auto bi_2 = model::block_info_t::create(b2).value();
+
+                auto &blocks = cluster->get_blocks();
+                blocks.put(bi_1);
+                blocks.put(bi_2);
+
+                auto pr_file_my = proto::FileInfo();
+                proto::set_name(pr_file_my, "file-1.copy");
+                proto::set_type(pr_file_my, proto::FileInfoType::FILE);
+                proto::set_sequence(pr_file_my, 5);
+                proto::set_block_size(pr_file_my, 5);
+                proto::set_size(pr_file_my, 10);
+                proto::add_blocks(pr_file_my, b1);
+                proto::add_blocks(pr_file_my, b2);
+
+                auto &v_my = proto::get_version(pr_file_my);
+                proto::add_counters(v_my, proto::Counter(my_device->device_id().get_uint(), 1));
+
+                auto uuid = sup->sequencer->next_uuid();
+                auto file_my = model::file_info_t::create(uuid, pr_file_my, folder_my).value();
+                file_my->assign_block(bi_1.get(), 0);
+                file_my->assign_block(bi_2.get(), 1);
+                file_my->mark_local_available(0);
+                file_my->mark_local_available(1);
+                file_my->mark_local(true);
+                REQUIRE(folder_my->add_strict(file_my));
+
+                peer_actor->forward(index);
+                sup->do_process();
+
+                CHECK(peer_actor->blocks_requested == 0);
+                CHECK(sup->file_finishes.size() == 0);
+                REQUIRE(sup->file_clones.size() == 1);
+                auto &clone = sup->file_clones.front();
+                CHECK(clone.file_size == 10);
+                CHECK(clone.source == file_my->get_path(*folder_my));
+
+                REQUIRE(folder_my->get_file_infos().size() == 2);
+                auto f = folder_my->get_file_infos().by_name(file_name_1);
+                REQUIRE(f);
+                CHECK(f->get_size() == 10);
+                CHECK(f->iterate_blocks().get_total() == 2);
+                CHECK(f->is_locally_available());
+            }
+            SECTION("download a file, which has the same blocks in other (non-shared) folder") {
+                peer_actor->forward(cc);
+                sup->do_process();
+
+                auto index = proto::Index{};
+                proto::set_folder(index, folder_1->get_id());
+
+                auto file_name_1 = std::string_view("file-1");
+                auto &file_1 = proto::add_files(index);
+                proto::set_name(file_1, file_name_1);
+                proto::set_type(file_1, proto::FileInfoType::FILE);
+                proto::set_sequence(file_1, 10);
+                proto::set_block_size(file_1, 5);
+                proto::set_size(file_1, 10);
+
+                auto &v_1 = proto::get_version(file_1);
+                proto::add_counters(v_1, proto::Counter(1, 1));
+
+                auto data_1 = as_owned_bytes("12345");
+                auto data_1_hash = utils::sha256_digest(data_1).value();
+
+                auto b1 = proto::BlockInfo();
+                proto::set_hash(b1, data_1_hash);
+                proto::set_size(b1, 5);
+                proto::add_blocks(file_1, b1);
+                auto bi_1 = model::block_info_t::create(b1).value();
+
+                auto data_2 = as_owned_bytes("67890");
+                auto data_2_hash = utils::sha256_digest(data_2).value();
+
+                auto &b2 = proto::add_blocks(file_1);
+                proto::set_hash(b2, data_2_hash);
+                proto::set_size(b2, 5);
+                proto::set_offset(b2, 5);
+                auto bi_2 = model::block_info_t::create(b2).value();
+
+                auto &blocks = cluster->get_blocks();
+                blocks.put(bi_1);
+                blocks.put(bi_2);
+
+                auto folder_2_my = folder_2->get_folder_infos().by_device(*my_device);
+                auto pr_file_my = proto::FileInfo();
+                proto::set_name(pr_file_my, "other-folder-file");
+                proto::set_type(pr_file_my, proto::FileInfoType::FILE);
+                proto::set_sequence(pr_file_my, 5);
+                proto::set_block_size(pr_file_my, 5);
+                proto::set_size(pr_file_my, 5);
+                proto::add_blocks(pr_file_my, b1);
+
+                auto &v_my = proto::get_version(pr_file_my);
+                proto::add_counters(v_my, proto::Counter(my_device->device_id().get_uint(), 1));
+
+                auto uuid = sup->sequencer->next_uuid();
+                auto file_my = model::file_info_t::create(uuid, pr_file_my, folder_2_my).value();
+                file_my->assign_block(bi_1.get(), 0);
+                file_my->mark_local_available(0);
+                REQUIRE(folder_2_my->add_strict(file_my));
+
+                auto source = cluster->find_block_source(*bi_1);
+                REQUIRE(source);
+                CHECK(source.file == file_my.get());
+                CHECK(source.folder_info == folder_2_my.get());
+                CHECK(source.complete);
+                CHECK(!cluster->find_block_source(*bi_2));
+
+                peer_actor->forward(index);
+                peer_actor->push_response(data_2, 0);
+                cluster->modify_write_requests(10);
+                sup->do_process();
+
+                CHECK(peer_actor->blocks_requested == 1);
+                auto f = folder_my->get_file_infos().by_name(file_name_1);
+                REQUIRE(f);
+                CHECK(f->iterate_blocks().get_total() == 2);
+                CHECK(f->is_locally_available());
+            }
         }
     };
     F(true, 10).run();
@@ -8,6 +8,8 @@
 #include "constants.h"
 #include "fs/fs_proxy.h"
 #include "fs/fs_slave.h"
+#include "fs/journal.h"
+#include "fs/scan_pool.h"
 #include "fs/messages.h"
 #include "fs/utils.h"
 #include "fs/updates_mediator.h"
@@ -105,6 +107,7 @@ struct fixture_t {
         auto ctx = execution_context_t();
         ctx.fs_proxy = &fs_proxy;
         ctx.plugin = executor->hasher;
+        ctx.scan_pool = scan_pool;
         return slave.exec(ctx);
     }
 
@@ -205,6 +208,9 @@ struct fixture_t {
                      .timeout(timeout)
                      .sequencer(sequencer)
                      .concurrent_hashes(get_hash_limit())
+                     .prune_dirs(prune_dirs)
+                     .strict_pruning(strict_pruning)
+                     .racy_window(racy_window)
                      .finish();
         sup->do_process();
 
@@ -233,7 +239,11 @@ struct fixture_t {
     model::file_infos_map_t *files_peer;
     model::device_ptr_t peer_device;
     model::sequencer_ptr_t sequencer;
+    fs::scan_pool_t *scan_pool = nullptr;
     bool auto_launch;
+    bool prune_dirs = false;
+    bool strict_pruning = false;
+    std::int64_t racy_window = 0; // i.e. dir ctimes of the just created dirs are trusted
 };
 
 auto my_supervisort_t::operator()(const model::diff::advance::local_update_t &diff, void *custom) noexcept
@@ -547,6 +557,9 @@ void test_no_changes() {
                     CHECK(file_1.get() == file_2.get());
                     CHECK(file_1->is_local());
                     REQUIRE(blocks.size() == 1);
+#ifndef SYNCSPIRIT_WIN
+                    CHECK(file_1->get_local_stat());
+#endif
 
 #ifndef SYNCSPIRIT_WIN
                     SECTION("changes on permissions are ignored") {
@@ -1778,6 +1791,14 @@ void test_incomplete() {
                 CHECK(files->size() == 0);
                 CHECK(!bfs::exists(path));
             }
+            SECTION("orphan journal => remove") {
+                auto journal_path = fs::make_journal(root_path / widen(file_name));
+                write_file(journal_path, "");
+                builder->scan_start(folder->get_id()).apply(*sup);
+
+                CHECK(files->size() == 0);
+                CHECK(!bfs::exists(journal_path));
+            }
             SECTION("exists only in my model => remove") {
                 write_file(path, "");
                 last_write_time(path, fs::from_unix(m_time));
@@ -1933,6 +1954,61 @@ void test_incomplete() {
                     CHECK(!peer_file->iterate_blocks(0).current().first->local_file());
                     CHECK(peer_file->iterate_blocks(1).current().first->local_file());
                 }
+                SECTION("journaled blocks are not rehashed") {
+                    // the journal is trusted, i.e. the 1st block data is not checked
+                    write_file(path, "0000000000");
+                    last_write_time(path, fs::from_unix(m_time));
+                    auto status = bfs::status(path);
+                    auto perms = static_cast<uint32_t>(status.permissions());
+                    {
+                        auto journal = fs::journal_t(model_path, 10, 12345);
+                        journal.add(0, hash_1, 5);
+                        REQUIRE(!journal.flush());
+                    }
+
+                    proto::set_permissions(pr_file, perms);
+                    builder->make_index(sha256, folder->get_id()).add(pr_file, peer_device).finish().apply(*sup);
+
+                    builder->scan_start(folder->get_id()).apply(*sup);
+                    CHECK(bfs::exists(path));
+                    CHECK(bfs::exists(fs::make_journal(model_path)));
+                    CHECK(!bfs::exists(model_path));
+                    CHECK(files->size() == 0);
+
+                    auto peer_file = folder_info_peer->get_file_infos().by_name(file_name);
+                    CHECK(peer_file->iterate_blocks(0).current().first->local_file());
+                    CHECK(!peer_file->iterate_blocks(1).current().first->local_file());
+                }
+                SECTION("invalid journal => rehash") {
+                    write_file(path, "1234500000");
+                    last_write_time(path, fs::from_unix(m_time));
+                    auto status = bfs::status(path);
+                    auto perms = static_cast<uint32_t>(status.permissions());
+                    auto remains = true;
+                    SECTION("another version") {
+                        auto journal = fs::journal_t(model_path, 10, 1);
+                        journal.add(1, hash_2, 5);
+                        REQUIRE(!journal.flush());
+                    }
+                    SECTION("size mismatch") {
+                        auto journal = fs::journal_t(model_path, 20, 12345);
+                        journal.add(1, hash_2, 5);
+                        REQUIRE(!journal.flush());
+                        remains = false;
+                    }
+
+                    proto::set_permissions(pr_file, perms);
+                    builder->make_index(sha256, folder->get_id()).add(pr_file, peer_device).finish().apply(*sup);
+
+                    builder->scan_start(folder->get_id()).apply(*sup);
+                    CHECK(bfs::exists(path));
+                    CHECK(bfs::exists(fs::make_journal(model_path)) == remains);
+                    CHECK(files->size() == 0);
+
+                    auto peer_file = folder_info_peer->get_file_infos().by_name(file_name);
+                    CHECK(peer_file->iterate_blocks(0).current().first->local_file());
+                    CHECK(!peer_file->iterate_blocks(1).current().first->local_file());
+                }
                 SECTION("no block match") {
                     write_file(path, "0000000000");
                     last_write_time(path, fs::from_unix(m_time));
@@ -2002,6 +2078,10 @@ void test_traversal() {
             write_file(root_path / "a/c/file_2.bin", "");
             write_file(root_path / "d/d1/file_3.bin", "");
 
+            auto pool = fs::scan_pool_t(2);
+            SECTION("serial scan") {}
+            SECTION("scan ahead") { scan_pool = &pool; }
+
             builder->scan_start(folder->get_id()).apply(*sup);
             REQUIRE(files->size() == 11);
             REQUIRE(paths.size() == 11);
@@ -2028,6 +2108,246 @@ void test_traversal() {
     F().run();
 }
 
+void test_moves() {
+    struct F : fixture_t {
+        std::uint32_t get_hash_limit() override { return 2; }
+
+        void main() noexcept override {
+            auto &blocks = cluster->get_blocks();
+            auto folder_id = folder->get_id();
+            auto block_sz = fs::block_sizes[0];
+            auto b1 = std::string(block_sz, '0');
+            auto b2 = std::string(block_sz, '1');
+            bfs::create_directories(root_path / "a");
+            write_file(root_path / "a" / "file.bin", b1 + b2);
+            builder->scan_start(folder_id).apply(*sup);
+
+            auto file_1 = files->by_name("a/file.bin");
+            REQUIRE(file_1);
+            auto digested_blocks = hasher->digested_blocks;
+            CHECK(digested_blocks == 2);
+            REQUIRE(blocks.size() == 2);
+
+#ifndef SYNCSPIRIT_WIN
+            REQUIRE(file_1->get_local_stat());
+            auto stat = *file_1->get_local_stat();
+            CHECK(stat.inode);
+
+            auto new_name = std::string();
+            SECTION("renamed within the same dir") {
+                new_name = "a/renamed.bin";
+                bfs::rename(root_path / "a" / "file.bin", root_path / new_name);
+            }
+            SECTION("moved into the dir, scanned after the old one") {
+                new_name = "b/file.bin";
+                bfs::create_directories(root_path / "b");
+                bfs::rename(root_path / "a" / "file.bin", root_path / new_name);
+            }
+            SECTION("moved into the dir, scanned before the old one") {
+                new_name = "0/file.bin";
+                bfs::create_directories(root_path / "0");
+                bfs::rename(root_path / "a" / "file.bin", root_path / new_name);
+            }
+            SECTION("the whole dir is renamed") {
+                new_name = "c/file.bin";
+                bfs::rename(root_path / "a", root_path / "c");
+            }
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(folder->get_scan_finish() >= folder->get_scan_start());
+
+            CHECK(hasher->digested_blocks == digested_blocks);
+            CHECK(file_1->is_deleted());
+            CHECK(!file_1->get_local_stat());
+
+            auto file_2 = files->by_name(new_name);
+            REQUIRE(file_2);
+            CHECK(file_2->is_locally_available());
+            CHECK(file_2->get_size() == block_sz * 2);
+            REQUIRE(file_2->get_local_stat());
+            CHECK(file_2->get_local_stat()->inode == stat.inode);
+            CHECK(blocks.size() == 2);
+#endif
+        }
+    };
+    F().run();
+}
+
+void test_pruning() {
+    struct F : fixture_t {
+        F(bool strict) {
+            prune_dirs = true;
+            strict_pruning = strict;
+        }
+
+        void main() noexcept override {
+#ifndef SYNCSPIRIT_WIN
+            auto folder_id = folder->get_id();
+            bfs::create_directories(root_path / "a" / "b");
+            write_file(root_path / "a" / "file.bin", "12345");
+            write_file(root_path / "a" / "b" / "file_2.bin", "");
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(files->size() == 4);
+
+            auto dir_a = files->by_name("a");
+            auto dir_b = files->by_name("a/b");
+            CHECK(!dir_a->get_local_stat());
+            CHECK(!dir_b->get_local_stat());
+
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(dir_a->get_local_stat());
+            REQUIRE(dir_b->get_local_stat());
+            auto stat_a = *dir_a->get_local_stat();
+            auto stat_b = *dir_b->get_local_stat();
+            CHECK(stat_a.inode);
+
+            // new entry changes dir ctime, so it is listed
+            write_file(root_path / "a" / "b" / "file_3.bin", "");
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(folder->get_scan_finish() >= folder->get_scan_start());
+            CHECK(files->size() == 5);
+            REQUIRE(files->by_name("a/b/file_3.bin"));
+            CHECK(*dir_a->get_local_stat() == stat_a);
+            REQUIRE(dir_b->get_local_stat());
+            CHECK(*dir_b->get_local_stat() != stat_b);
+
+            // content changes do not touch dir ctime
+            write_file(root_path / "a" / "file.bin", "123456");
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(folder->get_scan_finish() >= folder->get_scan_start());
+            CHECK(*dir_a->get_local_stat() == stat_a);
+            auto size = files->by_name("a/file.bin")->get_size();
+            if (strict_pruning) {
+                CHECK(size == 5);
+            } else {
+                CHECK(size == 6);
+            }
+#endif
+        }
+    };
+    SECTION("known entries are examined") { F(false).run(); }
+    SECTION("strict") { F(true).run(); }
+}
+
+void test_racy_pruning() {
+    struct F : fixture_t {
+        F() {
+            prune_dirs = true;
+            racy_window = constants::racy_ctime_window;
+        }
+
+        void main() noexcept override {
+#ifndef SYNCSPIRIT_WIN
+            auto folder_id = folder->get_id();
+            bfs::create_directories(root_path / "a");
+            write_file(root_path / "a" / "file.bin", "12345");
+            builder->scan_start(folder_id).apply(*sup);
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(files->size() == 2);
+
+            // the dir has been changed just now, so its ctime is not trusted
+            auto dir_a = files->by_name("a");
+            CHECK(!dir_a->get_local_stat());
+
+            // ... and the entry, added right after the scan, is not missed
+            write_file(root_path / "a" / "file_2.bin", "");
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(folder->get_scan_finish() >= folder->get_scan_start());
+            CHECK(files->size() == 3);
+            CHECK(files->by_name("a/file_2.bin"));
+            CHECK(!dir_a->get_local_stat());
+#endif
+        }
+    };
+    F().run();
+}
+
+void test_ignores() {
+    struct F : fixture_t {
+        void main() noexcept override {
+            auto folder_id = folder->get_id();
+            bfs::create_directories(root_path / "a");
+            bfs::create_directories(root_path / "b");
+            bfs::create_directories(root_path / "node_modules" / "dep");
+            write_file(root_path / "a" / "x.tmp", "");
+            write_file(root_path / "a" / "keep.tmp", "");
+            write_file(root_path / "b" / "file.bin", "");
+            write_file(root_path / "node_modules" / "dep" / "file.bin", "");
+            write_file(root_path / ".stignore", "!keep.tmp\n*.tmp\nnode_modules\n");
+
+            builder->scan_start(folder_id).apply(*sup);
+            REQUIRE(folder->get_ignores());
+            CHECK(folder->get_ignores()->size() == 3);
+            CHECK(files->size() == 4);
+            CHECK(files->by_name("a/keep.tmp"));
+            CHECK(files->by_name("b/file.bin"));
+            CHECK(!files->by_name("a/x.tmp"));
+            CHECK(!files->by_name("node_modules"));
+            CHECK(!files->by_name(".stignore"));
+
+            SECTION("ignores removal") {
+                bfs::remove(root_path / ".stignore");
+                builder->scan_start(folder_id).apply(*sup);
+                CHECK(!folder->get_ignores());
+                CHECK(files->size() == 8);
+                CHECK(files->by_name("a/x.tmp"));
+                CHECK(files->by_name("node_modules/dep/file.bin"));
+            }
+            SECTION("ignored local files are kept") {
+                write_file(root_path / ".stignore", "b\n");
+                builder->scan_start(folder_id).apply(*sup);
+                REQUIRE(folder->get_ignores());
+                CHECK(files->size() == 8);
+                REQUIRE(files->by_name("b/file.bin"));
+                CHECK(!files->by_name("b/file.bin")->is_deleted());
+                CHECK(files->by_name("a/x.tmp"));
+            }
+            SECTION("invalid patterns suspend the folder") {
+                write_file(root_path / ".stignore", "#include missing\n");
+                builder->scan_start(folder_id).apply(*sup);
+                CHECK(folder->is_suspended());
+                CHECK(files->size() == 4);
+            }
+        }
+    };
+    F().run();
+}
+
+void test_ignores_on_start() {
+    struct F : fixture_t {
+        F() : fixture_t{false} {}
+
+        void main() noexcept override {
+            auto folder_id = folder->get_id();
+            write_file(root_path / "x.tmp", "");
+            write_file(root_path / "file.bin", "");
+
+            SECTION("the patterns are known before the first scan") {
+                write_file(root_path / ".stignore", "*.tmp\n");
+                launch_target();
+                REQUIRE(folder->get_ignores());
+                CHECK(folder->get_ignores()->size() == 1);
+                CHECK(!folder->is_suspended());
+
+                builder->scan_start(folder_id).apply(*sup);
+                CHECK(files->size() == 1);
+                CHECK(files->by_name("file.bin"));
+            }
+            SECTION("invalid patterns suspend the folder") {
+                write_file(root_path / ".stignore", "#include missing\n");
+                launch_target();
+                CHECK(!folder->get_ignores());
+                CHECK(folder->is_suspended());
+            }
+            SECTION("no patterns") {
+                launch_target();
+                CHECK(!folder->get_ignores());
+                CHECK(!folder->is_suspended());
+            }
+        }
+    };
+    F().run();
+}
+
 void test_importing() {
     struct F : fixture_t {
         void main() noexcept override {
@@ -2298,6 +2618,11 @@ int _init() {
     REGISTER_TEST_CASE(test_hashing_fail, "test_hashing_fail", "[net]");
     REGISTER_TEST_CASE(test_incomplete, "test_incomplete", "[net]");
     REGISTER_TEST_CASE(test_traversal, "test_traversal", "[net]");
+    REGISTER_TEST_CASE(test_moves, "test_moves", "[net]");
+    REGISTER_TEST_CASE(test_pruning, "test_pruning", "[net]");
+    REGISTER_TEST_CASE(test_racy_pruning, "test_racy_pruning", "[net]");
+    REGISTER_TEST_CASE(test_ignores, "test_ignores", "[net]");
+    REGISTER_TEST_CASE(test_ignores_on_start, "test_ignores_on_start", "[net]");
     REGISTER_TEST_CASE(test_importing, "test_importing", "[net]");
     REGISTER_TEST_CASE(test_concurrency, "test_concurrency", "[net]");
     REGISTER_TEST_CASE(test_races, "test_races", "[net]");
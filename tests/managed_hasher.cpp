@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
-// SPDX-FileCopyrightText: 2025 Ivan Baidakou
+// SPDX-FileCopyrightText: 2025-2026 Ivan Baidakou
 
 #include "managed_hasher.h"
 #include "utils/tls.h"
@@ -38,7 +38,7 @@ void managed_hasher_t::process_requests() noexcept {
         digest_queue.pop_front();
 
         auto &payload = req->payload;
-        auto &data = payload.data;
+        auto data = payload.get_data();
         unsigned char digest[SZ];
         utils::digest(data.data(), data.size(), digest);
 
@@ -258,6 +258,14 @@ void supervisor_t::process_io(fs::payload::clone_block_t &req) noexcept {
     }
 }
 
+void supervisor_t::process_io(fs::payload::clone_file_t &req) noexcept {
+    LOG_TRACE(log, "process_io (ack: {}), clone_file_t, {} bytes, {} -> {}", auto_ack_io, req.file_size,
+              req.source.string(), req.path.string());
+    if (auto_ack_io) {
+        req.result = outcome::success();
+    }
+}
+
 void supervisor_t::process_io(fs::payload::update_meta_t &req) noexcept {
     LOG_TRACE(log, "process_io (ack: {}), update_meta_t of {}", auto_ack_io, req.path.string());
     if (auto_ack_io) {